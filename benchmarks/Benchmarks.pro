@@ -0,0 +1,67 @@
+QT -= gui
+QT += testlib concurrent
+
+CONFIG += c++17 c++1z console testcase
+CONFIG -= app_bundle
+
+TARGET = benchmarks
+DEFINES += QT_DEPRECATED_WARNINGS
+
+INCLUDEPATH += \
+    $$PWD \
+    $$PWD/../src/cache \
+    $$PWD/../src/diff \
+    $$PWD/../src/history
+
+HEADERS += \
+    $$PWD/CommitInfoBenchmark.h \
+    $$PWD/CommitStoreBenchmark.h \
+    $$PWD/LanesBenchmark.h \
+    $$PWD/ShaFilterBenchmark.h \
+    $$PWD/SyntheticHistory.h \
+    $$PWD/UnifiedDiffBenchmark.h
+
+SOURCES += \
+    $$PWD/CommitInfoBenchmark.cpp \
+    $$PWD/CommitStoreBenchmark.cpp \
+    $$PWD/LanesBenchmark.cpp \
+    $$PWD/ShaFilterBenchmark.cpp \
+    $$PWD/SyntheticHistory.cpp \
+    $$PWD/UnifiedDiffBenchmark.cpp \
+    $$PWD/main.cpp
+
+# The sources that are measured
+HEADERS += \
+    $$PWD/../src/cache/CommitInfo.h \
+    $$PWD/../src/cache/CommitSearchIndex.h \
+    $$PWD/../src/cache/CommitStore.h \
+    $$PWD/../src/cache/GitCache.h \
+    $$PWD/../src/cache/Lane.h \
+    $$PWD/../src/cache/LaneType.h \
+    $$PWD/../src/cache/LanesLayout.h \
+    $$PWD/../src/cache/ObjectId.h \
+    $$PWD/../src/cache/References.h \
+    $$PWD/../src/cache/ReferencesIndex.h \
+    $$PWD/../src/cache/RevisionCache.h \
+    $$PWD/../src/cache/RevisionFiles.h \
+    $$PWD/../src/cache/WipRevisionInfo.h \
+    $$PWD/../src/cache/lanes.h \
+    $$PWD/../src/diff/UnifiedDiff.h \
+    $$PWD/../src/history/ShaFilterProxyModel.h
+
+SOURCES += \
+    $$PWD/../src/cache/CommitInfo.cpp \
+    $$PWD/../src/cache/CommitSearchIndex.cpp \
+    $$PWD/../src/cache/CommitStore.cpp \
+    $$PWD/../src/cache/GitCache.cpp \
+    $$PWD/../src/cache/Lane.cpp \
+    $$PWD/../src/cache/LanesLayout.cpp \
+    $$PWD/../src/cache/References.cpp \
+    $$PWD/../src/cache/ReferencesIndex.cpp \
+    $$PWD/../src/cache/RevisionCache.cpp \
+    $$PWD/../src/cache/RevisionFiles.cpp \
+    $$PWD/../src/cache/lanes.cpp \
+    $$PWD/../src/diff/UnifiedDiff.cpp \
+    $$PWD/../src/history/ShaFilterProxyModel.cpp
+
+include($$PWD/../QLogger/QLogger.pri)
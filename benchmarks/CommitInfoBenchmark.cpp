@@ -0,0 +1,72 @@
+#include "CommitInfoBenchmark.h"
+
+#include <CommitInfo.h>
+#include <SyntheticHistory.h>
+
+#include <QElapsedTimer>
+#include <QTest>
+
+namespace
+{
+const int TOTAL_COMMITS = 1000000;
+
+QVector<CommitInfo> parseLogRecords(const QByteArray &log)
+{
+   // Same split as GitRepoLoader::parseLogRecords
+   QVector<CommitInfo> commits;
+   auto start = 0;
+
+   while (start < log.size())
+   {
+      auto recordEnd = log.indexOf('\000', start);
+
+      if (recordEnd == -1)
+         recordEnd = log.size();
+
+      if (auto commit = CommitInfo { log.constData() + start, recordEnd - start }; commit.isValid())
+         commits.append(std::move(commit));
+
+      start = recordEnd + 1;
+   }
+
+   return commits;
+}
+}
+
+void CommitInfoBenchmark::initTestCase()
+{
+   mLog = SyntheticHistory::gitLog(TOTAL_COMMITS);
+}
+
+void CommitInfoBenchmark::parseLog()
+{
+   QVector<CommitInfo> commits;
+   QElapsedTimer timer;
+
+   timer.start();
+
+   QBENCHMARK_ONCE
+   {
+      commits = parseLogRecords(mLog);
+   }
+
+   const auto elapsed = qMax<qint64>(1, timer.elapsed());
+
+   QCOMPARE(commits.count(), TOTAL_COMMITS);
+   QCOMPARE(commits.constFirst().sha(), QString::fromLatin1(SyntheticHistory::sha(0)));
+
+   qInfo("%lld commits/second", TOTAL_COMMITS * 1000LL / elapsed);
+}
+
+void CommitInfoBenchmark::longLog()
+{
+   // The body is only decoded when a commit is selected
+   const auto commits = parseLogRecords(mLog.left(mLog.indexOf('\000') + 1));
+
+   QCOMPARE(commits.count(), 1);
+
+   QBENCHMARK
+   {
+      QVERIFY(!commits.constFirst().longLog().isEmpty());
+   }
+}
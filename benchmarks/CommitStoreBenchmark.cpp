@@ -0,0 +1,99 @@
+#include "CommitStoreBenchmark.h"
+
+#include <CommitStore.h>
+#include <SyntheticHistory.h>
+
+#include <QHash>
+#include <QTest>
+
+namespace
+{
+const int TOTAL_COMMITS = 100000;
+// Rows painted by the view at once
+const int PAGE_SIZE = 50;
+}
+
+void CommitStoreBenchmark::initTestCase()
+{
+   mCommits = SyntheticHistory::commits(TOTAL_COMMITS);
+}
+
+void CommitStoreBenchmark::append()
+{
+   QBENCHMARK
+   {
+      CommitStore store;
+      store.reserve(mCommits.count());
+
+      for (const auto &commit : qAsConst(mCommits))
+         store.append(commit);
+
+      QCOMPARE(store.count(), TOTAL_COMMITS);
+   }
+}
+
+void CommitStoreBenchmark::scroll()
+{
+   CommitStore store;
+
+   for (const auto &commit : qAsConst(mCommits))
+      store.append(commit);
+
+   QBENCHMARK
+   {
+      auto parents = 0;
+
+      for (auto page = 0; page < store.count(); page += PAGE_SIZE)
+      {
+         for (auto row = page; row < qMin(page + PAGE_SIZE, store.count()); ++row)
+            parents += store.at(row).parentsCount();
+      }
+
+      QVERIFY(parents >= TOTAL_COMMITS - 1);
+   }
+}
+
+void CommitStoreBenchmark::scrollHashedCommits()
+{
+   QHash<ObjectId, CommitInfo> commitsMap;
+   QVector<const CommitInfo *> rows;
+
+   commitsMap.reserve(mCommits.count());
+   rows.reserve(mCommits.count());
+
+   for (const auto &commit : qAsConst(mCommits))
+      commitsMap.insert(commit.id(), commit);
+
+   for (const auto &commit : qAsConst(mCommits))
+      rows.append(&commitsMap[commit.id()]);
+
+   QBENCHMARK
+   {
+      auto parents = 0;
+
+      for (auto page = 0; page < rows.count(); page += PAGE_SIZE)
+      {
+         for (auto row = page; row < qMin(page + PAGE_SIZE, rows.count()); ++row)
+            parents += rows.at(row)->parentsCount();
+      }
+
+      QVERIFY(parents >= TOTAL_COMMITS - 1);
+   }
+}
+
+void CommitStoreBenchmark::appendWithSnapshot()
+{
+   CommitStore store;
+
+   for (const auto &commit : qAsConst(mCommits))
+      store.append(commit);
+
+   // Only the last block is copied when a snapshot shares the store
+   QBENCHMARK
+   {
+      const auto snapshot = store;
+      store.append(mCommits.constFirst());
+
+      QCOMPARE(store.count(), snapshot.count() + 1);
+   }
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+/****************************************************************************************
+ ** GitQlient is an application to manage and operate one or several Git repositories. With
+ ** GitQlient you will be able to add commits, branches and manage all the options Git provides.
+ ** Copyright (C) 2021  Francesc Martinez
+ **
+ ** LinkedIn: www.linkedin.com/in/cescmm/
+ ** Web: www.francescmm.com
+ **
+ ** This program is free software; you can redistribute it and/or
+ ** modify it under the terms of the GNU Lesser General Public
+ ** License as published by the Free Software Foundation; either
+ ** version 2 of the License, or (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ ** Lesser General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Lesser General Public
+ ** License along with this library; if not, write to the Free Software
+ ** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ ***************************************************************************************/
+
+
+#include <CommitInfo.h>
+
+#include <QObject>
+#include <QVector>
+
+/**
+ * @brief The CommitStoreBenchmark class measures the storage of the commits in rows: appending them, reading them in
+ * the order the view scrolls and appending to a store shared with a snapshot. The commits stored in a hash and
+ * reached through a vector of pointers, as the cache did before, are measured as a reference.
+ */
+class CommitStoreBenchmark : public QObject
+{
+   Q_OBJECT
+
+private slots:
+   void initTestCase();
+   void append();
+   void scroll();
+   void scrollHashedCommits();
+   void appendWithSnapshot();
+
+private:
+   QVector<CommitInfo> mCommits;
+};
@@ -0,0 +1,105 @@
+#include "LanesBenchmark.h"
+
+#include <LanesLayout.h>
+#include <SyntheticHistory.h>
+
+#include <QFile>
+#include <QTest>
+
+namespace
+{
+const int TOTAL_COMMITS = 200000;
+// Same interval as the checkpoints of the cache
+const int LANES_CHECKPOINT_INTERVAL = 1000;
+const int TOTAL_LOOKUPS = 100;
+
+QVector<CommitInfo> readParents(const QString &fileName)
+{
+   QFile file(fileName);
+
+   if (!file.open(QIODevice::ReadOnly))
+      return {};
+
+   QVector<CommitInfo> commits;
+
+   while (!file.atEnd())
+   {
+      const auto ids = file.readLine().trimmed().split(' ');
+      const auto sha = ObjectId::fromHex(ids.constFirst().constData(), ids.constFirst().size());
+
+      if (sha.isNull())
+         continue;
+
+      QVector<ObjectId> parents;
+
+      for (auto i = 1; i < ids.count(); ++i)
+         parents.append(ObjectId::fromHex(ids.at(i).constData(), ids.at(i).size()));
+
+      commits.append(CommitInfo(sha, parents, std::chrono::seconds(0), QString()));
+   }
+
+   return commits;
+}
+
+CommitInfo wipCommit(const CommitStore &commits)
+{
+   return CommitInfo(CommitInfo::ZERO_ID, { commits.at(1).id() }, std::chrono::seconds(0), QString());
+}
+}
+
+void LanesBenchmark::initTestCase()
+{
+   auto commits = readParents(qEnvironmentVariable("GITKLIENT_BENCHMARK_PARENTS"));
+
+   if (commits.isEmpty())
+      commits = SyntheticHistory::commits(TOTAL_COMMITS);
+
+   qInfo("Calculating the lanes of %d commits", commits.count());
+
+   mCommits.reserve(commits.count() + 1);
+   mCommits.append(CommitInfo());
+
+   for (auto &commit : commits)
+      mCommits.append(std::move(commit));
+
+   Lanes lanes;
+   lanes.init(CommitInfo::ZERO_ID);
+   LanesLayout::calculateLanes(lanes, wipCommit(mCommits));
+
+   for (auto row = 1; row < mCommits.count(); ++row)
+   {
+      if (row == 1 || row % LANES_CHECKPOINT_INTERVAL == 0)
+         mCheckpoints.insert(row, lanes);
+
+      LanesLayout::calculateLanes(lanes, mCommits.at(row));
+   }
+}
+
+void LanesBenchmark::calculateLanes()
+{
+   QBENCHMARK
+   {
+      Lanes lanes;
+      lanes.init(CommitInfo::ZERO_ID);
+      LanesLayout::calculateLanes(lanes, wipCommit(mCommits));
+
+      for (auto row = 1; row < mCommits.count(); ++row)
+         LanesLayout::calculateLanes(lanes, mCommits.at(row));
+   }
+}
+
+void LanesBenchmark::lanesAt()
+{
+   LanesLayout layout;
+   layout.setSource(mCommits, mCheckpoints);
+
+   // Rows far from each other, so every lookup calculates a new window from its checkpoint
+   QBENCHMARK
+   {
+      for (auto i = 0; i < TOTAL_LOOKUPS; ++i)
+      {
+         const auto row = 1 + static_cast<int>((i * 7919LL) % (mCommits.count() - 1));
+         QVERIFY(!layout.lanesAt(row).isEmpty());
+      }
+   }
+}
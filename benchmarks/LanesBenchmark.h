@@ -0,0 +1,54 @@
+#pragma once
+
+/****************************************************************************************
+ ** GitQlient is an application to manage and operate one or several Git repositories. With
+ ** GitQlient you will be able to add commits, branches and manage all the options Git provides.
+ ** Copyright (C) 2021  Francesc Martinez
+ **
+ ** LinkedIn: www.linkedin.com/in/cescmm/
+ ** Web: www.francescmm.com
+ **
+ ** This program is free software; you can redistribute it and/or
+ ** modify it under the terms of the GNU Lesser General Public
+ ** License as published by the Free Software Foundation; either
+ ** version 2 of the License, or (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ ** Lesser General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Lesser General Public
+ ** License along with this library; if not, write to the Free Software
+ ** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ ***************************************************************************************/
+
+
+#include <CommitStore.h>
+#include <lanes.h>
+
+#include <QMap>
+#include <QObject>
+
+/**
+ * @brief The LanesBenchmark class measures the calculation of the lanes of the graph and the lookup of the lanes of
+ * the rows that the view paints.
+ *
+ * The history is read from the file in the GITKLIENT_BENCHMARK_PARENTS environment variable, with the output of
+ * "git log --format='%H %P'" of a branchy repository (the history of the Linux kernel is the reference). Without it, a
+ * synthetic history is used.
+ */
+class LanesBenchmark : public QObject
+{
+   Q_OBJECT
+
+private slots:
+   void initTestCase();
+   void calculateLanes();
+   void lanesAt();
+
+private:
+   // Row 0 belongs to the WIP, like in the cache
+   CommitStore mCommits;
+   QMap<int, Lanes> mCheckpoints;
+};
@@ -0,0 +1,77 @@
+#include "ShaFilterBenchmark.h"
+
+#include <GitCache.h>
+#include <ShaFilterProxyModel.h>
+#include <SyntheticHistory.h>
+
+#include <QAbstractListModel>
+#include <QTest>
+
+namespace
+{
+const int TOTAL_COMMITS = 1000000;
+// One of every ACCEPTED_INTERVAL commits changes the file
+const int ACCEPTED_INTERVAL = 100;
+
+/**
+ * @brief The SyntheticCache class is a cache filled with a synthetic history instead of the log of a repository.
+ */
+class SyntheticCache : public GitCache
+{
+public:
+   explicit SyntheticCache(int totalCommits)
+   {
+      setup(QString::fromLatin1(SyntheticHistory::sha(0)), RevisionFiles(), SyntheticHistory::commits(totalCommits));
+   }
+};
+
+/**
+ * @brief The CommitsModel class has a row for every commit of the cache, the WIP included, like the history model.
+ */
+class CommitsModel : public QAbstractListModel
+{
+public:
+   explicit CommitsModel(const QSharedPointer<GitCache> &cache)
+      : mCache(cache)
+   {
+   }
+
+   int rowCount(const QModelIndex &parent = QModelIndex()) const override
+   {
+      return parent.isValid() ? 0 : mCache->commitCount();
+   }
+
+   QVariant data(const QModelIndex &, int) const override { return QVariant(); }
+
+private:
+   QSharedPointer<GitCache> mCache;
+};
+}
+
+void ShaFilterBenchmark::initTestCase()
+{
+   mCache = QSharedPointer<SyntheticCache>::create(TOTAL_COMMITS);
+
+   for (auto i = 0; i < TOTAL_COMMITS; i += ACCEPTED_INTERVAL)
+      mAcceptedShas.append(QString::fromLatin1(SyntheticHistory::sha(i)));
+}
+
+void ShaFilterBenchmark::invalidate()
+{
+   CommitsModel model(mCache);
+   ShaFilterProxyModel proxy(mCache);
+   proxy.setSourceModel(&model);
+
+   QBENCHMARK
+   {
+      proxy.setAcceptedSha(mAcceptedShas);
+      proxy.invalidate();
+
+      QCOMPARE(proxy.rowCount(), mAcceptedShas.count());
+   }
+}
+
+void ShaFilterBenchmark::cleanupTestCase()
+{
+   mCache.reset();
+}
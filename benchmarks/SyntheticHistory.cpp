@@ -0,0 +1,74 @@
+#include "SyntheticHistory.h"
+
+#include <QCryptographicHash>
+
+namespace
+{
+const int MERGE_INTERVAL = 4;
+const int MAX_BRANCH_LENGTH = 200;
+}
+
+namespace SyntheticHistory
+{
+QByteArray sha(int commit)
+{
+   return QCryptographicHash::hash(QByteArray::number(commit), QCryptographicHash::Sha1).toHex();
+}
+
+QByteArray gitLog(int totalCommits)
+{
+   QByteArray log;
+   log.reserve(totalCommits * 320);
+
+   for (auto i = 0; i < totalCommits; ++i)
+   {
+      QByteArray record;
+      record.append('>').append(sha(i)).append('X');
+
+      if (i + 1 < totalCommits)
+         record.append(sha(i + 1));
+
+      record.append("\nJane Committer<jane@example.com>\nJohn Author<john@example.com>\n");
+      record.append(QByteArray::number(1600000000 - i)).append('\n');
+      record.append("Fix the widget number ").append(QByteArray::number(i)).append('\n');
+      record.append("The widget didn't update its size when the font changed.\n\nIt's updated now in the show event.");
+
+      // Same separators as git log -z --log-size
+      log.append("log size ").append(QByteArray::number(record.size())).append('\n');
+      log.append(record).append('\0');
+   }
+
+   return log;
+}
+
+QVector<CommitInfo> commits(int totalCommits)
+{
+   QVector<ObjectId> ids;
+   ids.reserve(totalCommits);
+
+   for (auto i = 0; i < totalCommits; ++i)
+      ids.append(ObjectId::fromHex(sha(i).constData(), ObjectId::HEX_SIZE));
+
+   QVector<CommitInfo> commits;
+   commits.reserve(totalCommits);
+
+   for (auto i = 0; i < totalCommits; ++i)
+   {
+      QVector<ObjectId> parents;
+
+      if (i + 1 < totalCommits)
+         parents.append(ids.at(i + 1));
+
+      if (i % MERGE_INTERVAL == 0 && i + 2 < totalCommits)
+      {
+         const auto branchLength = 2 + (i / MERGE_INTERVAL) % MAX_BRANCH_LENGTH;
+         parents.append(ids.at(qMin(i + branchLength, totalCommits - 1)));
+      }
+
+      commits.append(CommitInfo(ids.at(i), parents, std::chrono::seconds(1600000000 - i),
+                                QString("Fix the widget number %1").arg(i)));
+   }
+
+   return commits;
+}
+}
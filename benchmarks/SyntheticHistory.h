@@ -0,0 +1,54 @@
+#pragma once
+
+/****************************************************************************************
+ ** GitQlient is an application to manage and operate one or several Git repositories. With
+ ** GitQlient you will be able to add commits, branches and manage all the options Git provides.
+ ** Copyright (C) 2021  Francesc Martinez
+ **
+ ** LinkedIn: www.linkedin.com/in/cescmm/
+ ** Web: www.francescmm.com
+ **
+ ** This program is free software; you can redistribute it and/or
+ ** modify it under the terms of the GNU Lesser General Public
+ ** License as published by the Free Software Foundation; either
+ ** version 2 of the License, or (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ ** Lesser General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Lesser General Public
+ ** License along with this library; if not, write to the Free Software
+ ** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ ***************************************************************************************/
+
+
+#include <CommitInfo.h>
+
+#include <QByteArray>
+#include <QVector>
+
+/**
+ * @brief The SyntheticHistory namespace generates the repositories measured by the benchmarks, so they don't depend on
+ * a repository on disk. The same number of commits always generates the same history.
+ */
+namespace SyntheticHistory
+{
+/**
+ * @brief sha Returns the hexadecimal SHA-1 of @p commit.
+ */
+QByteArray sha(int commit);
+
+/**
+ * @brief gitLog Returns the output of git log for @p totalCommits, with the same format and the same separators that
+ * GitRepoLoader requests. Each commit has a subject and a body of a few lines.
+ */
+QByteArray gitLog(int totalCommits);
+
+/**
+ * @brief commits Returns @p totalCommits commits in the order of the rows of the graph. Every few commits there's a
+ * merge of a branch that started some rows below, so a few dozens of lanes are open at the same time.
+ */
+QVector<CommitInfo> commits(int totalCommits);
+}
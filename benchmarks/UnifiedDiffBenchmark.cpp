@@ -0,0 +1,77 @@
+#include "UnifiedDiffBenchmark.h"
+
+#include <UnifiedDiff.h>
+
+#include <QElapsedTimer>
+#include <QTest>
+
+namespace
+{
+const int DIFF_SIZE = 200 * 1024 * 1024;
+const int HUNKS_PER_FILE = 50;
+const int CONTEXT_LINES = 3;
+const int CHANGED_LINES = 20;
+}
+
+void UnifiedDiffBenchmark::initTestCase()
+{
+   mDiff.reserve(DIFF_SIZE + 64 * 1024);
+
+   while (mDiff.size() < DIFF_SIZE)
+   {
+      const auto name = QByteArray("generated/Table").append(QByteArray::number(mTotalFiles++)).append(".cpp");
+
+      mDiff.append("diff --git a/").append(name).append(" b/").append(name).append('\n');
+      mDiff.append("index 83db48f..bf269f4 100644\n");
+      mDiff.append("--- a/").append(name).append('\n');
+      mDiff.append("+++ b/").append(name).append('\n');
+
+      for (auto hunk = 0; hunk < HUNKS_PER_FILE; ++hunk, ++mTotalHunks)
+      {
+         const auto start = QByteArray::number(1 + hunk * 100);
+         const auto count = QByteArray::number(2 * CONTEXT_LINES + CHANGED_LINES);
+
+         mDiff.append("@@ -").append(start).append(',').append(count).append(" +").append(start).append(',');
+         mDiff.append(count).append(" @@ const Entry TABLE[] = {\n");
+
+         for (auto line = 0; line < CONTEXT_LINES; ++line)
+            mDiff.append("    { 0x0000, \"context\", Kind::Unchanged, nullptr },\n");
+
+         for (auto line = 0; line < CHANGED_LINES; ++line)
+            mDiff.append("-   { 0x1a2b, \"removed\", Kind::Generated, &handlerOf<0x1a2b> },\n");
+
+         for (auto line = 0; line < CHANGED_LINES; ++line)
+            mDiff.append("+   { 0x3c4d, \"added\", Kind::Generated, &handlerOf<0x3c4d> },\n");
+
+         for (auto line = 0; line < CONTEXT_LINES; ++line)
+            mDiff.append("    { 0xffff, \"context\", Kind::Unchanged, nullptr },\n");
+      }
+   }
+}
+
+void UnifiedDiffBenchmark::parse()
+{
+   UnifiedDiff diff;
+   QElapsedTimer timer;
+
+   timer.start();
+
+   QBENCHMARK_ONCE
+   {
+      diff = UnifiedDiff::parse(mDiff);
+   }
+
+   const auto elapsed = qMax<qint64>(1, timer.elapsed());
+
+   QCOMPARE(diff.files().count(), mTotalFiles);
+   QCOMPARE(diff.hunks().count(), mTotalHunks);
+   QCOMPARE(diff.lines().count(), mTotalHunks * (2 * CONTEXT_LINES + 2 * CHANGED_LINES));
+
+   qInfo("%lld MB/second", mDiff.size() * 1000LL / elapsed / (1024 * 1024));
+}
+
+void UnifiedDiffBenchmark::cleanupTestCase()
+{
+   mDiff.clear();
+   mDiff.squeeze();
+}
@@ -0,0 +1,32 @@
+#include <CommitInfoBenchmark.h>
+#include <CommitStoreBenchmark.h>
+#include <LanesBenchmark.h>
+#include <ShaFilterBenchmark.h>
+#include <UnifiedDiffBenchmark.h>
+
+#include <QCoreApplication>
+#include <QTest>
+
+int main(int argc, char *argv[])
+{
+   QCoreApplication app(argc, argv);
+
+   auto status = 0;
+
+   CommitInfoBenchmark commitInfo;
+   status |= QTest::qExec(&commitInfo, argc, argv);
+
+   CommitStoreBenchmark commitStore;
+   status |= QTest::qExec(&commitStore, argc, argv);
+
+   LanesBenchmark lanes;
+   status |= QTest::qExec(&lanes, argc, argv);
+
+   ShaFilterBenchmark shaFilter;
+   status |= QTest::qExec(&shaFilter, argc, argv);
+
+   UnifiedDiffBenchmark unifiedDiff;
+   status |= QTest::qExec(&unifiedDiff, argc, argv);
+
+   return status;
+}
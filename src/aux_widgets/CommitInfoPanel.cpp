@@ -64,8 +64,8 @@ CommitInfoPanel::CommitInfoPanel(QWidget *parent)
 
 void CommitInfoPanel::configure(const CommitInfo &commit)
 {
-   mLabelSha->setText(commit.sha.left(8));
-   mLabelSha->setData(commit.sha);
+   mLabelSha->setText(commit.sha().left(8));
+   mLabelSha->setData(commit.sha());
    mLabelSha->setToolTip("Click to save");
 
    const auto authorName = commit.committer.split("<").first();
@@ -75,7 +75,7 @@ void CommitInfoPanel::configure(const CommitInfo &commit)
    QDateTime commitDate = QDateTime::fromSecsSinceEpoch(commit.dateSinceEpoch.count());
    mLabelDateTime->setText(commitDate.toString("dd/MM/yyyy hh:mm"));
 
-   const auto description = commit.longLog;
+   const auto description = commit.longLog();
    mLabelDescription->setText(description.isEmpty() ? "<No description provided>" : description);
 
    QFontMetrics fm(mLabelDescription->font());
@@ -94,7 +94,7 @@ void SquashDlg::accept()
 
             // Create auxiliary branch for rebase
             const auto auxBranch1 = QUuid::createUuid().toString();
-            const auto commitOfAuxBranch1 = lastChild.getFirstChildSha();
+            const auto commitOfAuxBranch1 = mCache->commitInfo(lastChild.getFirstChildRow()).sha();
             gitBranches.createBranchAtCommit(commitOfAuxBranch1, auxBranch1);
 
             // Create auxiliary branch for merge squash
@@ -110,6 +110,7 @@ ConfigDialog::ConfigDialog(const QSharedPointer<GitBase> &git, QWidget *parent)
    ui->cbSubmodule->setChecked(settings.localValue("SubmodulesHeader", true).toBool());
    ui->cbSubtree->setChecked(settings.localValue("SubtreeHeader", true).toBool());
    ui->cbDeleteFolder->setChecked(settings.localValue("DeleteRemoteFolder", false).toBool());
+   ui->cbRemoteTags->setChecked(settings.localValue("FetchRemoteTags", true).toBool());
 
    // Build System configuration
    const auto isConfigured = settings.localValue("BuildSystemEnabled", false).toBool();
@@ -283,6 +284,7 @@ void ConfigDialog::saveConfig()
    settings.setLocalValue("SubtreeHeader", ui->cbSubtree->isChecked());
 
    settings.setLocalValue("DeleteRemoteFolder", ui->cbDeleteFolder->isChecked());
+   settings.setLocalValue("FetchRemoteTags", ui->cbRemoteTags->isChecked());
 
    emit panelsVisibilityChanged();
 
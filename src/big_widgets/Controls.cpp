@@ -244,13 +244,7 @@ void Controls::pullCurrentBranch()
 
 void Controls::fetchAll()
 {
-   QApplication::setOverrideCursor(QCursor(Qt::WaitCursor));
-   GitRemote gitRemote(mGit);
-   const auto ret = gitRemote.fetch();
-   QApplication::restoreOverrideCursor();
-
-   if (ret)
-      emit requestFullReload();
+   emit requestFetch();
 }
 
 void Controls::activateMergeWarning()
@@ -106,6 +106,12 @@ signals:
     */
    void requestFullReload();
 
+   /**
+    * @brief requestFetch Signal triggered when the user asks to fetch all the remotes. The fetch runs in the job
+    * scheduler of the repository, ahead of the refreshes.
+    */
+   void requestFetch();
+
    /**
     * @brief requestReload Signal triggered when the user forces a refresh of the references of the repository.
     */
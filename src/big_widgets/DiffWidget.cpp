@@ -151,13 +151,23 @@ bool DiffWidget::loadCommitDiff(const QString &sha, const QString &parentSha)
 
    if (!mDiffWidgets.contains(id))
    {
-      GitHistory gitHistory(mGit);
-      const auto ret = gitHistory.getCommitDiff(sha, parentSha);
+      auto diff = mCache->diff(sha, parentSha);
 
-      if (ret.success && !ret.output.isEmpty())
+      if (!diff)
+      {
+         GitHistory gitHistory(mGit);
+
+         if (const auto ret = gitHistory.getCommitDiff(sha, parentSha); ret && !ret->isEmpty())
+         {
+            diff = ret;
+            mCache->insertDiff(sha, parentSha, *ret);
+         }
+      }
+
+      if (diff)
       {
          const auto fullDiffWidget = new FullDiffWidget(mGit, mCache);
-         fullDiffWidget->loadDiff(sha, parentSha, ret.output);
+         fullDiffWidget->loadDiff(sha, parentSha, *diff);
 
          mInfoPanelBase->configure(mCache->commitInfo(sha));
          mInfoPanelParent->configure(mCache->commitInfo(parentSha));
@@ -14,15 +14,19 @@
 #include <GitConfigDlg.h>
 #include <GitHistory.h>
 #include <GitHubRestApi.h>
+#include <GitJobScheduler.h>
 #include <GitLocal.h>
 #include <GitMerge.h>
 #include <GitQlientSettings.h>
+#include <GitRemote.h>
 #include <GitRepoLoader.h>
+#include <GitRepoWatcher.h>
 #include <GitServerCache.h>
 #include <GitServerWidget.h>
 #include <GitSubmodules.h>
 #include <GitTags.h>
 #include <GitWip.h>
+#include <GitWipUpdater.h>
 #include <HistoryWidget.h>
 #include <JenkinsWidget.h>
 #include <MergeWidget.h>
@@ -59,7 +63,8 @@ GitQlientRepo::GitQlientRepo(const QSharedPointer<GitBase> &git, const QSharedPo
    , mGitServerWidget(new GitServerWidget(mGitQlientCache, mGitBase, mGitServerCache))
    , mJenkins(new JenkinsWidget(mSettings))
    , mAutoFetch(new QTimer())
-   , mAutoFilesUpdate(new QTimer())
+   , mJobScheduler(new GitJobScheduler(mGitBase->getWorkingDir(), 3, this))
+   , mWipUpdater(new GitWipUpdater(mJobScheduler, mGitQlientCache, this))
 {
    setAttribute(Qt::WA_DeleteOnClose);
 
@@ -102,12 +107,12 @@ GitQlientRepo::GitQlientRepo(const QSharedPointer<GitBase> &git, const QSharedPo
    const auto fetchInterval = mSettings->localValue("AutoFetch", 5).toInt();
 
    mAutoFetch->setInterval(fetchInterval * 60 * 1000);
-   mAutoFilesUpdate->setInterval(15000);
 
-   connect(mAutoFetch, &QTimer::timeout, mControls, &Controls::fetchAll);
-   connect(mAutoFilesUpdate, &QTimer::timeout, this, &GitQlientRepo::updateUiFromWatcher);
+   connect(mAutoFetch, &QTimer::timeout, this, [this]() { fetch(GitJobPriority::Background); });
+   connect(mWipUpdater, &GitWipUpdater::wipChanged, this, &GitQlientRepo::onWipChanged);
 
    connect(mControls, &Controls::requestFullReload, this, &GitQlientRepo::fullReload);
+   connect(mControls, &Controls::requestFetch, this, [this]() { fetch(GitJobPriority::Interactive); });
    connect(mControls, &Controls::requestReferencesReload, this, &GitQlientRepo::referencesReload);
 
    connect(mControls, &Controls::signalGoRepo, this, &GitQlientRepo::showHistoryView);
@@ -159,6 +164,8 @@ GitQlientRepo::GitQlientRepo(const QSharedPointer<GitBase> &git, const QSharedPo
 
    connect(mGitLoader.data(), &GitRepoLoader::signalLoadingStarted, this, &GitQlientRepo::createProgressDialog);
    connect(mGitLoader.data(), &GitRepoLoader::signalLoadingFinished, this, &GitQlientRepo::onRepoLoadFinished);
+   connect(mGitLoader.data(), &GitRepoLoader::signalCommitsBatchReady, this, &GitQlientRepo::onCommitsBatchReady);
+   connect(mGitLoader.data(), &GitRepoLoader::signalCommitsPrepended, this, &GitQlientRepo::onCommitsPrepended);
 
    m_loaderThread = new QThread();
    mGitLoader->moveToThread(m_loaderThread);
@@ -174,7 +181,6 @@ GitQlientRepo::GitQlientRepo(const QSharedPointer<GitBase> &git, const QSharedPo
 GitQlientRepo::~GitQlientRepo()
 {
    delete mAutoFetch;
-   delete mAutoFilesUpdate;
 
    m_loaderThread->exit();
    m_loaderThread->wait();
@@ -186,18 +192,58 @@ QString GitQlientRepo::currentBranch() const
    return mGitBase->getCurrentBranch();
 }
 
-void GitQlientRepo::updateUiFromWatcher()
+void GitQlientRepo::updateUiFromWatcher(const QStringList &modifiedFiles)
 {
    QLog_Info("UI", QString("Updating the GitQlient UI from watcher"));
 
-   GitWip git(mGitBase, mGitQlientCache);
-   git.updateWip();
+   // The views are only reloaded if any file changed, the modified files were changed again by definition
+   mWipUpdater->update(modifiedFiles);
+}
+
+void GitQlientRepo::onWipChanged()
+{
+   // The files that are already modified are watched so they are noticed when they're modified again
+   if (mRepoWatcher)
+      mRepoWatcher->setModifiedFiles(mWipUpdater->files());
 
    mHistoryWidget->updateUiFromWatcher();
 
    mDiffWidget->reload();
 }
 
+void GitQlientRepo::fetch(GitJobPriority priority)
+{
+   // The automatic fetch waits for the rest of Git commands of the repository, the one of the user goes first. If the
+   // automatic one is still waiting, the scheduler moves it to the lane of the user.
+   const auto job = mJobScheduler->schedule(priority, GitRemote(mGitBase).fetchArguments());
+
+   connect(job, &GitJob::finished, this, [this](bool success) {
+      mGitBase->invalidateRemoteTags();
+
+      if (success)
+         emit fullReload();
+   });
+}
+
+void GitQlientRepo::startRepoWatcher()
+{
+   mRepoWatcher = new GitRepoWatcher(mGitBase->getWorkingDir(), mGitBase->getGitDir(), this);
+   mRepoWatcher->setActive(isVisible());
+
+   connect(mRepoWatcher, &GitRepoWatcher::repositoryChanged, this,
+           [this](GitRepoWatcher::Changes changes, const QStringList &modifiedFiles) {
+              // The full reload also updates the WIP
+              if (changes.testFlag(GitRepoWatcher::References))
+                 emit fullReload();
+              else
+                 updateUiFromWatcher(modifiedFiles);
+           });
+
+   mRepoWatcher->start();
+
+   updateUiFromWatcher();
+}
+
 void GitQlientRepo::setRepository(const QString &newDir)
 {
    if (!newDir.isEmpty())
@@ -274,7 +320,7 @@ void GitQlientRepo::onRepoLoadFinished(bool fullReload)
 
       mControls->enableButtons(true);
 
-      mAutoFilesUpdate->start();
+      startRepoWatcher();
 
       GitConfig git(mGitBase);
 
@@ -295,7 +341,13 @@ void GitQlientRepo::onRepoLoadFinished(bool fullReload)
    const auto totalCommits = mGitQlientCache->commitCount();
 
    mHistoryWidget->loadBranches(fullReload);
-   mHistoryWidget->updateGraphView(totalCommits);
+
+   if (mHistoryStreamed)
+      mHistoryWidget->appendGraphRows(totalCommits);
+   else
+      mHistoryWidget->updateGraphView(totalCommits);
+
+   mHistoryStreamed = false;
 
    mBlameWidget->onNewRevisions(totalCommits);
 
@@ -325,6 +377,29 @@ void GitQlientRepo::onRepoLoadFinished(bool fullReload)
    emit currentBranchChanged();
 }
 
+void GitQlientRepo::onCommitsBatchReady(int totalCommits, bool firstBatch)
+{
+   if (firstBatch)
+   {
+      if (mWaitDlg)
+         mWaitDlg->close();
+
+      mHistoryWidget->updateGraphView(totalCommits);
+   }
+   else
+      mHistoryWidget->appendGraphRows(totalCommits);
+
+   mHistoryStreamed = true;
+}
+
+void GitQlientRepo::onCommitsPrepended(int newCommits, int lastUpdatedRow)
+{
+   mHistoryWidget->insertGraphRows(newCommits, lastUpdatedRow);
+
+   // The model is already up to date, it must not be reset when the load finishes
+   mHistoryStreamed = true;
+}
+
 void GitQlientRepo::loadFileDiff(const QString &currentSha, const QString &previousSha, const QString &file,
                                  bool isStaged)
 {
@@ -498,24 +573,15 @@ void GitQlientRepo::updateWip()
 
 void GitQlientRepo::focusHistoryOnBranch(const QString &branch)
 {
-   auto found = false;
    const auto fullBranch = QString("origin/%1").arg(branch);
-   auto remoteBranches = mGitQlientCache->getBranches(References::Type::RemoteBranches);
 
-   for (const auto &remote : remoteBranches)
+   if (const auto sha = mGitQlientCache->getShaOfReference(fullBranch, References::Type::RemoteBranches);
+       !sha.isEmpty())
    {
-      if (remote.second.contains(fullBranch))
-      {
-         found = true;
-         mHistoryWidget->focusOnCommit(remote.first);
-         showHistoryView();
-      }
+      mHistoryWidget->focusOnCommit(sha);
+      showHistoryView();
    }
-
-   remoteBranches.clear();
-   remoteBranches.squeeze();
-
-   if (!found)
+   else
       QMessageBox::information(
           this, tr("Branch not found"),
           tr("The branch couldn't be found. Please, make sure you fetched and have the latest changes."));
@@ -569,3 +635,23 @@ void GitQlientRepo::closeEvent(QCloseEvent *ce)
 
    QWidget::closeEvent(ce);
 }
+
+void GitQlientRepo::showEvent(QShowEvent *e)
+{
+   if (mRepoWatcher)
+      mRepoWatcher->setActive(true);
+
+   QFrame::showEvent(e);
+}
+
+void GitQlientRepo::hideEvent(QHideEvent *e)
+{
+   // The repositories in the tabs that are not shown don't refresh anything until they're shown again
+   if (mRepoWatcher)
+      mRepoWatcher->setActive(false);
+
+   // Nor do they need the files and the diffs of the commits they showed, so most of them are released
+   mGitQlientCache->releaseMemory();
+
+   QFrame::hideEvent(e);
+}
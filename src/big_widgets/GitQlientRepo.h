@@ -30,8 +30,14 @@
 class GitBase;
 class GitQlientSettings;
 class GitCache;
+class GitJobScheduler;
+enum class GitJobPriority;
 class GitRepoLoader;
+class GitRepoWatcher;
+class GitWipUpdater;
 class QCloseEvent;
+class QHideEvent;
+class QShowEvent;
 class QStackedLayout;
 class Controls;
 class HistoryWidget;
@@ -143,6 +149,14 @@ protected:
     \param ce The close event.
    */
    void closeEvent(QCloseEvent *ce) override;
+   /**
+    * @brief showEvent Activates the watcher of the repository.
+    */
+   void showEvent(QShowEvent *e) override;
+   /**
+    * @brief hideEvent Deactivates the watcher of the repository while it's not shown.
+    */
+   void hideEvent(QHideEvent *e) override;
 
 private:
    QString mCurrentDir;
@@ -160,20 +174,38 @@ private:
    GitServerWidget *mGitServerWidget = nullptr;
    Jenkins::JenkinsWidget *mJenkins = nullptr;
    QTimer *mAutoFetch = nullptr;
-   QTimer *mAutoFilesUpdate = nullptr;
+   GitJobScheduler *mJobScheduler = nullptr;
+   GitWipUpdater *mWipUpdater = nullptr;
+   GitRepoWatcher *mRepoWatcher = nullptr;
    QTimer *mAutoPrUpdater = nullptr;
    QPointer<WaitingDlg> mWaitDlg;
    QPair<ControlsMainViews, QWidget *> mPreviousView;
    QSharedPointer<GitServer::IRestApi> mApi;
 
    bool mIsInit = false;
+   bool mHistoryStreamed = false;
    QThread *m_loaderThread;
 
    /*!
-    \brief Performs a light UI update triggered by the QFileSystemWatcher.
+    \brief Performs a light UI update triggered by the watcher of the repository when the WIP may have changed.
 
+    \param modifiedFiles The files that were already modified and were modified again.
    */
-   void updateUiFromWatcher();
+   void updateUiFromWatcher(const QStringList &modifiedFiles = QStringList());
+   /**
+    * @brief onWipChanged Reloads the views that show the WIP once the files of the working directory have changed.
+    */
+   void onWipChanged();
+   /**
+    * @brief startRepoWatcher Starts watching the repository once it's loaded so the changes made outside GitQlient are
+    * shown.
+    */
+   void startRepoWatcher();
+   /**
+    * @brief fetch Fetches all the remotes without blocking the UI and reloads the repository if it succeeds.
+    * @param priority Interactive when the user asked for it, Background for the automatic fetch.
+    */
+   void fetch(GitJobPriority priority);
    /*!
     \brief Opens the diff view with the selected commit from the repository view.
     \param currentSha The current selected commit SHA.
@@ -219,6 +251,20 @@ private:
     * @param fullReload Indicates that the load finished in the full mode (commits + references).
     */
    void onRepoLoadFinished(bool fullReload);
+
+   /**
+    * @brief onCommitsBatchReady Shows in the history view the commits loaded so far while the log is still streaming.
+    * @param totalCommits The total of commits in the cache.
+    * @param firstBatch Indicates that it's the first batch of a new load.
+    */
+   void onCommitsBatchReady(int totalCommits, bool firstBatch);
+
+   /**
+    * @brief onCommitsPrepended Shows in the history view the commits added on top of the history already shown.
+    * @param newCommits The number of commits added.
+    * @param lastUpdatedRow The last row whose graph changed.
+    */
+   void onCommitsPrepended(int newCommits, int lastUpdatedRow);
    /*!
     \brief Loads the view to show the diff of a specific file.
 
@@ -2,10 +2,12 @@
 
 #include <AmendWidget.h>
 #include <BranchesWidget.h>
+#include <CommitHistoryColumns.h>
 #include <CommitHistoryModel.h>
 #include <CommitHistoryView.h>
 #include <CommitInfo.h>
 #include <CommitInfoWidget.h>
+#include <CommitScanner.h>
 #include <FileDiffWidget.h>
 #include <FileEditor.h>
 #include <FullDiffWidget.h>
@@ -13,6 +15,7 @@
 #include <GitBranches.h>
 #include <GitCache.h>
 #include <GitConfig.h>
+#include <GitContentSearch.h>
 #include <GitHistory.h>
 #include <GitLocal.h>
 #include <GitMerge.h>
@@ -28,11 +31,13 @@
 
 #include <QApplication>
 #include <QCheckBox>
+#include <QComboBox>
 #include <QGridLayout>
 #include <QLabel>
 #include <QLineEdit>
 #include <QMenu>
 #include <QMessageBox>
+#include <QProgressBar>
 #include <QPushButton>
 #include <QScreen>
 #include <QSplitter>
@@ -123,6 +128,40 @@ HistoryWidget::HistoryWidget(const QSharedPointer<GitCache> &cache, const QShare
    mSearchInput->setPlaceholderText(tr("Press Enter to search by SHA or log message..."));
    connect(mSearchInput, &QLineEdit::returnPressed, this, &HistoryWidget::search);
 
+   mChRegExpSearch = new QCheckBox(tr("Regular expression"));
+   mChRegExpSearch->setToolTip(tr("Search the text as a regular expression"));
+
+   mScanner = new CommitScanner(this);
+   connect(mScanner, &CommitScanner::matchesFound, this, &HistoryWidget::onSearchMatchesFound);
+   connect(mScanner, &CommitScanner::finished, this, &HistoryWidget::onSearchFinished);
+
+   mChContentSearch = new QCheckBox(tr("Search in changes"));
+   mChContentSearch->setToolTip(
+       tr("Search the commits whose changes add or remove the text, or whose diff matches the regular expression"));
+   connect(mChContentSearch, &QCheckBox::toggled, this, &HistoryWidget::onContentSearchToggled);
+
+   mContentPathInput = new QLineEdit();
+   mContentPathInput->setPlaceholderText(tr("Limit to path..."));
+   connect(mContentPathInput, &QLineEdit::returnPressed, this, &HistoryWidget::search);
+
+   mContentPeriod = new QComboBox();
+   mContentPeriod->setToolTip(tr("Limit the search to the recent commits"));
+   mContentPeriod->addItem(tr("Any time"), 0);
+   mContentPeriod->addItem(tr("Last week"), 7);
+   mContentPeriod->addItem(tr("Last month"), 30);
+   mContentPeriod->addItem(tr("Last year"), 365);
+
+   mContentSearchProgress = new QProgressBar();
+   mContentSearchProgress->setVisible(false);
+
+   mStopContentSearch = new QPushButton(tr("Stop"));
+   mStopContentSearch->setVisible(false);
+   connect(mStopContentSearch, &QPushButton::clicked, this, &HistoryWidget::stopContentSearch);
+
+   mContentSearch = new GitContentSearch(mGit, this);
+   connect(mContentSearch, &GitContentSearch::shasFound, this, &HistoryWidget::onContentShasFound);
+   connect(mContentSearch, &GitContentSearch::finished, this, &HistoryWidget::onContentSearchFinished);
+
    mRepositoryModel = new CommitHistoryModel(mCache, mGit, mGitServerCache);
    mRepositoryView = new CommitHistoryView(mCache, mGit, mSettings, mGitServerCache);
 
@@ -180,13 +219,27 @@ HistoryWidget::HistoryWidget(const QSharedPointer<GitCache> &cache, const QShare
    graphOptionsLayout->setContentsMargins(QMargins());
    graphOptionsLayout->setSpacing(10);
    graphOptionsLayout->addWidget(mSearchInput);
+   graphOptionsLayout->addWidget(mChRegExpSearch);
+   graphOptionsLayout->addWidget(mChContentSearch);
    graphOptionsLayout->addWidget(cherryPickBtn);
    graphOptionsLayout->addWidget(mChShowAllBranches);
 
+   mContentSearchOptions = new QFrame();
+   mContentSearchOptions->setVisible(false);
+
+   const auto contentSearchLayout = new QHBoxLayout(mContentSearchOptions);
+   contentSearchLayout->setContentsMargins(QMargins());
+   contentSearchLayout->setSpacing(10);
+   contentSearchLayout->addWidget(mContentPathInput);
+   contentSearchLayout->addWidget(mContentPeriod);
+   contentSearchLayout->addWidget(mContentSearchProgress);
+   contentSearchLayout->addWidget(mStopContentSearch);
+
    const auto viewLayout = new QVBoxLayout();
    viewLayout->setContentsMargins(QMargins());
    viewLayout->setSpacing(5);
    viewLayout->addLayout(graphOptionsLayout);
+   viewLayout->addWidget(mContentSearchOptions);
    viewLayout->addWidget(mRepositoryView);
 
    mGraphFrame = new QFrame();
@@ -296,6 +349,8 @@ void HistoryWidget::focusOnCommit(const QString &sha)
 
 void HistoryWidget::updateGraphView(int totalCommits)
 {
+   clearSearchResults();
+
    mRepositoryModel->onNewRevisions(totalCommits);
 
    selectCommit(CommitInfo::ZERO_SHA);
@@ -305,6 +360,34 @@ void HistoryWidget::updateGraphView(int totalCommits)
        QItemSelectionModel::Select);
 }
 
+void HistoryWidget::appendGraphRows(int totalCommits)
+{
+   mRepositoryModel->onRevisionsAppended(totalCommits);
+
+   // The rows found are still valid, the search goes on with the new ones
+   if (!mSearchText.isEmpty())
+      mScanner->scanAppended(mCache->snapshot().commits);
+}
+
+void HistoryWidget::insertGraphRows(int newCommits, int lastUpdatedRow)
+{
+   // The rows of the results are no longer valid
+   if (newCommits > 0)
+      clearSearchResults();
+
+   mRepositoryModel->onRevisionsPrepended(newCommits, lastUpdatedRow);
+}
+
+void HistoryWidget::clearSearchResults()
+{
+   mScanner->cancel();
+
+   mSearchText.clear();
+   mSearchResults.clear();
+   mCurrentSearchResult = -1;
+   mSearchInput->setToolTip(QString());
+}
+
 void HistoryWidget::keyPressEvent(QKeyEvent *event)
 {
    if (event->key() == Qt::Key_Shift)
@@ -329,9 +412,9 @@ void HistoryWidget::onOpenFullDiff(const QString &sha)
       GitHistory git(mGit);
       const auto ret = git.getCommitDiff(CommitInfo::ZERO_SHA, commit.firstParent());
 
-      if (ret.success && !ret.output.isEmpty())
+      if (ret && !ret->isEmpty())
       {
-         mFullDiffWidget->loadDiff(CommitInfo::ZERO_SHA, commit.firstParent(), ret.output);
+         mFullDiffWidget->loadDiff(CommitInfo::ZERO_SHA, commit.firstParent(), *ret);
          mCenterStackedWidget->setCurrentIndex(static_cast<int>(Pages::FullDiff));
       }
       else
@@ -389,31 +472,203 @@ void HistoryWidget::onDiffFontSizeChanged()
 
 void HistoryWidget::search()
 {
+   if (mChContentSearch->isChecked())
+   {
+      startContentSearch(mSearchInput->text(), mChRegExpSearch->isChecked());
+      return;
+   }
+
    if (const auto text = mSearchInput->text(); !text.isEmpty())
    {
-      auto commitInfo = mCache->commitInfo(text);
+      const auto isRegExp = mChRegExpSearch->isChecked();
 
-      if (commitInfo.isValid())
-         goToSha(text);
-      else
+      if (!isRegExp)
       {
-         auto selectedItems = mRepositoryView->selectedIndexes();
-         auto startingRow = 0;
-
-         if (!selectedItems.isEmpty())
+         if (const auto commitInfo = mCache->commitInfo(text); commitInfo.isValid())
          {
-            std::sort(selectedItems.begin(), selectedItems.end(),
-                      [](const QModelIndex index1, const QModelIndex index2) { return index1.row() <= index2.row(); });
-            startingRow = selectedItems.constFirst().row();
+            goToSha(text);
+            return;
          }
+      }
 
-         commitInfo = mCache->searchCommitInfo(text, startingRow + 1, mReverseSearch);
-
-         if (commitInfo.isValid())
-            goToSha(commitInfo.sha);
-         else
-            QMessageBox::information(this, tr("Not found!"), tr("No commits where found based on the search text."));
+      // Searching the same text again moves between the results of the last search
+      if (text == mSearchText && isRegExp == mSearchRegExp)
+      {
+         if (!mSearchResults.isEmpty())
+            showNextSearchResult();
+         else if (!mScanner->isRunning())
+            startSearch(text, isRegExp);
       }
+      else
+         startSearch(text, isRegExp);
+   }
+}
+
+void HistoryWidget::startSearch(const QString &text, bool isRegExp)
+{
+   clearSearchResults();
+
+   mSearchText = text;
+   mSearchRegExp = isRegExp;
+
+   if (!isRegExp && mCache->canSearchInIndex(text))
+   {
+      mSearchResults = mCache->searchCommits(text);
+
+      if (mSearchResults.isEmpty())
+         onSearchFinished();
+      else
+         showNextSearchResult();
+   }
+   else if (mScanner->start(mCache->snapshot().commits, text, isRegExp))
+      mSearchInput->setToolTip(tr("Searching..."));
+   else
+   {
+      mSearchText.clear();
+
+      QMessageBox::warning(this, tr("Invalid expression"), tr("The text is not a valid regular expression."));
+   }
+}
+
+void HistoryWidget::onSearchMatchesFound(const QVector<int> &rows)
+{
+   const auto isFirstMatch = mSearchResults.isEmpty();
+
+   mSearchResults.append(rows);
+
+   if (isFirstMatch)
+      showNextSearchResult();
+   else
+      updateSearchToolTip();
+}
+
+void HistoryWidget::onSearchFinished()
+{
+   if (mSearchResults.isEmpty())
+   {
+      mSearchText.clear();
+      mSearchInput->setToolTip(QString());
+
+      QMessageBox::information(this, tr("Not found!"), tr("No commits where found based on the search text."));
+   }
+   else
+      updateSearchToolTip();
+}
+
+void HistoryWidget::showNextSearchResult()
+{
+   const auto total = mSearchResults.count();
+
+   mCurrentSearchResult = mReverseSearch ? (qMax(mCurrentSearchResult, 0) + total - 1) % total
+                                         : (mCurrentSearchResult + 1) % total;
+
+   if (const auto commitInfo = mCache->commitInfo(mSearchResults.at(mCurrentSearchResult)); commitInfo.isValid())
+      goToSha(commitInfo.sha());
+
+   updateSearchToolTip();
+}
+
+void HistoryWidget::updateSearchToolTip()
+{
+   auto toolTip = tr("Result %1 of %2").arg(mCurrentSearchResult + 1).arg(mSearchResults.count());
+
+   if (mScanner->isRunning())
+      toolTip.append(tr(" (searching...)"));
+
+   mSearchInput->setToolTip(toolTip);
+}
+
+void HistoryWidget::onContentSearchToggled(bool checked)
+{
+   mContentSearchOptions->setVisible(checked);
+
+   if (checked)
+   {
+      clearSearchResults();
+
+      mSearchInput->setPlaceholderText(tr("Press Enter to search in the changes of the commits..."));
+   }
+   else
+   {
+      stopContentSearch();
+
+      mRepositoryView->removeFilter();
+      mSearchInput->setPlaceholderText(tr("Press Enter to search by SHA or log message..."));
+   }
+}
+
+void HistoryWidget::startContentSearch(const QString &text, bool isRegExp)
+{
+   stopContentSearch();
+
+   if (text.isEmpty())
+   {
+      mRepositoryView->removeFilter();
+      return;
+   }
+
+   GitContentSearch::Options options;
+   options.text = text;
+   options.mode = isRegExp ? GitContentSearch::Mode::Changes : GitContentSearch::Mode::Occurrences;
+   options.path = mContentPathInput->text().trimmed();
+   options.allBranches = mChShowAllBranches->isChecked();
+
+   if (const auto days = mContentPeriod->currentData().toInt(); days > 0)
+      options.since = QDateTime::currentDateTime().addDays(-days);
+
+   if (!mContentSearch->start(options))
+   {
+      QMessageBox::warning(this, tr("Search failed"), tr("The search in the changes couldn't be started."));
+      return;
+   }
+
+   // The commits are shown as they are found
+   mRepositoryView->filterBySha({});
+
+   mContentSearchProgress->setRange(0, qMax(mCache->commitCount() - 1, 1));
+   mContentSearchProgress->setValue(0);
+   mContentSearchProgress->setFormat(tr("Searching..."));
+   mContentSearchProgress->setVisible(true);
+   mStopContentSearch->setVisible(true);
+}
+
+void HistoryWidget::stopContentSearch()
+{
+   mContentSearch->cancel();
+
+   mContentSearchProgress->setVisible(false);
+   mStopContentSearch->setVisible(false);
+}
+
+void HistoryWidget::onContentShasFound(const QStringList &shas)
+{
+   mRepositoryView->addToFilter(shas);
+
+   // Git walks the history in the same order as the graph: the row of the last commit found tells how far it is
+   if (const auto commit = mCache->commitInfo(shas.last()); commit.isValid())
+      mContentSearchProgress->setValue(qMax(mContentSearchProgress->value(), static_cast<int>(commit.pos)));
+
+   mContentSearchProgress->setFormat(tr("%1 commits found").arg(mContentSearch->foundCount()));
+}
+
+void HistoryWidget::onContentSearchFinished(bool success)
+{
+   mContentSearchProgress->setVisible(false);
+   mStopContentSearch->setVisible(false);
+
+   if (!success)
+   {
+      mRepositoryView->removeFilter();
+
+      QMessageBox::warning(this, tr("Search failed"),
+                           tr("Git couldn't search the changes. Please, check that the regular expression and the "
+                              "path are valid."));
+   }
+   else if (mContentSearch->foundCount() == 0)
+   {
+      mRepositoryView->removeFilter();
+
+      QMessageBox::information(this, tr("Not found!"), tr("No commits where found based on the search text."));
    }
 }
 
@@ -426,7 +681,9 @@ void HistoryWidget::goToSha(const QString &sha)
 
 void HistoryWidget::commitSelected(const QModelIndex &index)
 {
-   const auto sha = mRepositoryModel->sha(index.row());
+   // The index belongs to the filter when the graph shows only some commits
+   const auto sha
+       = mRepositoryView->model()->index(index.row(), static_cast<int>(CommitHistoryColumns::Sha)).data().toString();
 
    selectCommit(sha);
 }
@@ -547,22 +804,22 @@ void HistoryWidget::cherryPickCommit()
    {
       const auto lastShaBeforeCommit = mGit->getLastCommit().output.trimmed();
       const auto git = GitLocal(mGit);
-      const auto ret = git.cherryPickCommit(commit.sha);
+      const auto ret = git.cherryPickCommit(commit.sha());
 
       if (ret.success)
       {
          mSearchInput->clear();
 
-         commit.sha = mGit->getLastCommit().output.trimmed();
+         commit.setSha(mGit->getLastCommit().output.trimmed());
 
          mCache->insertCommit(commit);
          mCache->deleteReference(lastShaBeforeCommit, References::Type::LocalBranch, mGit->getCurrentBranch());
-         mCache->insertReference(commit.sha, References::Type::LocalBranch, mGit->getCurrentBranch());
+         mCache->insertReference(commit.sha(), References::Type::LocalBranch, mGit->getCurrentBranch());
 
          GitHistory gitHistory(mGit);
-         const auto ret = gitHistory.getDiffFiles(commit.sha, lastShaBeforeCommit);
+         const auto ret = gitHistory.getDiffFiles(commit.sha(), lastShaBeforeCommit);
 
-         mCache->insertRevisionFiles(commit.sha, lastShaBeforeCommit, RevisionFiles(ret.output));
+         mCache->insertRevisionFiles(commit.sha(), lastShaBeforeCommit, RevisionFiles(ret.output));
 
          emit mCache->signalCacheUpdated();
          emit logReload();
@@ -596,16 +853,16 @@ void HistoryWidget::cherryPickCommit()
       {
          mSearchInput->clear();
 
-         commit.sha = mGit->getLastCommit().output.trimmed();
+         commit.setSha(mGit->getLastCommit().output.trimmed());
 
          mCache->insertCommit(commit);
          mCache->deleteReference(lastShaBeforeCommit, References::Type::LocalBranch, mGit->getCurrentBranch());
-         mCache->insertReference(commit.sha, References::Type::LocalBranch, mGit->getCurrentBranch());
+         mCache->insertReference(commit.sha(), References::Type::LocalBranch, mGit->getCurrentBranch());
 
          GitHistory gitHistory(mGit);
-         const auto ret = gitHistory.getDiffFiles(commit.sha, lastShaBeforeCommit);
+         const auto ret = gitHistory.getDiffFiles(commit.sha(), lastShaBeforeCommit);
 
-         mCache->insertRevisionFiles(commit.sha, lastShaBeforeCommit, RevisionFiles(ret.output));
+         mCache->insertRevisionFiles(commit.sha(), lastShaBeforeCommit, RevisionFiles(ret.output));
 
          emit mCache->signalCacheUpdated();
 
@@ -34,11 +34,15 @@ class BranchesWidget;
 class QStackedWidget;
 class CommitChangesWidget;
 class CommitInfoWidget;
+class CommitScanner;
+class GitContentSearch;
 class RepositoryViewDelegate;
 class FullDiffWidget;
 class FileDiffWidget;
 class BranchesWidgetMinimal;
 class QCheckBox;
+class QComboBox;
+class QProgressBar;
 class QPushButton;
 class GitServerCache;
 class QLabel;
@@ -205,6 +209,21 @@ public:
    */
    void updateGraphView(int totalCommits);
 
+   /**
+    * @brief appendGraphRows Adds to the repository graph view the revisions loaded since the last update. It keeps the
+    * current selection, the scroll position and the results of the search, that goes on with the new revisions.
+    * @param totalCommits The new total of commits to show in the graph.
+    */
+   void appendGraphRows(int totalCommits);
+
+   /**
+    * @brief insertGraphRows Adds to the repository graph view the revisions created or fetched since the history was
+    * loaded. It keeps the current selection.
+    * @param newCommits The number of revisions added on top of the history.
+    * @param lastUpdatedRow The last row whose graph changed.
+    */
+   void insertGraphRows(int newCommits, int lastUpdatedRow);
+
    /**
     * @brief onCommitTitleMaxLenghtChanged Changes the maximum length of the commit title.
     */
@@ -246,6 +265,15 @@ private:
    CommitChangesWidget *mAmendWidget = nullptr;
    CommitInfoWidget *mCommitInfoWidget = nullptr;
    QCheckBox *mChShowAllBranches = nullptr;
+   QCheckBox *mChRegExpSearch = nullptr;
+   CommitScanner *mScanner = nullptr;
+   QCheckBox *mChContentSearch = nullptr;
+   QFrame *mContentSearchOptions = nullptr;
+   QLineEdit *mContentPathInput = nullptr;
+   QComboBox *mContentPeriod = nullptr;
+   QProgressBar *mContentSearchProgress = nullptr;
+   QPushButton *mStopContentSearch = nullptr;
+   GitContentSearch *mContentSearch = nullptr;
    RepositoryViewDelegate *mItemDelegate = nullptr;
    QFrame *mGraphFrame = nullptr;
    FileDiffWidget *mFileDiff = nullptr;
@@ -254,6 +282,10 @@ private:
    QLabel *mUserName = nullptr;
    QLabel *mUserEmail = nullptr;
    bool mReverseSearch = false;
+   QString mSearchText;
+   bool mSearchRegExp = false;
+   QVector<int> mSearchResults;
+   int mCurrentSearchResult = -1;
    QSplitter *mSplitter = nullptr;
 
    /*!
@@ -261,6 +293,58 @@ private:
 
    */
    void search();
+   /**
+    * @brief clearSearchResults Discards the results of the last search so the next one is done again.
+    */
+   void clearSearchResults();
+   /**
+    * @brief startSearch Searches @p text in the history. The search index answers the plain texts when it's ready, the
+    * rest of the searches scan the history in the background and show the first match as soon as it's found.
+    * @param text The text to search.
+    * @param isRegExp Tells if @p text is a regular expression.
+    */
+   void startSearch(const QString &text, bool isRegExp);
+   /**
+    * @brief onSearchMatchesFound Adds the rows found by the background search to the results.
+    */
+   void onSearchMatchesFound(const QVector<int> &rows);
+   /**
+    * @brief onSearchFinished Notifies the user when the search didn't find any commit.
+    */
+   void onSearchFinished();
+   /**
+    * @brief showNextSearchResult Selects the next result of the search, or the previous one if shift is pressed.
+    */
+   void showNextSearchResult();
+   /**
+    * @brief updateSearchToolTip Shows in the tool tip of the search input the position in the results.
+    */
+   void updateSearchToolTip();
+   /**
+    * @brief onContentSearchToggled Switches between the search in the commit information and the search in the changes.
+    * Leaving the search in the changes stops it and shows all the commits again.
+    */
+   void onContentSearchToggled(bool checked);
+   /**
+    * @brief startContentSearch Looks in the background for the commits whose changes contain @p text. The graph is
+    * filtered to show only the commits found, that are added as soon as Git reports them.
+    * @param text The text to search.
+    * @param isRegExp Looks for the changes that match @p text as a regular expression.
+    */
+   void startContentSearch(const QString &text, bool isRegExp);
+   /**
+    * @brief stopContentSearch Cancels the search in the changes. The commits found so far are still shown.
+    */
+   void stopContentSearch();
+   /**
+    * @brief onContentShasFound Shows in the graph the commits found by the search in the changes and updates the
+    * progress.
+    */
+   void onContentShasFound(const QStringList &shas);
+   /**
+    * @brief onContentSearchFinished Hides the progress and notifies the user if the search failed or found nothing.
+    */
+   void onContentSearchFinished(bool success);
    /*!
     \brief Goes to the selected SHA.
 
@@ -17,33 +17,40 @@
 using namespace GitQlient;
 
 BranchTreeWidget::BranchTreeWidget(const QSharedPointer<GitCache> &cache, const QSharedPointer<GitBase> &git,
-                                   QWidget *parent)
-   : RefTreeWidget(parent)
+                                   RefTreeModel::Kind kind, QWidget *parent)
+   : RefTreeWidget(kind, parent)
+   , mLocal(kind == RefTreeModel::Kind::LocalBranches)
    , mCache(cache)
    , mGit(git)
 {
    connect(this, &BranchTreeWidget::customContextMenuRequested, this, &BranchTreeWidget::showBranchesContextMenu);
-   connect(this, &BranchTreeWidget::itemClicked, this, &BranchTreeWidget::selectCommit);
-   connect(this, &BranchTreeWidget::itemSelectionChanged, this, &BranchTreeWidget::onSelectionChanged);
-   connect(this, &BranchTreeWidget::itemDoubleClicked, this, &BranchTreeWidget::checkoutBranch);
+   connect(this, &BranchTreeWidget::clicked, this, &BranchTreeWidget::selectCommit);
+   connect(this, &BranchTreeWidget::doubleClicked, this, &BranchTreeWidget::checkoutBranch);
+
+   if (mLocal)
+      connect(mModel, &RefTreeModel::referencesUpdated, this, &BranchTreeWidget::focusOnCurrentBranch);
 }
 
 void BranchTreeWidget::reloadCurrentBranchLink() const
 {
-   const auto items = findChildItem(mGit->getCurrentBranch());
+   const auto currentBranch = mGit->getCurrentBranch();
 
-   if (!items.isEmpty())
-   {
-      items.at(0)->setData(0, GitQlient::ShaRole, mGit->getLastCommit().output.trimmed());
-      items.at(0)->setData(0, GitQlient::IsCurrentBranchRole, true);
-   }
+   mModel->setCurrentBranch(currentBranch);
+   mModel->setReferenceSha(currentBranch, mGit->getLastCommit().output.trimmed());
+}
+
+void BranchTreeWidget::selectionChanged(const QItemSelection &selected, const QItemSelection &deselected)
+{
+   RefTreeWidget::selectionChanged(selected, deselected);
+
+   onSelectionChanged();
 }
 
 void BranchTreeWidget::showBranchesContextMenu(const QPoint &pos)
 {
-   if (const auto item = itemAt(pos); item != nullptr)
+   if (const auto index = indexAt(pos); index.isValid())
    {
-      auto selectedBranch = item->data(0, FullNameRole).toString();
+      auto selectedBranch = index.data(FullNameRole).toString();
 
       if (!selectedBranch.isEmpty())
       {
@@ -53,23 +60,25 @@ void BranchTreeWidget::showBranchesContextMenu(const QPoint &pos)
          connect(menu, &BranchContextMenu::signalRefreshPRsCache, this, &BranchTreeWidget::signalRefreshPRsCache);
          connect(menu, &BranchContextMenu::logReload, this, &BranchTreeWidget::logReload);
          connect(menu, &BranchContextMenu::fullReload, this, &BranchTreeWidget::fullReload);
-         connect(menu, &BranchContextMenu::signalCheckoutBranch, this, [this, item]() { checkoutBranch(item); });
+         connect(menu, &BranchContextMenu::signalCheckoutBranch, this,
+                 [this, index = QPersistentModelIndex(index)]() { checkoutBranch(index); });
          connect(menu, &BranchContextMenu::signalMergeRequired, this, &BranchTreeWidget::signalMergeRequired);
          connect(menu, &BranchContextMenu::mergeSqushRequested, this, &BranchTreeWidget::mergeSqushRequested);
          connect(menu, &BranchContextMenu::signalPullConflict, this, &BranchTreeWidget::signalPullConflict);
 
          menu->exec(viewport()->mapToGlobal(pos));
       }
-      else if (item->data(0, IsRoot).toBool())
+      else if (index.data(IsRoot).toBool())
       {
+         const auto remote = index.data().toString();
+         const auto sha = index.data(ShaRole).toString();
          const auto menu = new QMenu(this);
          const auto removeRemote = menu->addAction(tr("Remove remote"));
-         connect(removeRemote, &QAction::triggered, this, [this, item]() {
+         connect(removeRemote, &QAction::triggered, this, [this, remote, sha]() {
             GitRemote git(mGit);
-            if (const auto ret = git.removeRemote(item->text(0)); ret.success)
+            if (const auto ret = git.removeRemote(remote); ret.success)
             {
-               mCache->deleteReference(item->data(0, ShaRole).toString(), References::Type::RemoteBranches,
-                                       item->text(0));
+               mCache->deleteReference(sha, References::Type::RemoteBranches, remote);
                emit logReload();
             }
          });
@@ -80,7 +89,7 @@ void BranchTreeWidget::showBranchesContextMenu(const QPoint &pos)
       {
          GitQlientSettings settings(mGit->getGitDir());
          if (settings.localValue("DeleteRemoteFolder", false).toBool() || mLocal)
-            showDeleteFolderMenu(item, pos);
+            showDeleteFolderMenu(index, pos);
          else
          {
             QMessageBox::warning(this, tr("Delete branch!"),
@@ -107,15 +116,15 @@ void BranchTreeWidget::showBranchesContextMenu(const QPoint &pos)
    }
 }
 
-void BranchTreeWidget::checkoutBranch(QTreeWidgetItem *item)
+void BranchTreeWidget::checkoutBranch(const QModelIndex &index)
 {
-   if (item)
+   if (index.isValid())
    {
-      auto branchName = item->data(0, FullNameRole).toString();
+      auto branchName = index.data(FullNameRole).toString();
 
       if (!branchName.isEmpty())
       {
-         const auto isLocal = item->data(0, LocalBranchRole).toBool();
+         const auto isLocal = index.data(LocalBranchRole).toBool();
          QApplication::setOverrideCursor(QCursor(Qt::WaitCursor));
          GitBranches git(mGit);
          const auto ret
@@ -141,15 +150,8 @@ void BranchTreeWidget::checkoutBranch(QTreeWidgetItem *item)
                   uiUpdateRequested = true;
             }
 
-            if (!uiUpdateRequested)
-            {
-               if (auto oldItem = findChildItem(mGit->getCurrentBranch()); !oldItem.empty())
-               {
-                  oldItem.at(0)->setData(0, GitQlient::IsCurrentBranchRole, false);
-                  oldItem.clear();
-                  oldItem.squeeze();
-               }
-            }
+            if (!uiUpdateRequested && mLocal)
+               mModel->setCurrentBranch(QString());
 
             emit fullReload();
          }
@@ -167,27 +169,44 @@ void BranchTreeWidget::checkoutBranch(QTreeWidgetItem *item)
    }
 }
 
-void BranchTreeWidget::selectCommit(QTreeWidgetItem *item)
+void BranchTreeWidget::selectCommit(const QModelIndex &index)
 {
-   if (item && item->data(0, IsLeaf).toBool())
-      emit signalSelectCommit(item->data(0, ShaRole).toString());
+   if (index.isValid() && index.data(IsLeaf).toBool())
+      emit signalSelectCommit(index.data(ShaRole).toString());
 }
 
 void BranchTreeWidget::onSelectionChanged()
 {
-   const auto selection = selectedItems();
+   const auto selection = selectedIndexes();
 
    if (!selection.isEmpty())
       selectCommit(selection.constFirst());
 }
 
-void BranchTreeWidget::showDeleteFolderMenu(QTreeWidgetItem *item, const QPoint &pos)
+void BranchTreeWidget::focusOnCurrentBranch()
+{
+   const auto currentBranch = mGit->getCurrentBranch();
+
+   mModel->setCurrentBranch(currentBranch);
+
+   // The tree only jumps to the current branch when it changes, not every time the references are refreshed
+   if (currentBranch == mFocusedBranch)
+      return;
+
+   if (const auto index = mModel->indexOf(currentBranch); index.isValid())
+   {
+      mFocusedBranch = currentBranch;
+      focusOnIndex(index);
+   }
+}
+
+void BranchTreeWidget::showDeleteFolderMenu(const QModelIndex &index, const QPoint &pos)
 {
-   const auto childrenCount = item->childCount();
+   const auto childrenCount = mModel->rowCount(index);
    QStringList branchesToRemove;
 
    for (auto i = 0; i < childrenCount; ++i)
-      branchesToRemove.append(item->child(i)->data(0, FullNameRole).toString());
+      branchesToRemove.append(mModel->index(i, 0, index).data(FullNameRole).toString());
 
    const auto menu = new QMenu(this);
    connect(menu->addAction("Delete folder"), &QAction::triggered, this, [this, branchesToRemove]() {
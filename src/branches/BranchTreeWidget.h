@@ -78,24 +78,23 @@ public:
     \brief Default constructor.
 
     \param git The git object to perform Git operations.
+    \param kind The branches shown by the widget: the local or the remote ones.
     \param parent The parent widget if needed.
    */
    explicit BranchTreeWidget(const QSharedPointer<GitCache> &cache, const QSharedPointer<GitBase> &git,
-                             QWidget *parent = nullptr);
-   /*!
-    \brief Configures the widget to be the local branches widget.
-
-    \param isLocal True if the current widget shows local branches, otherwise false.
-   */
-   void setLocalRepo(const bool isLocal) { mLocal = isLocal; }
+                             RefTreeModel::Kind kind, QWidget *parent = nullptr);
 
    /**
     * @brief reloadCurrentBranchLink Reloads the link to the current branch.
     */
    void reloadCurrentBranchLink() const;
 
+protected:
+   void selectionChanged(const QItemSelection &selected, const QItemSelection &deselected) override;
+
 private:
    bool mLocal = false;
+   QString mFocusedBranch;
    QSharedPointer<GitCache> mCache;
    QSharedPointer<GitBase> mGit;
 
@@ -106,22 +105,27 @@ private:
    */
    void showBranchesContextMenu(const QPoint &pos);
    /*!
-    \brief Checks out the branch selected by the \p item.
+    \brief Checks out the branch selected by the \p index.
 
-    \param item The item that contains the data of the branch.
+    \param index The index that contains the data of the branch.
    */
-   void checkoutBranch(QTreeWidgetItem *item);
+   void checkoutBranch(const QModelIndex &index);
    /*!
-    \brief Selects the commit of the given \p item branch.
+    \brief Selects the commit of the given \p index branch.
 
-    \param item The item that contains the data of the branch selected to extract the commit SHA.
+    \param index The index that contains the data of the branch selected to extract the commit SHA.
    */
-   void selectCommit(QTreeWidgetItem *item);
+   void selectCommit(const QModelIndex &index);
 
    /**
     * @brief onSelectionChanged Process when a selection has changed.
     */
    void onSelectionChanged();
 
-   void showDeleteFolderMenu(QTreeWidgetItem *item, const QPoint &pos);
+   /**
+    * @brief focusOnCurrentBranch Expands the folders of the current branch and selects it when it has changed.
+    */
+   void focusOnCurrentBranch();
+
+   void showDeleteFolderMenu(const QModelIndex &index, const QPoint &pos);
 };
@@ -14,6 +14,7 @@ HEADERS += \
     $$PWD/BranchesWidget.h \
     $$PWD/BranchesWidgetMinimal.h \
     $$PWD/GitQlientBranchItemRole.h \
+    $$PWD/RefTreeModel.h \
     $$PWD/RefTreeWidget.h \
     $$PWD/StashesContextMenu.h \
     $$PWD/SubmodulesContextMenu.h \
@@ -27,6 +28,7 @@ SOURCES += \
     $$PWD/BranchTreeWidget.cpp \
     $$PWD/BranchesWidget.cpp \
     $$PWD/BranchesWidgetMinimal.cpp \
+    $$PWD/RefTreeModel.cpp \
     $$PWD/RefTreeWidget.cpp \
     $$PWD/StashesContextMenu.cpp \
     $$PWD/SubmodulesContextMenu.cpp \
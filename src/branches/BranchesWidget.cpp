@@ -34,29 +34,6 @@ using namespace GitQlient;
 
 namespace
 {
-QTreeWidgetItem *getChild(QTreeWidgetItem *parent, const QString &childName)
-{
-   QTreeWidgetItem *child = nullptr;
-
-   if (parent)
-   {
-      const auto childrenCount = parent->childCount();
-
-      for (auto i = 0; i < childrenCount; ++i)
-         if (parent->child(i)->text(0) == childName)
-            child = parent->child(i);
-   }
-
-   return child;
-}
-
-struct RemoteBranch
-{
-   QString remote;
-   QString branch;
-   QString sha;
-};
-
 QIcon restoreIcon()
 {
    return QIcon::fromTheme("window-maximize", QIcon(":/icons/add"));
@@ -75,9 +52,9 @@ BranchesWidget::BranchesWidget(const QSharedPointer<GitCache> &cache, const QSha
    , mCache(cache)
    , mGit(git)
    , mGitTags(new GitTags(mGit, mCache))
-   , mLocalBranchesTree(new BranchTreeWidget(mCache, mGit, this))
-   , mRemoteBranchesTree(new BranchTreeWidget(mCache, mGit, this))
-   , mTagsTree(new RefTreeWidget(this))
+   , mLocalBranchesTree(new BranchTreeWidget(mCache, mGit, RefTreeModel::Kind::LocalBranches, this))
+   , mRemoteBranchesTree(new BranchTreeWidget(mCache, mGit, RefTreeModel::Kind::RemoteBranches, this))
+   , mTagsTree(new RefTreeWidget(RefTreeModel::Kind::Tags, this))
    , mStashesList(new QListWidget())
    , mStashesTitleLabel(new QLabel(tr("Stashes (0)")))
    , mStashesArrow(new QLabel())
@@ -95,23 +72,9 @@ BranchesWidget::BranchesWidget(const QSharedPointer<GitCache> &cache, const QSha
 
    setAttribute(Qt::WA_DeleteOnClose);
 
-   mLocalBranchesTree->setLocalRepo(true);
-   mLocalBranchesTree->setColumnCount(1);
    mLocalBranchesTree->setObjectName("LocalBranches");
    mLocalBranchesTree->setRootIsDecorated(false);
 
-   const auto localHeader = mLocalBranchesTree->headerItem();
-   localHeader->setText(0, tr("Local"));
-
-   mRemoteBranchesTree->setColumnCount(1);
-
-   const auto remoteHeader = mRemoteBranchesTree->headerItem();
-   remoteHeader->setText(0, tr("Remote"));
-
-   const auto tagHeader = mTagsTree->headerItem();
-   tagHeader->setText(0, tr("Tags"));
-
-   mTagsTree->setColumnCount(1);
    mTagsTree->setContextMenuPolicy(Qt::CustomContextMenu);
    mTagsTree->setRootIsDecorated(false);
 
@@ -304,7 +267,7 @@ BranchesWidget::BranchesWidget(const QSharedPointer<GitCache> &cache, const QSha
    connect(mRemoteBranchesTree, &BranchTreeWidget::signalMergeRequired, this, &BranchesWidget::signalMergeRequired);
    connect(mRemoteBranchesTree, &BranchTreeWidget::mergeSqushRequested, this, &BranchesWidget::mergeSqushRequested);
 
-   connect(mTagsTree, &QTreeWidget::itemClicked, this, &BranchesWidget::onTagClicked);
+   connect(mTagsTree, &RefTreeWidget::clicked, this, &BranchesWidget::onTagClicked);
    connect(mTagsTree, &QListWidget::customContextMenuRequested, this, &BranchesWidget::showTagsContextMenu);
    connect(mStashesList, &QListWidget::itemClicked, this, &BranchesWidget::onStashClicked);
    connect(mStashesList, &QListWidget::customContextMenuRequested, this, &BranchesWidget::showStashesContextMenu);
@@ -325,118 +288,39 @@ void BranchesWidget::showBranches()
 {
    QLog_Info("UI", QString("Loading branches data"));
 
-   clear();
    mMinimal->clearActions();
 
-   QApplication::setOverrideCursor(QCursor(Qt::WaitCursor));
+   // All the references are read at once: the cache is not locked again while the trees are updated. The trees compare
+   // the snapshot with the references they show in the background.
+   const auto references = mCache->referencesSnapshot();
 
-   auto branches = mCache->getBranches(References::Type::LocalBranch);
-   std::map<QString, QString> branchShaMap;
-   std::map<QString, QString> branchFolderShaMap;
+   mLocalBranchesTree->refModel()->setReferences(references);
+   mRemoteBranchesTree->refModel()->setReferences(references);
 
-   for (const auto &pair : qAsConst(branches))
-   {
-      for (const auto &branch : pair.second)
-      {
-         if (branch.contains("/"))
-            branchFolderShaMap.insert(std::make_pair(branch, pair.first));
-         else
-            branchShaMap.insert(std::make_pair(branch, pair.first));
-      }
-   }
+   const auto localBranches = references.referencesOfType(References::Type::LocalBranch);
 
-   if (!branches.empty())
-   {
-      QLog_Info("UI", QString("Fetched {%1} local branches").arg(branches.count()));
-      QLog_Info("UI", QString("Processing local branches..."));
+   QLog_Info("UI", QString("Fetched {%1} local branches").arg(localBranches.count()));
 
-      for (const auto &iter : branchFolderShaMap)
-      {
-         if (!iter.first.contains("HEAD->"))
-         {
-            processLocalBranch(iter.second, iter.first);
-            mMinimal->configureLocalMenu(iter.second, iter.first);
-         }
-      }
-
-      for (const auto &iter : branchShaMap)
-      {
-         if (!iter.first.contains("HEAD->"))
-         {
-            processLocalBranch(iter.second, iter.first);
-            mMinimal->configureLocalMenu(iter.second, iter.first);
-         }
-      }
-
-      QLog_Info("UI", QString("... local branches processed"));
-   }
-
-   branches.clear();
-   branches.squeeze();
-   branchShaMap.clear();
-   branchFolderShaMap.clear();
-   branches = mCache->getBranches(References::Type::RemoteBranches);
-
-   QVector<RemoteBranch> remoteBranches;
-
-   for (const auto &pair : qAsConst(branches))
+   for (auto iter = localBranches.cbegin(); iter != localBranches.cend(); ++iter)
    {
-      for (const auto &branch : pair.second)
-      {
-         remoteBranches.append(
-             RemoteBranch { branch.mid(0, branch.indexOf("/")), branch.mid(branch.indexOf("/") + 1), pair.first });
-      }
+      if (!iter.key().contains("HEAD->"))
+         mMinimal->configureLocalMenu(iter.value(), iter.key());
    }
 
-   std::sort(remoteBranches.begin(), remoteBranches.end(), [](const RemoteBranch &r1, const RemoteBranch &r2) {
-      return r1.remote == r2.remote ? r1.branch < r2.branch : r1.remote < r2.remote;
-   });
+   const auto remoteBranches = references.referencesOfType(References::Type::RemoteBranches);
 
-   for (const auto &branchInfo : qAsConst(remoteBranches))
-   {
-      const auto fullBranchName = QString("%1/%2").arg(branchInfo.remote, branchInfo.branch);
+   QLog_Info("UI", QString("Fetched {%1} remote branches").arg(remoteBranches.count()));
 
-      if (branchInfo.branch.contains("/"))
-         branchFolderShaMap.insert(std::make_pair(fullBranchName, branchInfo.sha));
-      else
-         branchShaMap.insert(std::make_pair(fullBranchName, branchInfo.sha));
-   }
-
-   if (!branches.empty())
+   for (auto iter = remoteBranches.cbegin(); iter != remoteBranches.cend(); ++iter)
    {
-      QLog_Info("UI", QString("Fetched {%1} remote branches").arg(branches.count()));
-      QLog_Info("UI", QString("Processing remote branches..."));
-
-      for (const auto &iter : branchFolderShaMap)
-      {
-         if (!iter.first.contains("HEAD->"))
-         {
-            processRemoteBranch(iter.second, iter.first);
-            mMinimal->configureRemoteMenu(iter.second, iter.first);
-         }
-      }
-
-      for (const auto &iter : branchShaMap)
-      {
-         if (!iter.first.contains("HEAD->"))
-         {
-            processRemoteBranch(iter.second, iter.first);
-            mMinimal->configureRemoteMenu(iter.second, iter.first);
-         }
-      }
-
-      branches.clear();
-      branches.squeeze();
-
-      QLog_Info("UI", QString("... remote branches processed"));
+      if (!iter.key().contains("HEAD->"))
+         mMinimal->configureRemoteMenu(iter.value(), iter.key());
    }
 
    processStashes();
    processSubmodules();
    processSubtrees();
 
-   QApplication::restoreOverrideCursor();
-
    adjustBranchesTree(mLocalBranchesTree);
 }
 
@@ -448,8 +332,8 @@ void BranchesWidget::refreshCurrentBranchLink()
 void BranchesWidget::clear()
 {
    blockSignals(true);
-   mLocalBranchesTree->clear();
-   mRemoteBranchesTree->clear();
+   mLocalBranchesTree->refModel()->clear();
+   mRemoteBranchesTree->refModel()->clear();
    blockSignals(false);
 }
 
@@ -514,277 +398,9 @@ void BranchesWidget::onPanelsVisibilityChaned()
    mSubtreeList->setVisible(visible);
 }
 
-void BranchesWidget::processLocalBranch(const QString &sha, QString branch)
-{
-   QLog_Debug("UI", QString("Adding local branch {%1}").arg(branch));
-
-   auto isCurrentBranch = false;
-
-   if (branch == mGit->getCurrentBranch())
-      isCurrentBranch = true;
-
-   const auto fullBranchName = branch;
-
-   QVector<QTreeWidgetItem *> parents;
-   QTreeWidgetItem *parent = nullptr;
-   auto folders = branch.split("/");
-   branch = folders.takeLast();
-
-   for (const auto &folder : qAsConst(folders))
-   {
-      QTreeWidgetItem *child = nullptr;
-
-      if (parent)
-      {
-         child = getChild(parent, folder);
-         parents.append(child);
-      }
-      else
-      {
-         for (auto i = 0; i < mLocalBranchesTree->topLevelItemCount(); ++i)
-         {
-            if (mLocalBranchesTree->topLevelItem(i)->text(0) == folder)
-            {
-               child = mLocalBranchesTree->topLevelItem(i);
-               parents.append(child);
-            }
-         }
-      }
-
-      if (!child)
-      {
-         const auto item = parent ? new QTreeWidgetItem(parent) : new QTreeWidgetItem();
-         item->setText(0, folder);
-
-         if (!parent)
-            mLocalBranchesTree->addTopLevelItem(item);
-
-         parent = item;
-         parents.append(parent);
-      }
-      else
-      {
-         parent = child;
-         parents.append(child);
-      }
-   }
-
-   auto item = new QTreeWidgetItem(parent);
-   item->setChildIndicatorPolicy(QTreeWidgetItem::DontShowIndicator);
-   item->setText(0, branch);
-   item->setData(0, GitQlient::IsCurrentBranchRole, isCurrentBranch);
-   item->setData(0, GitQlient::FullNameRole, fullBranchName);
-   item->setData(0, GitQlient::LocalBranchRole, true);
-   item->setData(0, GitQlient::ShaRole, sha);
-   item->setData(0, Qt::ToolTipRole, fullBranchName);
-   item->setData(0, GitQlient::IsLeaf, true);
-   item->setIcon(0, QIcon::fromTheme("vcs-branch", QIcon(":/icons/repo_indicator")));
-
-   if (branch == "detached")
-   {
-      QFont font = item->font(0);
-      font.setItalic(true);
-      item->setFont(0, font);
-   }
-
-   if (isCurrentBranch)
-   {
-      item->setSelected(true);
-
-      QFont font = item->font(0);
-      font.setBold(true);
-      item->setFont(0, font);
-
-      for (const auto parent : parents)
-      {
-         mLocalBranchesTree->setCurrentItem(item);
-         mLocalBranchesTree->expandItem(parent);
-         const auto indexToScroll = mLocalBranchesTree->currentIndex();
-         mLocalBranchesTree->scrollTo(indexToScroll);
-      }
-   }
-
-   parents.clear();
-   parents.squeeze();
-
-   mLocalBranchesTree->addTopLevelItem(item);
-
-   QLog_Debug("UI", QString("Finish gathering local branch information"));
-}
-
-void BranchesWidget::processRemoteBranch(const QString &sha, QString branch)
-{
-   const auto fullBranchName = branch;
-   auto folders = branch.split("/");
-   branch = folders.takeLast();
-
-   QTreeWidgetItem *parent = nullptr;
-
-   for (const auto &folder : qAsConst(folders))
-   {
-      QTreeWidgetItem *child = nullptr;
-
-      if (parent)
-         child = getChild(parent, folder);
-      else
-      {
-         for (auto i = 0; i < mRemoteBranchesTree->topLevelItemCount(); ++i)
-         {
-            if (mRemoteBranchesTree->topLevelItem(i)->text(0) == folder)
-               child = mRemoteBranchesTree->topLevelItem(i);
-         }
-      }
-
-      if (!child)
-      {
-         const auto item = parent ? new QTreeWidgetItem(parent) : new QTreeWidgetItem();
-         item->setText(0, folder);
-
-         if (!parent)
-         {
-            item->setData(0, GitQlient::IsRoot, true);
-            item->setIcon(0, QIcon::fromTheme("folder-cloud", QIcon(":/icons/folder_indicator")));
-            mRemoteBranchesTree->addTopLevelItem(item);
-         }
-
-         parent = item;
-      }
-      else
-         parent = child;
-   }
-
-   QLog_Trace("UI", QString("Adding remote branch {%1}").arg(branch));
-
-   const auto item = new QTreeWidgetItem(parent);
-   item->setChildIndicatorPolicy(QTreeWidgetItem::DontShowIndicator);
-   item->setText(0, branch);
-   item->setData(0, GitQlient::FullNameRole, fullBranchName);
-   item->setData(0, GitQlient::LocalBranchRole, false);
-   item->setData(0, GitQlient::ShaRole, sha);
-   item->setData(0, Qt::ToolTipRole, fullBranchName);
-   item->setData(0, GitQlient::IsLeaf, true);
-   item->setIcon(0, QIcon::fromTheme("vcs-branch", QIcon(":/icons/repo_indicator")));
-}
-
 void BranchesWidget::processTags()
 {
-   mTagsTree->clear();
-
-   const auto localTags = mCache->getTags(References::Type::LocalTag);
-   auto remoteTags = mCache->getTags(References::Type::RemoteTag);
-
-   for (auto iter = localTags.cbegin(); iter != localTags.cend(); ++iter)
-   {
-      QTreeWidgetItem *parent = nullptr;
-      auto fullTagName = iter.key();
-      auto folders = fullTagName.split("/");
-      auto tagName = folders.takeLast();
-
-      for (const auto &folder : qAsConst(folders))
-      {
-         QTreeWidgetItem *child = nullptr;
-
-         if (parent)
-            child = getChild(parent, folder);
-         else
-         {
-            for (auto i = 0; i < mTagsTree->topLevelItemCount(); ++i)
-            {
-               if (mTagsTree->topLevelItem(i)->text(0) == folder)
-                  child = mTagsTree->topLevelItem(i);
-            }
-         }
-
-         if (!child)
-         {
-            const auto item = parent ? new QTreeWidgetItem(parent) : new QTreeWidgetItem();
-            item->setText(0, folder);
-
-            if (!parent)
-               mTagsTree->addTopLevelItem(item);
-
-            parent = item;
-         }
-         else
-            parent = child;
-      }
-
-      const auto item = new QTreeWidgetItem(parent);
-
-      if (!remoteTags.contains(fullTagName))
-      {
-         tagName += " (local)";
-         item->setData(0, LocalBranchRole, false);
-      }
-      else
-      {
-         item->setData(0, LocalBranchRole, true);
-         remoteTags.remove(fullTagName);
-      }
-
-      QLog_Trace("UI", QString("Adding tag {%1}").arg(tagName));
-
-      item->setChildIndicatorPolicy(QTreeWidgetItem::DontShowIndicator);
-      item->setText(0, tagName);
-      item->setData(0, GitQlient::FullNameRole, fullTagName);
-      item->setData(0, GitQlient::ShaRole, iter.value());
-      item->setData(0, Qt::ToolTipRole, fullTagName);
-      item->setData(0, GitQlient::IsLeaf, true);
-      item->setIcon(0, QIcon::fromTheme("tag", QIcon(":/icons/tag_indicator")));
-
-      mTagsTree->addTopLevelItem(item);
-   }
-
-   for (auto iter = remoteTags.cbegin(); iter != remoteTags.cend(); ++iter)
-   {
-      QTreeWidgetItem *parent = nullptr;
-      auto fullTagName = iter.key();
-      auto folders = fullTagName.split("/");
-      auto tagName = folders.takeLast();
-
-      for (const auto &folder : qAsConst(folders))
-      {
-         QTreeWidgetItem *child = nullptr;
-
-         if (parent)
-            child = getChild(parent, folder);
-         else
-         {
-            for (auto i = 0; i < mTagsTree->topLevelItemCount(); ++i)
-            {
-               if (mTagsTree->topLevelItem(i)->text(0) == folder)
-                  child = mTagsTree->topLevelItem(i);
-            }
-         }
-
-         if (!child)
-         {
-            const auto item = parent ? new QTreeWidgetItem(parent) : new QTreeWidgetItem();
-            item->setText(0, folder);
-
-            if (!parent)
-               mTagsTree->addTopLevelItem(item);
-
-            parent = item;
-         }
-         else
-            parent = child;
-      }
-
-      QLog_Trace("UI", QString("Adding tag {%1}").arg(tagName));
-
-      const auto item = new QTreeWidgetItem(parent);
-      item->setChildIndicatorPolicy(QTreeWidgetItem::DontShowIndicator);
-      item->setText(0, tagName);
-      item->setData(0, GitQlient::FullNameRole, fullTagName);
-      item->setData(0, GitQlient::ShaRole, iter.value());
-      item->setData(0, Qt::ToolTipRole, fullTagName);
-      item->setData(0, GitQlient::IsLeaf, true);
-
-      mTagsTree->addTopLevelItem(item);
-   }
-
-   mTagsTree->update();
+   mTagsTree->refModel()->setReferences(mCache->referencesSnapshot());
 }
 
 void BranchesWidget::processStashes()
@@ -868,12 +484,14 @@ void BranchesWidget::processSubtrees()
 
 void BranchesWidget::adjustBranchesTree(BranchTreeWidget *treeWidget)
 {
-   for (auto i = 1; i < treeWidget->columnCount(); ++i)
+   const auto columnCount = treeWidget->model()->columnCount();
+
+   for (auto i = 1; i < columnCount; ++i)
       treeWidget->resizeColumnToContents(i);
 
    treeWidget->header()->setSectionResizeMode(0, QHeaderView::Stretch);
 
-   for (auto i = 1; i < treeWidget->columnCount(); ++i)
+   for (auto i = 1; i < columnCount; ++i)
       treeWidget->header()->setSectionResizeMode(i, QHeaderView::ResizeToContents);
 
    treeWidget->header()->setStretchLastSection(false);
@@ -881,16 +499,16 @@ void BranchesWidget::adjustBranchesTree(BranchTreeWidget *treeWidget)
 
 void BranchesWidget::showTagsContextMenu(const QPoint &p)
 {
-   const auto item = mTagsTree->itemAt(p);
+   const auto index = mTagsTree->indexAt(p);
 
-   if (!item)
+   if (!index.isValid())
       return;
 
-   const auto tagName = item->data(0, GitQlient::FullNameRole).toString();
+   const auto tagName = index.data(GitQlient::FullNameRole).toString();
 
    if (!tagName.isEmpty())
    {
-      const auto isRemote = item->data(0, LocalBranchRole).toBool();
+      const auto isRemote = index.data(LocalBranchRole).toBool();
       const auto menu = new QMenu(this);
       const auto removeTagAction = menu->addAction(tr("Remove tag"));
       connect(removeTagAction, &QAction::triggered, this, [this, tagName, isRemote]() {
@@ -1064,10 +682,10 @@ void BranchesWidget::onSubtreesHeaderClicked()
    emit panelsVisibilityChanged();
 }
 
-void BranchesWidget::onTagClicked(QTreeWidgetItem *item)
+void BranchesWidget::onTagClicked(const QModelIndex &index)
 {
-   if (item && item->data(0, IsLeaf).toBool())
-      emit signalSelectCommit(item->data(0, ShaRole).toString());
+   if (index.isValid() && index.data(IsLeaf).toBool())
+      emit signalSelectCommit(index.data(ShaRole).toString());
 }
 
 void BranchesWidget::onStashClicked(QListWidgetItem *item)
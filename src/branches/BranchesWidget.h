@@ -34,8 +34,7 @@ class GitTags;
 class GitCache;
 class QPushButton;
 class BranchesWidgetMinimal;
-class QTreeWidget;
-class QTreeWidgetItem;
+class QModelIndex;
 class RefTreeWidget;
 
 /*!
@@ -178,21 +177,7 @@ private:
    void minimalView();
 
    /*!
-    \brief Method that for a given \p branch process all the information and creates the item that will be stored in the
-    local branches BranchTreeWidget.
-
-    \param branch The branch to be added in the tree widget.
-   */
-   void processLocalBranch(const QString &sha, QString branch);
-   /*!
-    \brief Method that for a given \p branch process all the information and creates the item that will be stored in the
-    remote branches BranchTreeWidget.
-
-    \param branch The remote branch to be added in the tree widget.
-   */
-   void processRemoteBranch(const QString &sha, QString branch);
-   /*!
-    \brief Process all the tags and adds them into the QListWidget.
+    \brief Process all the tags and updates the tags tree with them.
 
    */
    void processTags();
@@ -260,9 +245,9 @@ private:
    /*!
     \brief Gets the SHA for a given tag and notifies the UI that it should select it in the repository view.
 
-    \param item The tag item from the tags list.
+    \param index The index of the tag in the tags tree.
    */
-   void onTagClicked(QTreeWidgetItem *item);
+   void onTagClicked(const QModelIndex &index);
    /*!
     \brief Gets the SHA for a given stash and notifies the UI that it should select it in the repository view.
 
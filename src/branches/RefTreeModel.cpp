@@ -0,0 +1,497 @@
+#include "RefTreeModel.h"
+
+#include <GitQlientBranchItemRole.h>
+
+#include <QFont>
+#include <QtConcurrent>
+
+#include <algorithm>
+
+using namespace GitQlient;
+
+namespace
+{
+// Above this ratio of changed references it's cheaper to build the tree again than to emit a signal for every row
+const int REBUILD_RATIO = 2;
+
+QString lastSection(const QString &fullName)
+{
+   return fullName.mid(fullName.lastIndexOf("/") + 1);
+}
+}
+
+RefTreeModel::RefTreeModel(Kind kind, QObject *parent)
+   : QAbstractItemModel(parent)
+   , mKind(kind)
+   , mRoot(QSharedPointer<Node>::create())
+   , mReferenceIcon(kind == Kind::Tags ? QIcon::fromTheme("tag", QIcon(":/icons/tag_indicator"))
+                                       : QIcon::fromTheme("vcs-branch", QIcon(":/icons/repo_indicator")))
+   , mRemoteIcon(QIcon::fromTheme("folder-cloud", QIcon(":/icons/folder_indicator")))
+{
+   connect(&mWatcher, &QFutureWatcher<Changes>::finished, this, [this]() {
+      const auto changes = mWatcher.result();
+
+      if (changes.generation == mGeneration)
+         applyChanges(changes);
+
+      if (mPendingReferences)
+      {
+         const auto references = *mPendingReferences;
+         mPendingReferences.reset();
+
+         setReferences(references);
+      }
+   });
+}
+
+void RefTreeModel::setReferences(const ReferencesIndex &references)
+{
+   if (mWatcher.isRunning())
+   {
+      mPendingReferences = references;
+      return;
+   }
+
+   const auto kind = mKind;
+   const auto current = mReferences;
+   const auto generation = mGeneration;
+
+   mWatcher.setFuture(QtConcurrent::run([kind, references, current, generation]() {
+      auto changes = computeChanges(kind, references, current);
+      changes.generation = generation;
+
+      return changes;
+   }));
+}
+
+void RefTreeModel::clear()
+{
+   ++mGeneration;
+   mPendingReferences.reset();
+
+   beginResetModel();
+   mRoot = QSharedPointer<Node>::create();
+   mLeaves.clear();
+   mReferences.clear();
+   endResetModel();
+}
+
+void RefTreeModel::setCurrentBranch(const QString &fullName)
+{
+   if (mCurrentBranch == fullName)
+      return;
+
+   const auto previous = indexOf(mCurrentBranch);
+   mCurrentBranch = fullName;
+
+   if (previous.isValid())
+      emit dataChanged(previous, previous, { IsCurrentBranchRole, Qt::FontRole });
+
+   if (const auto current = indexOf(mCurrentBranch); current.isValid())
+      emit dataChanged(current, current, { IsCurrentBranchRole, Qt::FontRole });
+}
+
+void RefTreeModel::setReferenceSha(const QString &fullName, const QString &sha)
+{
+   const auto leaf = mLeaves.value(fullName);
+
+   if (!leaf || leaf->reference.sha == sha)
+      return;
+
+   leaf->reference.sha = sha;
+   mReferences[fullName].sha = sha;
+
+   const auto index = indexOfNode(leaf);
+   emit dataChanged(index, index, { ShaRole });
+}
+
+QModelIndex RefTreeModel::indexOf(const QString &fullName) const
+{
+   const auto leaf = mLeaves.value(fullName);
+
+   return leaf ? indexOfNode(leaf) : QModelIndex();
+}
+
+QModelIndex RefTreeModel::index(int row, int column, const QModelIndex &parent) const
+{
+   const auto parentNode = parent.isValid() ? static_cast<Node *>(parent.internalPointer()) : mRoot.data();
+
+   if (column != 0 || row < 0 || row >= parentNode->children.count())
+      return QModelIndex();
+
+   return createIndex(row, column, parentNode->children.at(row));
+}
+
+QModelIndex RefTreeModel::parent(const QModelIndex &index) const
+{
+   if (!index.isValid())
+      return QModelIndex();
+
+   return indexOfNode(static_cast<Node *>(index.internalPointer())->parent);
+}
+
+int RefTreeModel::rowCount(const QModelIndex &parent) const
+{
+   if (parent.column() > 0)
+      return 0;
+
+   const auto parentNode = parent.isValid() ? static_cast<Node *>(parent.internalPointer()) : mRoot.data();
+
+   return parentNode->children.count();
+}
+
+int RefTreeModel::columnCount(const QModelIndex &) const
+{
+   return 1;
+}
+
+QVariant RefTreeModel::data(const QModelIndex &index, int role) const
+{
+   if (!index.isValid())
+      return QVariant();
+
+   const auto node = static_cast<Node *>(index.internalPointer());
+
+   if (node->isFolder)
+   {
+      const auto isRemote = mKind == Kind::RemoteBranches && node->parent == mRoot.data();
+
+      switch (role)
+      {
+         case Qt::DisplayRole:
+            return node->name;
+         case IsRoot:
+            return isRemote;
+         case Qt::DecorationRole:
+            return isRemote ? mRemoteIcon : QVariant();
+         default:
+            return QVariant();
+      }
+   }
+
+   const auto &reference = node->reference;
+   const auto isCurrentBranch = mKind == Kind::LocalBranches && node->name == mCurrentBranch;
+
+   switch (role)
+   {
+      case Qt::DisplayRole:
+         return reference.label;
+      case Qt::ToolTipRole:
+      case FullNameRole:
+         return node->name;
+      case ShaRole:
+         return reference.sha;
+      case LocalBranchRole:
+         return reference.isLocal;
+      case IsLeaf:
+         return true;
+      case IsCurrentBranchRole:
+         return isCurrentBranch;
+      case Qt::DecorationRole:
+         return reference.isDecorated ? mReferenceIcon : QVariant();
+      case Qt::FontRole:
+      {
+         QFont font;
+         font.setBold(isCurrentBranch);
+         font.setItalic(mKind == Kind::LocalBranches && reference.label == "detached");
+
+         return font;
+      }
+      default:
+         return QVariant();
+   }
+}
+
+QVariant RefTreeModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+   if (section != 0 || orientation != Qt::Horizontal || role != Qt::DisplayRole)
+      return QVariant();
+
+   switch (mKind)
+   {
+      case Kind::LocalBranches:
+         return tr("Local");
+      case Kind::RemoteBranches:
+         return tr("Remote");
+      case Kind::Tags:
+         return tr("Tags");
+   }
+
+   return QVariant();
+}
+
+RefTreeModel::Snapshot RefTreeModel::readReferences(Kind kind, const ReferencesIndex &references)
+{
+   Snapshot snapshot;
+
+   if (kind == Kind::Tags)
+   {
+      const auto &localTags = references.shas(References::Type::LocalTag);
+      const auto &remoteTags = references.shas(References::Type::RemoteTag);
+
+      snapshot.reserve(localTags.count() + remoteTags.count());
+
+      // The tags that were not pushed are marked
+      for (auto iter = localTags.cbegin(); iter != localTags.cend(); ++iter)
+      {
+         const auto isPushed = remoteTags.contains(iter.key());
+         auto label = lastSection(iter.key());
+
+         if (!isPushed)
+            label += " (local)";
+
+         snapshot.insert(iter.key(), { iter.value().toString(), label, isPushed, true });
+      }
+
+      for (auto iter = remoteTags.cbegin(); iter != remoteTags.cend(); ++iter)
+      {
+         if (!localTags.contains(iter.key()))
+            snapshot.insert(iter.key(), { iter.value().toString(), lastSection(iter.key()), false, false });
+      }
+
+      return snapshot;
+   }
+
+   const auto isLocal = kind == Kind::LocalBranches;
+   const auto &branches
+       = references.shas(isLocal ? References::Type::LocalBranch : References::Type::RemoteBranches);
+
+   snapshot.reserve(branches.count());
+
+   for (auto iter = branches.cbegin(); iter != branches.cend(); ++iter)
+   {
+      if (!iter.key().contains("HEAD->"))
+         snapshot.insert(iter.key(), { iter.value().toString(), lastSection(iter.key()), isLocal, true });
+   }
+
+   return snapshot;
+}
+
+RefTreeModel::Changes RefTreeModel::computeChanges(Kind kind, const ReferencesIndex &references,
+                                                   const Snapshot &current)
+{
+   Changes changes;
+   changes.references = readReferences(kind, references);
+
+   const auto &next = changes.references;
+
+   for (auto iter = current.cbegin(); iter != current.cend(); ++iter)
+   {
+      if (!next.contains(iter.key()))
+         changes.removed.append(iter.key());
+   }
+
+   for (auto iter = next.cbegin(); iter != next.cend(); ++iter)
+   {
+      if (const auto previous = current.constFind(iter.key()); previous == current.cend())
+         changes.added.append(iter.key());
+      else if (previous.value() != iter.value())
+         changes.updated.append(iter.key());
+   }
+
+   const auto totalChanges = changes.removed.count() + changes.added.count();
+
+   if ((current.isEmpty() && !next.isEmpty()) || totalChanges * REBUILD_RATIO > next.count())
+   {
+      changes.root = buildTree(next, changes.leaves);
+      changes.removed.clear();
+      changes.added.clear();
+      changes.updated.clear();
+   }
+
+   return changes;
+}
+
+QSharedPointer<RefTreeModel::Node> RefTreeModel::buildTree(const Snapshot &references, QHash<QString, Node *> &leaves)
+{
+   const auto root = QSharedPointer<Node>::create();
+
+   leaves.reserve(references.count());
+
+   for (auto iter = references.cbegin(); iter != references.cend(); ++iter)
+   {
+      auto parent = root.data();
+      auto folders = iter.key().split("/");
+      folders.removeLast();
+
+      for (const auto &folder : qAsConst(folders))
+      {
+         auto child = parent->folders.value(folder);
+
+         if (!child)
+         {
+            child = new Node();
+            child->parent = parent;
+            child->name = folder;
+            parent->children.append(child);
+            parent->folders.insert(folder, child);
+         }
+
+         parent = child;
+      }
+
+      const auto leaf = new Node();
+      leaf->parent = parent;
+      leaf->name = iter.key();
+      leaf->isFolder = false;
+      leaf->reference = iter.value();
+      parent->children.append(leaf);
+
+      leaves.insert(iter.key(), leaf);
+   }
+
+   // The children are sorted once, when all of them are in the tree
+   QVector<Node *> pending { root.data() };
+
+   while (!pending.isEmpty())
+   {
+      const auto node = pending.takeLast();
+      std::sort(node->children.begin(), node->children.end(), isBefore);
+
+      for (auto row = 0; row < node->children.count(); ++row)
+      {
+         const auto child = node->children.at(row);
+         child->row = row;
+
+         if (child->isFolder)
+            pending.append(child);
+      }
+   }
+
+   return root;
+}
+
+bool RefTreeModel::isBefore(const Node *first, const Node *second)
+{
+   // The folders go before the references
+   if (first->isFolder != second->isFolder)
+      return first->isFolder;
+
+   return first->name < second->name;
+}
+
+void RefTreeModel::applyChanges(const Changes &changes)
+{
+   if (changes.root)
+   {
+      beginResetModel();
+      mRoot = changes.root;
+      mLeaves = changes.leaves;
+      mReferences = changes.references;
+      endResetModel();
+   }
+   else
+   {
+      mReferences = changes.references;
+
+      for (const auto &fullName : changes.removed)
+         removeReference(fullName);
+
+      for (const auto &fullName : changes.added)
+         insertReference(fullName, mReferences.value(fullName));
+
+      for (const auto &fullName : changes.updated)
+      {
+         if (const auto leaf = mLeaves.value(fullName))
+         {
+            leaf->reference = mReferences.value(fullName);
+
+            const auto index = indexOfNode(leaf);
+            emit dataChanged(index, index);
+         }
+      }
+   }
+
+   emit referencesUpdated();
+}
+
+void RefTreeModel::insertReference(const QString &fullName, const Reference &reference)
+{
+   auto parent = mRoot.data();
+   auto folders = fullName.split("/");
+   folders.removeLast();
+
+   for (const auto &folder : qAsConst(folders))
+   {
+      auto child = parent->folders.value(folder);
+
+      if (!child)
+      {
+         child = new Node();
+         child->name = folder;
+         insertNode(parent, child);
+      }
+
+      parent = child;
+   }
+
+   const auto leaf = new Node();
+   leaf->name = fullName;
+   leaf->isFolder = false;
+   leaf->reference = reference;
+   insertNode(parent, leaf);
+
+   mLeaves.insert(fullName, leaf);
+}
+
+void RefTreeModel::removeReference(const QString &fullName)
+{
+   auto node = mLeaves.take(fullName);
+
+   if (!node)
+      return;
+
+   // The folders that are left empty are removed with the reference
+   while (node->parent != mRoot.data() && node->parent->children.count() == 1)
+      node = node->parent;
+
+   removeNode(node);
+}
+
+void RefTreeModel::insertNode(Node *parent, Node *node)
+{
+   const auto &children = parent->children;
+   const auto position
+       = static_cast<int>(std::lower_bound(children.cbegin(), children.cend(), node, isBefore) - children.cbegin());
+
+   beginInsertRows(indexOfNode(parent), position, position);
+
+   node->parent = parent;
+   parent->children.insert(position, node);
+
+   if (node->isFolder)
+      parent->folders.insert(node->name, node);
+
+   for (auto row = position; row < parent->children.count(); ++row)
+      parent->children.at(row)->row = row;
+
+   endInsertRows();
+}
+
+void RefTreeModel::removeNode(Node *node)
+{
+   const auto parent = node->parent;
+   const auto position = node->row;
+
+   beginRemoveRows(indexOfNode(parent), position, position);
+
+   parent->children.removeAt(position);
+
+   if (node->isFolder)
+      parent->folders.remove(node->name);
+
+   for (auto row = position; row < parent->children.count(); ++row)
+      parent->children.at(row)->row = row;
+
+   endRemoveRows();
+
+   delete node;
+}
+
+QModelIndex RefTreeModel::indexOfNode(Node *node) const
+{
+   if (!node || node == mRoot.data())
+      return QModelIndex();
+
+   return createIndex(node->row, 0, node);
+}
@@ -0,0 +1,171 @@
+#pragma once
+
+/****************************************************************************************
+ ** GitQlient is an application to manage and operate one or several Git repositories. With
+ ** GitQlient you will be able to add commits, branches and manage all the options Git provides.
+ ** Copyright (C) 2021  Francesc Martinez
+ **
+ ** LinkedIn: www.linkedin.com/in/cescmm/
+ ** Web: www.francescmm.com
+ **
+ ** This program is free software; you can redistribute it and/or
+ ** modify it under the terms of the GNU Lesser General Public
+ ** License as published by the Free Software Foundation; either
+ ** version 2 of the License, or (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ ** Lesser General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Lesser General Public
+ ** License along with this library; if not, write to the Free Software
+ ** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ ***************************************************************************************/
+
+
+#include <ReferencesIndex.h>
+
+#include <QAbstractItemModel>
+#include <QFutureWatcher>
+#include <QIcon>
+#include <QSharedPointer>
+
+#include <optional>
+
+/**
+ * @brief The RefTreeModel class shows the branches or the tags of the repository as a tree where every folder in the
+ * name of a reference is a node. The folders of a node are found by name in constant time.
+ *
+ * The tree is compared with a new snapshot of the references in the global thread pool and only the references that
+ * were added, removed or moved emit model signals, so the views keep their selection and their expanded folders. When
+ * most of the references changed the tree is built in the background and the model is reset instead.
+ */
+class RefTreeModel : public QAbstractItemModel
+{
+   Q_OBJECT
+
+signals:
+   /**
+    * @brief referencesUpdated Signal triggered every time the changes of a snapshot have been applied to the tree.
+    */
+   void referencesUpdated();
+
+public:
+   enum class Kind
+   {
+      LocalBranches,
+      RemoteBranches,
+      Tags
+   };
+
+   /**
+    * @brief Default constructor.
+    * @param kind The references shown by the model.
+    * @param parent The parent object if needed.
+    */
+   explicit RefTreeModel(Kind kind, QObject *parent = nullptr);
+
+   Kind kind() const { return mKind; }
+
+   /**
+    * @brief setReferences Updates the tree with the references of @p references. The differences are computed in the
+    * background: if there is an update in progress, the last snapshot received is applied when it finishes.
+    */
+   void setReferences(const ReferencesIndex &references);
+
+   /**
+    * @brief clear Removes all the references and discards the update in progress.
+    */
+   void clear();
+
+   /**
+    * @brief setCurrentBranch Marks the branch @p fullName as the current one.
+    */
+   void setCurrentBranch(const QString &fullName);
+
+   /**
+    * @brief setReferenceSha Changes the commit the reference @p fullName points to.
+    */
+   void setReferenceSha(const QString &fullName, const QString &sha);
+
+   /**
+    * @brief indexOf Returns the index of the reference @p fullName, or an invalid index if it's not in the tree.
+    */
+   QModelIndex indexOf(const QString &fullName) const;
+
+   QModelIndex index(int row, int column, const QModelIndex &parent = QModelIndex()) const override;
+   QModelIndex parent(const QModelIndex &index) const override;
+   int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+   int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+   QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+   QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+private:
+   struct Reference
+   {
+      QString sha;
+      QString label;
+      bool isLocal = false;
+      bool isDecorated = true;
+
+      bool operator==(const Reference &other) const
+      {
+         return sha == other.sha && label == other.label && isLocal == other.isLocal
+             && isDecorated == other.isDecorated;
+      }
+      bool operator!=(const Reference &other) const { return !(*this == other); }
+   };
+
+   // The references indexed by their full name
+   using Snapshot = QHash<QString, Reference>;
+
+   struct Node
+   {
+      ~Node() { qDeleteAll(children); }
+
+      Node *parent = nullptr;
+      int row = 0;
+      // The name of the folder or the full name of the reference
+      QString name;
+      bool isFolder = true;
+      Reference reference;
+      QVector<Node *> children;
+      QHash<QString, Node *> folders;
+   };
+
+   struct Changes
+   {
+      int generation = 0;
+      Snapshot references;
+      // Only set when the whole tree was rebuilt
+      QSharedPointer<Node> root;
+      QHash<QString, Node *> leaves;
+      QStringList removed;
+      QStringList added;
+      QStringList updated;
+   };
+
+   Kind mKind;
+   QSharedPointer<Node> mRoot;
+   QHash<QString, Node *> mLeaves;
+   Snapshot mReferences;
+   QString mCurrentBranch;
+   QIcon mReferenceIcon;
+   QIcon mRemoteIcon;
+   QFutureWatcher<Changes> mWatcher;
+   std::optional<ReferencesIndex> mPendingReferences;
+   int mGeneration = 0;
+
+   static Snapshot readReferences(Kind kind, const ReferencesIndex &references);
+   static Changes computeChanges(Kind kind, const ReferencesIndex &references, const Snapshot &current);
+   static QSharedPointer<Node> buildTree(const Snapshot &references, QHash<QString, Node *> &leaves);
+   static bool isBefore(const Node *first, const Node *second);
+
+   void applyChanges(const Changes &changes);
+   void insertReference(const QString &fullName, const Reference &reference);
+   void removeReference(const QString &fullName);
+   void insertNode(Node *parent, Node *node);
+   void removeNode(Node *node);
+   QModelIndex indexOfNode(Node *node) const;
+};
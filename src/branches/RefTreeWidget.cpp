@@ -4,55 +4,45 @@
 
 using namespace GitQlient;
 
-RefTreeWidget::RefTreeWidget(QWidget *parent)
-   : QTreeWidget(parent)
+RefTreeWidget::RefTreeWidget(RefTreeModel::Kind kind, QWidget *parent)
+   : QTreeView(parent)
+   , mModel(new RefTreeModel(kind, this))
 
 {
+   setModel(mModel);
    setContextMenuPolicy(Qt::CustomContextMenu);
    setAttribute(Qt::WA_DeleteOnClose);
+   setUniformRowHeights(true);
 }
 
 int RefTreeWidget::focusOnBranch(const QString &itemText, int startSearchPos)
 {
-   const auto items = findChildItem(itemText);
+   const auto indexes = findChildIndexes(itemText);
 
-   if (startSearchPos + 1 >= items.count())
+   if (startSearchPos + 1 >= indexes.count())
       return -1;
 
    if (startSearchPos != -1)
-   {
-      auto itemToUnselect = items.at(startSearchPos);
-      itemToUnselect->setSelected(false);
-   }
+      selectionModel()->select(indexes.at(startSearchPos), QItemSelectionModel::Deselect);
 
    ++startSearchPos;
 
-   auto itemToExpand = items.at(startSearchPos);
-   itemToExpand->setExpanded(true);
-   setCurrentItem(itemToExpand);
-   setCurrentIndex(indexFromItem(itemToExpand));
-
-   while (itemToExpand->parent())
-   {
-      itemToExpand->setExpanded(true);
-      itemToExpand = itemToExpand->parent();
-   }
-
-   itemToExpand->setExpanded(true);
+   focusOnIndex(indexes.at(startSearchPos));
 
    return startSearchPos;
 }
 
-QVector<QTreeWidgetItem *> RefTreeWidget::findChildItem(const QString &text) const
+QModelIndexList RefTreeWidget::findChildIndexes(const QString &text) const
 {
-   QModelIndexList indexes = model()->match(model()->index(0, 0, QModelIndex()), GitQlient::FullNameRole, text, -1,
-                                            Qt::MatchContains | Qt::MatchRecursive);
-   QVector<QTreeWidgetItem *> items;
-   const int indexesSize = indexes.size();
-   items.reserve(indexesSize);
+   return mModel->match(mModel->index(0, 0, QModelIndex()), GitQlient::FullNameRole, text, -1,
+                        Qt::MatchContains | Qt::MatchRecursive);
+}
 
-   for (int i = 0; i < indexesSize; ++i)
-      items.append(static_cast<QTreeWidgetItem *>(indexes.at(i).internalPointer()));
+void RefTreeWidget::focusOnIndex(const QModelIndex &index)
+{
+   for (auto parent = index.parent(); parent.isValid(); parent = parent.parent())
+      expand(parent);
 
-   return items;
+   setCurrentIndex(index);
+   scrollTo(index);
 }
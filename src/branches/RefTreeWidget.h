@@ -23,20 +23,27 @@
  ** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
  ***************************************************************************************/
 
-#include <QTreeWidget>
+#include <RefTreeModel.h>
 
-class RefTreeWidget : public QTreeWidget
+#include <QTreeView>
+
+class RefTreeWidget : public QTreeView
 {
    Q_OBJECT
 
 public:
    /**
     * @brief Default constructor
-    * @param cache The GitQlient cache.
-    * @param git The git object to perform Git operations.
-    * @param parentThe parent widget if needed.
+    * @param kind The references shown by the tree.
+    * @param parent The parent widget if needed.
+    */
+   explicit RefTreeWidget(RefTreeModel::Kind kind, QWidget *parent = nullptr);
+
+   /**
+    * @brief refModel Returns the model that stores the references of the tree.
     */
-   explicit RefTreeWidget(QWidget *parent = nullptr);
+   RefTreeModel *refModel() const { return mModel; }
+
    /**
     * @brief focusOnBranch Sets the focus of the three in the item specified in  @p branch starting from the position @p
     * lastPos.
@@ -47,5 +54,11 @@ public:
    int focusOnBranch(const QString &itemText, int startSearchPos = -1);
 
 protected:
-   QVector<QTreeWidgetItem *> findChildItem(const QString &text) const;
+   RefTreeModel *mModel = nullptr;
+
+   QModelIndexList findChildIndexes(const QString &text) const;
+   /**
+    * @brief focusOnIndex Expands the folders of @p index and makes it the current one.
+    */
+   void focusOnIndex(const QModelIndex &index);
 };
@@ -1,21 +1,36 @@
 INCLUDEPATH += $$PWD
 
 HEADERS += \
+    $$PWD/CommitGraphFile.h \
     $$PWD/CommitInfo.h \
+    $$PWD/CommitScanner.h \
+    $$PWD/CommitSearchIndex.h \
+    $$PWD/CommitStore.h \
     $$PWD/GitCache.h \
     $$PWD/GitServerCache.h \
     $$PWD/Lane.h \
     $$PWD/LaneType.h \
+    $$PWD/LanesLayout.h \
+    $$PWD/ObjectId.h \
     $$PWD/References.h \
+    $$PWD/ReferencesIndex.h \
+    $$PWD/RevisionCache.h \
     $$PWD/RevisionFiles.h \
     $$PWD/WipRevisionInfo.h \
     $$PWD/lanes.h
 
 SOURCES += \
+    $$PWD/CommitGraphFile.cpp \
     $$PWD/CommitInfo.cpp \
+    $$PWD/CommitScanner.cpp \
+    $$PWD/CommitSearchIndex.cpp \
+    $$PWD/CommitStore.cpp \
     $$PWD/GitCache.cpp \
     $$PWD/GitServerCache.cpp \
     $$PWD/Lane.cpp \
+    $$PWD/LanesLayout.cpp \
     $$PWD/References.cpp \
+    $$PWD/ReferencesIndex.cpp \
+    $$PWD/RevisionCache.cpp \
     $$PWD/RevisionFiles.cpp \
     $$PWD/lanes.cpp
@@ -0,0 +1,364 @@
+#include "CommitGraphFile.h"
+
+#include <LaneType.h>
+
+#include <QLogger.h>
+
+#include <QFile>
+#include <QSaveFile>
+
+#include <algorithm>
+#include <cstring>
+
+using namespace QLogger;
+
+namespace
+{
+// The file is written with the native byte order: a file written in a machine with a different one doesn't match the
+// magic number and it's rebuilt.
+const quint32 FILE_MAGIC = 0x47514347;
+const quint32 FILE_VERSION = 3;
+const char *FILE_NAME = "GitQlientHistory.cache";
+const int WRITE_BUFFER_SIZE = 1024 * 1024;
+
+bool isStored(const CommitInfo &commit)
+{
+   // The WIP commit is not part of the history
+   return commit.isValid() && commit.id() != CommitInfo::ZERO_ID;
+}
+
+template<typename T>
+void writeValue(QByteArray &buffer, T value)
+{
+   buffer.append(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+void writeId(QByteArray &buffer, const ObjectId &id)
+{
+   buffer.append(reinterpret_cast<const char *>(id.constData()), ObjectId::RAW_SIZE);
+}
+
+void writeBytes(QByteArray &buffer, const QByteArray &data)
+{
+   writeValue<quint32>(buffer, static_cast<quint32>(data.size()));
+   buffer.append(data);
+}
+
+void writeLanes(QByteArray &buffer, const QVector<Lane> &lanes)
+{
+   writeValue<quint16>(buffer, static_cast<quint16>(lanes.count()));
+
+   for (const auto &lane : lanes)
+      writeValue<quint8>(buffer, static_cast<quint8>(lane.getType()));
+}
+
+// The lanes are indexed directly when the graph is painted, so a checkpoint that doesn't fit the commits is rejected
+bool isValidCheckpoint(int row, const Lanes &lanes, int totalCommits)
+{
+   if (row < 1 || row > totalCommits || lanes.typeVec.count() != lanes.nextShaVec.count())
+      return false;
+
+   if (lanes.typeVec.isEmpty())
+      return lanes.activeLane == 0;
+
+   return lanes.activeLane >= 0 && lanes.activeLane < lanes.typeVec.count();
+}
+
+class Reader
+{
+public:
+   Reader(const uchar *data, qint64 size)
+      : mCurrent(data)
+      , mEnd(data + size)
+   {
+   }
+
+   bool isValid() const { return mValid; }
+
+   template<typename T>
+   T readValue()
+   {
+      T value {};
+
+      if (canRead(sizeof(T)))
+      {
+         memcpy(&value, mCurrent, sizeof(T));
+         mCurrent += sizeof(T);
+      }
+
+      return value;
+   }
+
+   ObjectId readId()
+   {
+      if (!canRead(ObjectId::RAW_SIZE))
+         return ObjectId();
+
+      const auto id = ObjectId::fromRawData(mCurrent);
+      mCurrent += ObjectId::RAW_SIZE;
+
+      return id;
+   }
+
+   QByteArray readBytes()
+   {
+      const auto size = readValue<quint32>();
+
+      if (!canRead(size))
+         return QByteArray();
+
+      const QByteArray data(reinterpret_cast<const char *>(mCurrent), static_cast<int>(size));
+      mCurrent += size;
+
+      return data;
+   }
+
+   QVector<Lane> readLanes()
+   {
+      const auto totalLanes = readValue<quint16>();
+      QVector<Lane> lanes;
+      lanes.reserve(totalLanes);
+
+      for (auto lane = 0; lane < totalLanes && mValid; ++lane)
+      {
+         const auto type = readValue<quint8>();
+
+         mValid = mValid && type < static_cast<quint8>(LaneType::LANE_TYPES_NUM);
+
+         if (mValid)
+            lanes.append(Lane(static_cast<LaneType>(type)));
+      }
+
+      return lanes;
+   }
+
+   QString readString()
+   {
+      const auto size = readValue<quint32>();
+
+      if (!canRead(size))
+         return QString();
+
+      const auto text = QString::fromUtf8(reinterpret_cast<const char *>(mCurrent), static_cast<int>(size));
+      mCurrent += size;
+
+      return text;
+   }
+
+private:
+   const uchar *mCurrent = nullptr;
+   const uchar *mEnd = nullptr;
+   bool mValid = true;
+
+   bool canRead(qint64 size)
+   {
+      mValid = mValid && mEnd - mCurrent >= size;
+
+      return mValid;
+   }
+};
+}
+
+CommitGraphFile::CommitGraphFile(const QString &gitDir)
+   : mFilePath(QString("%1/%2").arg(gitDir, QString::fromUtf8(FILE_NAME)))
+{
+}
+
+bool CommitGraphFile::load(const QString &logKey, Content &content) const
+{
+   QFile file(mFilePath);
+
+   if (!file.exists() || !file.open(QIODevice::ReadOnly))
+      return false;
+
+   const auto size = file.size();
+   const auto data = file.map(0, size);
+
+   if (!data)
+   {
+      QLog_Warning("Cache", QString("The history cache {%1} couldn't be mapped.").arg(mFilePath));
+      return false;
+   }
+
+   Reader reader(data, size);
+
+   if (reader.readValue<quint32>() != FILE_MAGIC || reader.readValue<quint32>() != FILE_VERSION
+       || reader.readString() != logKey)
+   {
+      QLog_Debug("Cache", QString("The history cache {%1} is outdated.").arg(mFilePath));
+      return false;
+   }
+
+   const auto totalTips = reader.readValue<quint32>();
+
+   content.tips.clear();
+   content.tips.reserve(static_cast<int>(qMin<quint32>(totalTips, size / ObjectId::RAW_SIZE)));
+
+   for (auto i = 0U; i < totalTips && reader.isValid(); ++i)
+      content.tips.append(reader.readId());
+
+   const auto totalCommits = reader.readValue<quint32>();
+
+   content.commits.clear();
+   content.commits.reserve(static_cast<int>(qMin<quint32>(totalCommits, size / ObjectId::RAW_SIZE)));
+
+   for (auto i = 0U; i < totalCommits && reader.isValid(); ++i)
+   {
+      CommitInfo commit;
+      commit.mSha = reader.readId();
+
+      const auto totalParents = reader.readValue<quint8>();
+      commit.mParents.reserve(totalParents);
+
+      for (auto parent = 0; parent < totalParents; ++parent)
+         commit.mParents.append(reader.readId());
+
+      commit.dateSinceEpoch = std::chrono::seconds(reader.readValue<qint64>());
+      commit.committer = reader.readString();
+      commit.author = reader.readString();
+      commit.shortLog = reader.readString();
+      commit.mLongLog = reader.readBytes();
+
+      content.commits.append(std::move(commit));
+   }
+
+   const auto totalCheckpoints = reader.readValue<quint32>();
+
+   content.lanesCheckpoints.clear();
+
+   auto validCheckpoints = true;
+
+   for (auto i = 0U; i < totalCheckpoints && reader.isValid() && validCheckpoints; ++i)
+   {
+      const auto row = reader.readValue<qint32>();
+
+      Lanes lanes;
+      lanes.activeLane = reader.readValue<qint32>();
+      lanes.typeVec = reader.readLanes();
+
+      const auto totalShas = reader.readValue<quint16>();
+      lanes.nextShaVec.reserve(totalShas);
+
+      for (auto lane = 0; lane < totalShas && reader.isValid(); ++lane)
+         lanes.nextShaVec.append(reader.readValue<quint8>() ? reader.readId() : ObjectId());
+
+      validCheckpoints = isValidCheckpoint(row, lanes, content.commits.count());
+
+      if (validCheckpoints)
+      {
+         lanes.indexLanes();
+
+         content.lanesCheckpoints.insert(row, lanes);
+      }
+   }
+
+   file.unmap(data);
+
+   if (!reader.isValid() || !validCheckpoints)
+   {
+      QLog_Warning("Cache", QString("The history cache {%1} is corrupted.").arg(mFilePath));
+
+      content.tips.clear();
+      content.commits.clear();
+      content.lanesCheckpoints.clear();
+
+      return false;
+   }
+
+   QLog_Debug("Cache", QString("Loaded {%1} commits from the history cache.").arg(content.commits.count()));
+
+   return true;
+}
+
+bool CommitGraphFile::save(const QString &logKey, const QVector<ObjectId> &tips, const CommitStore &commits,
+                           const QMap<int, Lanes> &lanesCheckpoints) const
+{
+   QSaveFile file(mFilePath);
+
+   if (!file.open(QIODevice::WriteOnly))
+   {
+      QLog_Warning("Cache", QString("The history cache {%1} couldn't be written.").arg(mFilePath));
+      return false;
+   }
+
+   QByteArray buffer;
+   buffer.reserve(WRITE_BUFFER_SIZE + WRITE_BUFFER_SIZE / 2);
+
+   writeValue<quint32>(buffer, FILE_MAGIC);
+   writeValue<quint32>(buffer, FILE_VERSION);
+   writeBytes(buffer, logKey.toUtf8());
+   writeValue<quint32>(buffer, static_cast<quint32>(tips.count()));
+
+   for (const auto &tip : tips)
+      writeId(buffer, tip);
+
+   auto totalCommits = 0;
+
+   for (const auto &block : commits.blocks())
+      totalCommits += static_cast<int>(std::count_if(block.cbegin(), block.cend(), isStored));
+
+   writeValue<quint32>(buffer, static_cast<quint32>(totalCommits));
+
+   for (auto row = 0; row < commits.count(); ++row)
+   {
+      const auto &commit = commits.at(row);
+
+      if (!isStored(commit))
+         continue;
+
+      writeId(buffer, commit.mSha);
+      writeValue<quint8>(buffer, static_cast<quint8>(commit.mParents.count()));
+
+      for (const auto &parent : commit.mParents)
+         writeId(buffer, parent);
+
+      writeValue<qint64>(buffer, commit.dateSinceEpoch.count());
+      writeBytes(buffer, commit.committer.toUtf8());
+      writeBytes(buffer, commit.author.toUtf8());
+      writeBytes(buffer, commit.shortLog.toUtf8());
+      writeBytes(buffer, commit.mLongLog);
+
+      if (buffer.size() >= WRITE_BUFFER_SIZE)
+      {
+         file.write(buffer);
+         buffer.resize(0);
+      }
+   }
+
+   writeValue<quint32>(buffer, static_cast<quint32>(lanesCheckpoints.count()));
+
+   for (auto iter = lanesCheckpoints.cbegin(); iter != lanesCheckpoints.cend(); ++iter)
+   {
+      const auto &lanes = iter.value();
+
+      writeValue<qint32>(buffer, iter.key());
+      writeValue<qint32>(buffer, lanes.activeLane);
+      writeLanes(buffer, lanes.typeVec);
+      writeValue<quint16>(buffer, static_cast<quint16>(lanes.nextShaVec.count()));
+
+      for (const auto &sha : lanes.nextShaVec)
+      {
+         writeValue<quint8>(buffer, sha.isNull() ? 0 : 1);
+
+         if (!sha.isNull())
+            writeId(buffer, sha);
+      }
+   }
+
+   file.write(buffer);
+
+   if (!file.commit())
+   {
+      QLog_Warning("Cache", QString("The history cache {%1} couldn't be written.").arg(mFilePath));
+      return false;
+   }
+
+   QLog_Debug("Cache", QString("Stored {%1} commits in the history cache.").arg(totalCommits));
+
+   return true;
+}
+
+void CommitGraphFile::remove() const
+{
+   QFile::remove(mFilePath);
+}
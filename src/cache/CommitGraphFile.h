@@ -0,0 +1,84 @@
+#pragma once
+
+/****************************************************************************************
+ ** GitQlient is an application to manage and operate one or several Git repositories. With
+ ** GitQlient you will be able to add commits, branches and manage all the options Git provides.
+ ** Copyright (C) 2021  Francesc Martinez
+ **
+ ** LinkedIn: www.linkedin.com/in/cescmm/
+ ** Web: www.francescmm.com
+ **
+ ** This program is free software; you can redistribute it and/or
+ ** modify it under the terms of the GNU Lesser General Public
+ ** License as published by the Free Software Foundation; either
+ ** version 2 of the License, or (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ ** Lesser General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Lesser General Public
+ ** License along with this library; if not, write to the Free Software
+ ** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ ***************************************************************************************/
+
+#include <CommitInfo.h>
+#include <CommitStore.h>
+#include <ObjectId.h>
+#include <lanes.h>
+
+#include <QMap>
+#include <QString>
+#include <QVector>
+
+/**
+ * @brief The CommitGraphFile class stores the parsed history of a repository, with the checkpoints of its lanes, in a
+ * binary file inside the Git directory. The file is tied to the arguments of the log it was built from and to the tips
+ * of the references that were used, so the loader can tell if it's still valid and what it has to ask Git for.
+ *
+ * The whole file is deserialized when it's read: it's mapped only to decode the commits and unmapped afterwards.
+ */
+class CommitGraphFile
+{
+public:
+   struct Content
+   {
+      QVector<ObjectId> tips;
+      QVector<CommitInfo> commits;
+      QMap<int, Lanes> lanesCheckpoints;
+   };
+
+   /**
+    * @brief Default constructor.
+    * @param gitDir The Git directory of the repository where the file is stored.
+    */
+   explicit CommitGraphFile(const QString &gitDir);
+
+   /**
+    * @brief load Reads the commits stored in the file.
+    * @param logKey The arguments of the log the commits must come from.
+    * @param content The commits and the tips they were built from.
+    * @return True if the file exists, it has the current version and it was built with the same @p logKey.
+    */
+   bool load(const QString &logKey, Content &content) const;
+
+   /**
+    * @brief save Replaces the file with the given commits.
+    * @param logKey The arguments of the log the commits come from.
+    * @param tips The tips of the references used to build the commits.
+    * @param commits The commits in the same order as the history graph.
+    * @param lanesCheckpoints The state of the lanes before some of the rows of the graph.
+    * @return True if the file was written.
+    */
+   bool save(const QString &logKey, const QVector<ObjectId> &tips, const CommitStore &commits,
+             const QMap<int, Lanes> &lanesCheckpoints) const;
+
+   /**
+    * @brief remove Deletes the file.
+    */
+   void remove() const;
+
+private:
+   QString mFilePath;
+};
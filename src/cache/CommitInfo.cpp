@@ -2,64 +2,137 @@
 
 #include <QStringList>
 
+#include <cstring>
+
 const QString CommitInfo::ZERO_SHA = QString("0000000000000000000000000000000000000000");
 const QString CommitInfo::INIT_SHA = QString("4b825dc642cb6eb9a060e54bf8d69288fbee4904");
+const ObjectId CommitInfo::ZERO_ID = ObjectId::fromHex("0000000000000000000000000000000000000000", ObjectId::HEX_SIZE);
+const ObjectId CommitInfo::INIT_ID = ObjectId::fromHex("4b825dc642cb6eb9a060e54bf8d69288fbee4904", ObjectId::HEX_SIZE);
+
+namespace
+{
+bool isSpace(char c)
+{
+   return c == ' ' || c == '\n' || c == '\t' || c == '\r';
+}
+}
 
 CommitInfo::CommitInfo(QByteArray commitData, const QString &gpg, bool goodSignature)
    : gpgKey(gpg)
    , mGoodSignature(goodSignature)
 {
-   parseDiff(commitData, 0);
+   parseDiff(commitData.constData(), commitData.size(), 0);
 }
 
 CommitInfo::CommitInfo(QByteArray data)
 {
-    parseDiff(data, 1);
+   parseDiff(data.constData(), data.size(), 1);
 }
 
-void CommitInfo::parseDiff(QByteArray &data, int startingField)
+CommitInfo::CommitInfo(const char *data, int size)
 {
-    if (const auto fields = QString::fromUtf8(data).split('\n'); fields.count() > 0)
-    {
-       const auto firstField = fields.constFirst();
-       auto combinedShas = fields.at(startingField++);
-       auto shas = combinedShas.split('X');
-       sha = shas.takeFirst().remove(0, 1);
+   parseDiff(data, size, 1);
+}
+
+void CommitInfo::parseDiff(const char *data, int size, int startingField)
+{
+   // The record is parsed in place: only the fields used by the views are decoded and the body of the commit is kept
+   // as raw data until it's requested.
+   const auto end = data + size;
+   auto lineStart = data;
+
+   const auto nextLine = [&lineStart, end]() {
+      const auto lineEnd = static_cast<const char *>(memchr(lineStart, '\n', end - lineStart));
+      const auto line = qMakePair(lineStart, lineEnd ? lineEnd : end);
+
+      lineStart = lineEnd ? lineEnd + 1 : end;
+
+      return line;
+   };
+
+   for (auto i = 0; i < startingField && lineStart < end; ++i)
+      nextLine();
+
+   if (lineStart >= end)
+      return;
+
+   const auto shasLine = nextLine();
+
+   if (shasLine.second - shasLine.first < 2)
+      return;
+
+   // Skip the boundary mark
+   const auto shaStart = shasLine.first + 1;
+   const auto shaEnd = static_cast<const char *>(memchr(shaStart, 'X', shasLine.second - shaStart));
+
+   if (!shaEnd)
+      return;
+
+   const auto sha = ObjectId::fromHex(shaStart, static_cast<int>(shaEnd - shaStart));
+
+   if (sha.isNull())
+      return;
+
+   for (auto parent = shaEnd + 1; parent < shasLine.second;)
+   {
+      auto parentEnd = static_cast<const char *>(memchr(parent, ' ', shasLine.second - parent));
 
-       if (!shas.isEmpty())
-       {
- #if QT_VERSION >= QT_VERSION_CHECK(5, 14, 0)
-          mParentsSha = shas.takeFirst().split(' ', Qt::SkipEmptyParts);
- #else
-          mParentsSha = shas.takeFirst().split(' ', QString::SkipEmptyParts);
- #endif
-       }
-       committer = fields.at(startingField++);
-       author = fields.at(startingField++);
-       dateSinceEpoch = std::chrono::seconds(fields.at(startingField++).toInt());
-       shortLog = fields.at(startingField);
+      if (!parentEnd)
+         parentEnd = shasLine.second;
 
-       for (auto i = 6; i < fields.count(); ++i)
-          longLog += fields.at(i) + '\n';
+      if (const auto id = ObjectId::fromHex(parent, static_cast<int>(parentEnd - parent)); !id.isNull())
+         mParents.append(id);
 
-       longLog = longLog.trimmed();
-    }
+      parent = parentEnd + 1;
+   }
+
+   if (lineStart >= end)
+      return;
+
+   const auto committerLine = nextLine();
+   const auto authorLine = nextLine();
+   const auto dateLine = nextLine();
+   const auto shortLogLine = nextLine();
+
+   mSha = sha;
+   committer = QString::fromUtf8(committerLine.first, static_cast<int>(committerLine.second - committerLine.first));
+   author = QString::fromUtf8(authorLine.first, static_cast<int>(authorLine.second - authorLine.first));
+   shortLog = QString::fromUtf8(shortLogLine.first, static_cast<int>(shortLogLine.second - shortLogLine.first));
+
+   qint64 secs = 0;
+
+   for (auto c = dateLine.first; c < dateLine.second && *c >= '0' && *c <= '9'; ++c)
+      secs = secs * 10 + (*c - '0');
+
+   dateSinceEpoch = std::chrono::seconds(secs);
+
+   auto bodyStart = lineStart;
+   auto bodyEnd = end;
+
+   while (bodyStart < bodyEnd && isSpace(*bodyStart))
+      ++bodyStart;
+
+   while (bodyEnd > bodyStart && (isSpace(*(bodyEnd - 1)) || *(bodyEnd - 1) == '\0'))
+      --bodyEnd;
+
+   if (bodyStart != bodyEnd)
+      mLongLog = QByteArray(bodyStart, static_cast<int>(bodyEnd - bodyStart));
 }
 
-CommitInfo::CommitInfo(const QString &sha, const QStringList &parents, std::chrono::seconds commitDate,
+CommitInfo::CommitInfo(const ObjectId &sha, const QVector<ObjectId> &parents, std::chrono::seconds commitDate,
                        const QString &log)
-   : sha(sha)
-   , dateSinceEpoch(commitDate)
+   : dateSinceEpoch(commitDate)
    , shortLog(log)
-   , mParentsSha(parents)
+   , mSha(sha)
+   , mParents(parents)
 {
 }
 
 bool CommitInfo::operator==(const CommitInfo &commit) const
 {
-   return sha.startsWith(commit.sha) && mParentsSha == commit.mParentsSha && committer == commit.committer
+   return mSha == commit.mSha && mParents == commit.mParents && committer == commit.committer
        && author == commit.author && dateSinceEpoch == commit.dateSinceEpoch && shortLog == commit.shortLog
-       && longLog == commit.longLog && mLanes == commit.mLanes;
+       && mLongLog == commit.mLongLog && mLanes == commit.mLanes;
 }
 
 bool CommitInfo::operator!=(const CommitInfo &commit) const
@@ -67,17 +140,17 @@ bool CommitInfo::operator!=(const CommitInfo &commit) const
    return !(*this == commit);
 }
 
-bool CommitInfo::contains(const QString &value)
+bool CommitInfo::contains(const QString &value) const
 {
-   return sha.startsWith(value, Qt::CaseInsensitive) || shortLog.contains(value, Qt::CaseInsensitive)
+   return mSha.startsWith(value) || shortLog.contains(value, Qt::CaseInsensitive)
        || committer.contains(value, Qt::CaseInsensitive) || author.contains(value, Qt::CaseInsensitive);
 }
 
 int CommitInfo::parentsCount() const
 {
-   auto count = mParentsSha.count();
+   auto count = mParents.count();
 
-   if (count > 0 && mParentsSha.contains(CommitInfo::INIT_SHA))
+   if (count > 0 && mParents.contains(CommitInfo::INIT_ID))
       --count;
 
    return count;
@@ -85,26 +158,24 @@ int CommitInfo::parentsCount() const
 
 QString CommitInfo::firstParent() const
 {
-   return !mParentsSha.isEmpty() ? mParentsSha.at(0) : QString();
+   return firstParentId().toString();
 }
 
 QStringList CommitInfo::parents() const
 {
-   return mParentsSha;
+   QStringList parents;
+   parents.reserve(mParents.count());
+
+   for (const auto &parent : mParents)
+      parents.append(parent.toString());
+
+   return parents;
 }
 
 bool CommitInfo::isInWorkingBranch() const
 {
-   for (const auto &child : mChilds)
-   {
-      if (child->sha == CommitInfo::ZERO_SHA)
-      {
-         return true;
-         break;
-      }
-   }
-
-   return false;
+   // The WIP commit is always stored in the first row of the cache
+   return mChilds.contains(0);
 }
 
 void CommitInfo::setLanes(QVector<Lane> lanes)
@@ -116,35 +187,21 @@ void CommitInfo::setLanes(QVector<Lane> lanes)
 
 bool CommitInfo::isValid() const
 {
-   static QRegExp hexMatcher("^[0-9A-F]{40}$", Qt::CaseInsensitive);
-
-   return !sha.isEmpty() && hexMatcher.exactMatch(sha);
+   return !mSha.isNull();
 }
 
-int CommitInfo::getActiveLane() const
+QString CommitInfo::longLog() const
 {
-   auto i = 0;
-
-   for (auto lane : mLanes)
-   {
-      if (lane.isActive())
-         return i;
-      else
-         ++i;
-   }
-
-   return -1;
+   return QString::fromUtf8(mLongLog);
 }
 
-void CommitInfo::removeChild(CommitInfo *commit)
+void CommitInfo::setLongLog(const QString &log)
 {
-   if (mChilds.contains(commit))
-      mChilds.removeAll(commit);
+   mLongLog = log.trimmed().toUtf8();
 }
 
-QString CommitInfo::getFirstChildSha() const
+
+void CommitInfo::removeChild(int row)
 {
-   if (!mChilds.isEmpty())
-      mChilds.constFirst();
-   return QString();
+   mChilds.removeAll(row);
 }
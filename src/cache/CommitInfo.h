@@ -30,6 +30,7 @@
 #include <chrono>
 
 #include <Lane.h>
+#include <ObjectId.h>
 #include <References.h>
 
 class CommitInfo
@@ -49,54 +50,66 @@ public:
    CommitInfo() = default;
    ~CommitInfo() = default;
    CommitInfo(QByteArray commitData);
+   CommitInfo(const char *data, int size);
    CommitInfo(QByteArray commitData, const QString &gpg, bool goodSignature);
-   explicit CommitInfo(const QString &sha, const QStringList &parents, std::chrono::seconds commitDate,
+   explicit CommitInfo(const ObjectId &sha, const QVector<ObjectId> &parents, std::chrono::seconds commitDate,
                        const QString &log);
    bool operator==(const CommitInfo &commit) const;
    bool operator!=(const CommitInfo &commit) const;
 
    bool isValid() const;
-   bool contains(const QString &value);
+   bool contains(const QString &value) const;
+
+   QString sha() const { return mSha.toString(); }
+   const ObjectId &id() const { return mSha; }
+   void setSha(const QString &sha) { mSha = ObjectId::fromString(sha); }
 
    int parentsCount() const;
    QString firstParent() const;
    QStringList parents() const;
+   ObjectId firstParentId() const { return mParents.isEmpty() ? ObjectId() : mParents.constFirst(); }
+   const QVector<ObjectId> &parentIds() const { return mParents; }
    bool isInWorkingBranch() const;
 
    void setLanes(QVector<Lane> lanes);
    QVector<Lane> lanes() const { return mLanes; }
-   int lanesCount() const { return mLanes.count(); }
-   Lane laneAt(int i) const { return mLanes.at(i); }
-   int getActiveLane() const;
 
-   void appendChild(CommitInfo *commit) { mChilds.append(commit); }
-   void removeChild(CommitInfo *commit);
+   void appendChild(int row) { mChilds.append(row); }
+   void removeChild(int row);
    bool hasChilds() const { return !mChilds.empty(); }
-   QString getFirstChildSha() const;
+   int getFirstChildRow() const { return mChilds.isEmpty() ? -1 : mChilds.constFirst(); }
    int getChildsCount() const { return mChilds.count(); }
 
+   QString longLog() const;
+   void setLongLog(const QString &log);
+
    bool isSigned() const { return !gpgKey.isEmpty(); }
    bool verifiedSignature() const { return mGoodSignature && !gpgKey.isEmpty(); }
 
    static const QString ZERO_SHA;
    static const QString INIT_SHA;
+   static const ObjectId ZERO_ID;
+   static const ObjectId INIT_ID;
 
    uint pos = 0;
-   QString sha;
    QString committer;
    QString author;
    std::chrono::seconds dateSinceEpoch;
    QString shortLog;
-   QString longLog;
    QString gpgKey;
 
 private:
    bool mGoodSignature = false;
+   ObjectId mSha;
    QVector<Lane> mLanes;
-   QStringList mParentsSha;
-   QVector<CommitInfo *> mChilds;
+   QVector<ObjectId> mParents;
+   QVector<int> mChilds;
+   QByteArray mLongLog;
 
    friend class GitCache;
+   friend class CommitGraphFile;
 
-   void parseDiff(QByteArray &data, int startingField);
+   void parseDiff(const char *data, int size, int startingField);
 };
+
+Q_DECLARE_TYPEINFO(CommitInfo, Q_MOVABLE_TYPE);
@@ -0,0 +1,154 @@
+#include "CommitScanner.h"
+
+#include <QtConcurrent>
+
+#include <functional>
+
+namespace
+{
+// Small enough to cancel quickly and to report the first matches soon, big enough to keep all the cores busy
+const int CHUNK_SIZE = 4096;
+
+bool containsText(const CommitInfo &commit, const QString &text)
+{
+   return commit.contains(text) || commit.longLog().contains(text, Qt::CaseInsensitive);
+}
+
+bool matchesExpression(const CommitInfo &commit, const QRegularExpression &regExp)
+{
+   return regExp.match(commit.shortLog).hasMatch() || regExp.match(commit.author).hasMatch()
+       || regExp.match(commit.committer).hasMatch() || regExp.match(commit.longLog()).hasMatch()
+       || regExp.match(commit.sha()).hasMatch();
+}
+}
+
+CommitScanner::CommitScanner(QObject *parent)
+   : QObject(parent)
+{
+   connect(&mWatcher, &QFutureWatcher<QVector<int>>::resultsReadyAt, this, &CommitScanner::reportMatches);
+   connect(&mWatcher, &QFutureWatcher<QVector<int>>::finished, this, &CommitScanner::onFinished);
+}
+
+CommitScanner::~CommitScanner()
+{
+   cancel();
+}
+
+bool CommitScanner::start(const CommitStore &commits, const QString &text, bool isRegularExpression)
+{
+   cancel();
+
+   QRegularExpression regExp;
+
+   if (isRegularExpression)
+   {
+      regExp = QRegularExpression(text, QRegularExpression::CaseInsensitiveOption);
+
+      if (!regExp.isValid())
+         return false;
+
+      // Compiled here so the threads don't compete to do it
+      regExp.optimize();
+   }
+
+   mActive = true;
+   mText = text;
+   mRegExp = regExp;
+   mIsRegularExpression = isRegularExpression;
+
+   // The first row is the WIP
+   scan(commits, 1);
+
+   return true;
+}
+
+void CommitScanner::scanAppended(const CommitStore &commits)
+{
+   if (!mActive)
+      return;
+
+   if (mWatcher.isRunning())
+      mPendingCommits = commits;
+   else if (commits.count() > mScannedRows)
+      scan(commits, mScannedRows);
+}
+
+void CommitScanner::scan(const CommitStore &commits, int firstRow)
+{
+   QVector<QPair<int, int>> chunks;
+
+   for (auto row = firstRow; row < commits.count(); row += CHUNK_SIZE)
+      chunks.append(qMakePair(row, qMin(row + CHUNK_SIZE, commits.count())));
+
+   std::function<QVector<int>(const QPair<int, int> &)> scanChunk
+       = [commits, text = mText, regExp = mRegExp, isRegularExpression = mIsRegularExpression](
+             const QPair<int, int> &chunk) {
+            QVector<int> rows;
+
+            for (auto row = chunk.first; row < chunk.second; ++row)
+            {
+               const auto &commit = commits.at(row);
+
+               if (isRegularExpression ? matchesExpression(commit, regExp) : containsText(commit, text))
+                  rows.append(row);
+            }
+
+            return rows;
+         };
+
+   mNextChunk = 0;
+   mScannedRows = qMax(commits.count(), firstRow);
+   mWatcher.setFuture(QtConcurrent::mapped(chunks, scanChunk));
+}
+
+void CommitScanner::cancel()
+{
+   if (mWatcher.isRunning())
+   {
+      mWatcher.cancel();
+      mWatcher.waitForFinished();
+   }
+
+   mNextChunk = 0;
+   mActive = false;
+   mPendingCommits.clear();
+}
+
+void CommitScanner::onFinished()
+{
+   if (mWatcher.isCanceled())
+      return;
+
+   reportMatches();
+
+   // The commits appended while scanning go on before the scan is reported as finished
+   if (mPendingCommits.count() > mScannedRows)
+   {
+      const auto commits = std::move(mPendingCommits);
+
+      mPendingCommits.clear();
+      scan(commits, mScannedRows);
+   }
+   else
+   {
+      mPendingCommits.clear();
+
+      emit finished();
+   }
+}
+
+void CommitScanner::reportMatches()
+{
+   if (mWatcher.isCanceled())
+      return;
+
+   // The chunks can finish in any order but the matches are reported in the order of the graph
+   QVector<int> rows;
+   const auto future = mWatcher.future();
+
+   while (future.isResultReadyAt(mNextChunk))
+      rows.append(future.resultAt(mNextChunk++));
+
+   if (!rows.isEmpty())
+      emit matchesFound(rows);
+}
@@ -0,0 +1,103 @@
+#pragma once
+
+/****************************************************************************************
+ ** GitQlient is an application to manage and operate one or several Git repositories. With
+ ** GitQlient you will be able to add commits, branches and manage all the options Git provides.
+ ** Copyright (C) 2021  Francesc Martinez
+ **
+ ** LinkedIn: www.linkedin.com/in/cescmm/
+ ** Web: www.francescmm.com
+ **
+ ** This program is free software; you can redistribute it and/or
+ ** modify it under the terms of the GNU Lesser General Public
+ ** License as published by the Free Software Foundation; either
+ ** version 2 of the License, or (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ ** Lesser General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Lesser General Public
+ ** License along with this library; if not, write to the Free Software
+ ** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ ***************************************************************************************/
+
+#include <CommitInfo.h>
+#include <CommitStore.h>
+
+#include <QFutureWatcher>
+#include <QObject>
+#include <QRegularExpression>
+#include <QVector>
+
+/**
+ * @brief The CommitScanner class searches a text or a regular expression in the commits of the history when the
+ * search index can't answer the query. The commits are split in chunks that are scanned in parallel in the global
+ * thread pool and the matches are reported as soon as they are found, in the same order as the graph.
+ *
+ * Starting a new scan cancels the previous one. The commits appended to the history while it runs can be added to it,
+ * so a search started while the history is loading also finds them.
+ */
+class CommitScanner : public QObject
+{
+   Q_OBJECT
+
+signals:
+   /**
+    * @brief matchesFound Signal triggered every time a new consecutive group of chunks has been scanned.
+    * @param rows The rows of the commits that matched, in the order of the graph.
+    */
+   void matchesFound(const QVector<int> &rows);
+
+   /**
+    * @brief finished Signal triggered when all the commits have been scanned. It's not triggered if the scan is
+    * cancelled.
+    */
+   void finished();
+
+public:
+   explicit CommitScanner(QObject *parent = nullptr);
+   ~CommitScanner() override;
+
+   /**
+    * @brief start Starts scanning @p commits in the background.
+    * @param commits The commits in the same order as the rows of the graph.
+    * @param text The text to search, case insensitive.
+    * @param isRegularExpression Tells if @p text is a regular expression instead of a plain text.
+    * @return False if @p text is not a valid regular expression.
+    */
+   bool start(const CommitStore &commits, const QString &text, bool isRegularExpression);
+
+   /**
+    * @brief scanAppended Scans the commits appended since the current scan started, after the ones it's scanning. It
+    * does nothing if no scan was started or if it was cancelled.
+    * @param commits The commits of the history, starting with the ones that were already scanned.
+    */
+   void scanAppended(const CommitStore &commits);
+
+   /**
+    * @brief cancel Stops the current scan. The matches that were not reported yet are discarded.
+    */
+   void cancel();
+
+   /**
+    * @brief isRunning Tells if there is a scan in progress.
+    */
+   bool isRunning() const { return mWatcher.isRunning(); }
+
+private:
+   QFutureWatcher<QVector<int>> mWatcher;
+   int mNextChunk = 0;
+   bool mActive = false;
+   QString mText;
+   QRegularExpression mRegExp;
+   bool mIsRegularExpression = false;
+   // The rows after the last one scanned wait for the running scan to finish
+   int mScannedRows = 0;
+   CommitStore mPendingCommits;
+
+   void scan(const CommitStore &commits, int firstRow);
+   void onFinished();
+   void reportMatches();
+};
@@ -0,0 +1,113 @@
+#include "CommitSearchIndex.h"
+
+#include <algorithm>
+
+void CommitSearchIndex::clear()
+{
+   mCommits.clear();
+   mCommits.squeeze();
+   mPostings.clear();
+   mPostings.squeeze();
+}
+
+void CommitSearchIndex::addCommits(const QVector<CommitInfo> &commits)
+{
+   QVector<quint64> trigrams;
+
+   for (const auto &commit : commits)
+   {
+      if (!commit.isValid() || commit.id() == CommitInfo::ZERO_ID)
+         continue;
+
+      trigrams.clear();
+
+      addTrigrams(commit.shortLog, trigrams);
+      addTrigrams(commit.longLog(), trigrams);
+      addTrigrams(commit.author, trigrams);
+      addTrigrams(commit.committer, trigrams);
+
+      std::sort(trigrams.begin(), trigrams.end());
+      trigrams.erase(std::unique(trigrams.begin(), trigrams.end()), trigrams.end());
+
+      // The commits are always appended so the postings stay sorted
+      const auto document = mCommits.count();
+      mCommits.append(commit.id());
+
+      for (const auto trigram : qAsConst(trigrams))
+         mPostings[trigram].append(document);
+   }
+}
+
+QVector<ObjectId> CommitSearchIndex::candidates(const QString &text) const
+{
+   QVector<quint64> trigrams;
+   addTrigrams(text, trigrams);
+
+   std::sort(trigrams.begin(), trigrams.end());
+   trigrams.erase(std::unique(trigrams.begin(), trigrams.end()), trigrams.end());
+
+   QVector<const QVector<int> *> postings;
+   postings.reserve(trigrams.count());
+
+   for (const auto trigram : qAsConst(trigrams))
+   {
+      const auto iter = mPostings.constFind(trigram);
+
+      if (iter == mPostings.cend())
+         return {};
+
+      postings.append(&iter.value());
+   }
+
+   if (postings.isEmpty())
+      return {};
+
+   // Intersecting from the shortest list keeps the intermediate results small
+   std::sort(postings.begin(), postings.end(),
+             [](const QVector<int> *first, const QVector<int> *second) { return first->count() < second->count(); });
+
+   auto documents = *postings.constFirst();
+   QVector<int> intersection;
+
+   for (auto i = 1; i < postings.count() && !documents.isEmpty(); ++i)
+   {
+      intersection.clear();
+      std::set_intersection(documents.cbegin(), documents.cend(), postings.at(i)->cbegin(), postings.at(i)->cend(),
+                            std::back_inserter(intersection));
+      std::swap(documents, intersection);
+   }
+
+   QVector<ObjectId> commits;
+   commits.reserve(documents.count());
+
+   for (const auto document : qAsConst(documents))
+      commits.append(mCommits.at(document));
+
+   return commits;
+}
+
+int CommitSearchIndex::matchRank(const CommitInfo &commit, const QString &text)
+{
+   if (commit.id().startsWith(text) || commit.shortLog.contains(text, Qt::CaseInsensitive))
+      return 0;
+
+   if (commit.author.contains(text, Qt::CaseInsensitive) || commit.committer.contains(text, Qt::CaseInsensitive))
+      return 1;
+
+   if (commit.longLog().contains(text, Qt::CaseInsensitive))
+      return 2;
+
+   return -1;
+}
+
+void CommitSearchIndex::addTrigrams(const QString &text, QVector<quint64> &trigrams)
+{
+   const auto folded = text.toCaseFolded();
+   const auto data = folded.utf16();
+
+   for (auto i = 0; i + TRIGRAM_SIZE <= folded.length(); ++i)
+   {
+      trigrams.append(static_cast<quint64>(data[i]) << 32 | static_cast<quint64>(data[i + 1]) << 16
+                      | static_cast<quint64>(data[i + 2]));
+   }
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+/****************************************************************************************
+ ** GitQlient is an application to manage and operate one or several Git repositories. With
+ ** GitQlient you will be able to add commits, branches and manage all the options Git provides.
+ ** Copyright (C) 2021  Francesc Martinez
+ **
+ ** LinkedIn: www.linkedin.com/in/cescmm/
+ ** Web: www.francescmm.com
+ **
+ ** This program is free software; you can redistribute it and/or
+ ** modify it under the terms of the GNU Lesser General Public
+ ** License as published by the Free Software Foundation; either
+ ** version 2 of the License, or (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ ** Lesser General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Lesser General Public
+ ** License along with this library; if not, write to the Free Software
+ ** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ ***************************************************************************************/
+
+#include <CommitInfo.h>
+#include <ObjectId.h>
+
+#include <QHash>
+#include <QVector>
+
+/**
+ * @brief The CommitSearchIndex class is an inverted index of the trigrams of the text of the commits: the short log,
+ * the long log, the author and the committer. A search only verifies the commits that contain all the trigrams of the
+ * text instead of all the commits of the history.
+ *
+ * The commits are identified by their SHA so the index stays valid when rows are added to the graph. The index is
+ * case insensitive and it can only answer searches of at least three characters.
+ */
+class CommitSearchIndex
+{
+public:
+   /**
+    * @brief isEmpty Tells if the index has any commit.
+    */
+   bool isEmpty() const { return mCommits.isEmpty(); }
+
+   /**
+    * @brief clear Removes all the commits from the index.
+    */
+   void clear();
+
+   /**
+    * @brief addCommits Adds the trigrams of @p commits to the index. The WIP and the invalid commits are ignored.
+    */
+   void addCommits(const QVector<CommitInfo> &commits);
+
+   /**
+    * @brief canSearch Tells if @p text is long enough to be searched in the index.
+    */
+   static bool canSearch(const QString &text) { return text.length() >= TRIGRAM_SIZE; }
+
+   /**
+    * @brief candidates Returns the commits that contain all the trigrams of @p text. The candidates still have to be
+    * verified since the trigrams can be in different parts of the text.
+    */
+   QVector<ObjectId> candidates(const QString &text) const;
+
+   /**
+    * @brief matchRank Ranks how well @p commit matches @p text: the SHA and the title first, then the author and the
+    * committer and finally the description.
+    * @return The rank of the match, lower is better, or -1 if the commit doesn't contain @p text.
+    */
+   static int matchRank(const CommitInfo &commit, const QString &text);
+
+private:
+   static constexpr int TRIGRAM_SIZE = 3;
+
+   QVector<ObjectId> mCommits;
+   QHash<quint64, QVector<int>> mPostings;
+
+   static void addTrigrams(const QString &text, QVector<quint64> &trigrams);
+};
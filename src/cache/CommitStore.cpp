@@ -0,0 +1,125 @@
+#include "CommitStore.h"
+
+void CommitStore::append(CommitInfo commit)
+{
+   if (mBlocks.isEmpty() || isLastBlockFull())
+   {
+      mBlocks.append(QVector<CommitInfo>());
+      mBlocks.last().reserve(BLOCK_SIZE);
+   }
+
+   mBlocks.last().append(std::move(commit));
+   ++mCount;
+}
+
+void CommitStore::prepend(QVector<CommitInfo> commits)
+{
+   auto remaining = commits.count();
+
+   while (remaining > 0)
+   {
+      if (mFront == 0)
+      {
+         mBlocks.prepend(QVector<CommitInfo>());
+         mFront = BLOCK_SIZE;
+      }
+
+      // The last commits are the first ones to go in front of the block
+      const auto total = qMin(remaining, mFront);
+      auto &block = mBlocks.first();
+
+      block.insert(0, total, CommitInfo());
+
+      for (auto i = 0; i < total; ++i)
+         block[i] = std::move(commits[remaining - total + i]);
+
+      remaining -= total;
+      mFront -= total;
+      mCount += total;
+   }
+}
+
+void CommitStore::removeFirst()
+{
+   if (mCount == 0)
+      return;
+
+   if (mCount == 1)
+   {
+      clear();
+      return;
+   }
+
+   auto &block = mBlocks.first();
+   block.removeFirst();
+
+   ++mFront;
+   --mCount;
+
+   if (block.isEmpty())
+   {
+      mBlocks.removeFirst();
+      mFront = 0;
+   }
+}
+
+void CommitStore::resize(int total)
+{
+   if (total >= mCount)
+   {
+      while (mCount < total)
+         append(CommitInfo());
+
+      return;
+   }
+
+   if (total <= 0)
+   {
+      clear();
+      return;
+   }
+
+   const auto end = total + mFront;
+   const auto totalBlocks = (end + BLOCK_SIZE - 1) >> BLOCK_SHIFT;
+
+   mBlocks.resize(totalBlocks);
+   mBlocks.last().resize(end - ((totalBlocks - 1) << BLOCK_SHIFT) - (totalBlocks == 1 ? mFront : 0));
+
+   mCount = total;
+}
+
+void CommitStore::reserve(int total)
+{
+   mBlocks.reserve((total + mFront + BLOCK_SIZE - 1) >> BLOCK_SHIFT);
+}
+
+void CommitStore::squeeze()
+{
+   mBlocks.squeeze();
+
+   if (!mBlocks.isEmpty())
+      mBlocks.last().squeeze();
+}
+
+void CommitStore::clear()
+{
+   mBlocks.clear();
+   mCount = 0;
+   mFront = 0;
+}
+
+QVector<CommitInfo> CommitStore::mid(int row, int total) const
+{
+   QVector<CommitInfo> commits;
+   commits.reserve(qMax(0, total));
+
+   for (auto i = row; i < row + total && i < mCount; ++i)
+      commits.append(at(i));
+
+   return commits;
+}
+
+bool CommitStore::isLastBlockFull() const
+{
+   return mBlocks.constLast().count() + (mBlocks.count() == 1 ? mFront : 0) == BLOCK_SIZE;
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+/****************************************************************************************
+ ** GitQlient is an application to manage and operate one or several Git repositories. With
+ ** GitQlient you will be able to add commits, branches and manage all the options Git provides.
+ ** Copyright (C) 2021  Francesc Martinez
+ **
+ ** LinkedIn: www.linkedin.com/in/cescmm/
+ ** Web: www.francescmm.com
+ **
+ ** This program is free software; you can redistribute it and/or
+ ** modify it under the terms of the GNU Lesser General Public
+ ** License as published by the Free Software Foundation; either
+ ** version 2 of the License, or (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ ** Lesser General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Lesser General Public
+ ** License along with this library; if not, write to the Free Software
+ ** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ ***************************************************************************************/
+
+
+#include <CommitInfo.h>
+
+
+/**
+ * @brief The CommitStore class stores the commits of the history in blocks of a fixed size. The blocks are implicitly
+ * shared, so a copy of the store only copies the list of blocks. When the history grows, only the first or the last
+ * block is written: the copies taken before keep the blocks they share and the store only detaches the block it
+ * writes, so adding commits doesn't copy the whole history while a snapshot is alive.
+ *
+ * The first block may not be full, so commits can be added in front of the history without moving the rest.
+ */
+class CommitStore
+{
+public:
+   int count() const { return mCount; }
+   bool isEmpty() const { return mCount == 0; }
+
+   const CommitInfo &at(int row) const
+   {
+      const auto index = row + mFront;
+      const auto block = index >> BLOCK_SHIFT;
+
+      return mBlocks.at(block).at((index & BLOCK_MASK) - (block == 0 ? mFront : 0));
+   }
+   /**
+    * @brief operator [] Returns the commit of @p row to modify it. Only its block is detached.
+    */
+   CommitInfo &operator[](int row)
+   {
+      const auto index = row + mFront;
+      const auto block = index >> BLOCK_SHIFT;
+
+      return mBlocks[block][(index & BLOCK_MASK) - (block == 0 ? mFront : 0)];
+   }
+
+   /**
+    * @brief blocks Returns the commits in the same order as the rows, one block after the other.
+    */
+   const QVector<QVector<CommitInfo>> &blocks() const { return mBlocks; }
+
+   void append(CommitInfo commit);
+   /**
+    * @brief prepend Adds @p commits in front of the first row. Only the first block is written, the new commits that
+    * don't fit in it go to new blocks.
+    */
+   void prepend(QVector<CommitInfo> commits);
+   void removeFirst();
+   void resize(int total);
+   void reserve(int total);
+   void squeeze();
+   void clear();
+
+   QVector<CommitInfo> mid(int row, int total) const;
+
+private:
+   static constexpr int BLOCK_SHIFT = 12;
+   static constexpr int BLOCK_SIZE = 1 << BLOCK_SHIFT;
+   static constexpr int BLOCK_MASK = BLOCK_SIZE - 1;
+
+   QVector<QVector<CommitInfo>> mBlocks;
+   int mCount = 0;
+   // Free slots before the first commit in the first block
+   int mFront = 0;
+
+   bool isLastBlockFull() const;
+};
@@ -1,20 +1,47 @@
 #include "GitCache.h"
 
+#include <LanesLayout.h>
 #include <QLogger.h>
 #include <WipRevisionInfo.h>
 
+#include <QtConcurrent>
+
 using namespace QLogger;
 
+static const int LANES_CHECKPOINT_INTERVAL = 1000;
+// Bytes used by the files and the diffs of the commits that were shown
+static const int REVISIONS_MAX_COST = 64 * 1024 * 1024;
+// Part of the budget of the revisions that is kept when memory is released
+static const int REVISIONS_RELEASED_COST = REVISIONS_MAX_COST / 4;
+
+static bool isLanesCheckpoint(int row)
+{
+   // The first row after the WIP always has a checkpoint so the whole graph can be calculated from them
+   return row == 1 || row % LANES_CHECKPOINT_INTERVAL == 0;
+}
+
 GitCache::GitCache(QObject *parent)
    : QObject(parent)
    , mCommitsMutex(QMutex::Recursive)
    , mRevisionsMutex(QMutex::Recursive)
+   , mRevisionCache(REVISIONS_MAX_COST)
    , mReferencesMutex(QMutex::Recursive)
 {
 }
 
 GitCache::~GitCache()
 {
+   mSearchIndexBuild.waitForFinished();
+
+   const auto stats = mRevisionCache.stats();
+
+   QLog_Info("Cache",
+             QString("Revisions cache: {%1} hits, {%2} misses, {%3} entries using {%4} bytes.")
+                 .arg(stats.hits)
+                 .arg(stats.misses)
+                 .arg(stats.entries)
+                 .arg(stats.cost));
+
    clearInternalData();
 }
 
@@ -22,9 +49,18 @@ void GitCache::setup(const QString &parentSha, const RevisionFiles &files, QVect
 {
    QMutexLocker lock(&mCommitsMutex);
 
+   startSetup(parentSha, files, commits.count());
+   appendCommits(std::move(commits));
+   finishSetup();
+}
+
+void GitCache::startSetup(const QString &parentSha, const RevisionFiles &files, int expectedCommits)
+{
+   QMutexLocker lock(&mCommitsMutex);
+
    mInitialized = true;
 
-   const auto totalCommits = commits.count() + 1;
+   const auto totalCommits = expectedCommits + 1;
 
    QLog_Debug("Cache", QString("Configuring the cache for {%1} elements.").arg(totalCommits));
 
@@ -32,145 +68,446 @@ void GitCache::setup(const QString &parentSha, const RevisionFiles &files, QVect
 
    mCommits.clear();
    mCommits.squeeze();
-   mCommitsMap.clear();
-   mCommitsMap.squeeze();
+   mWipCommit = CommitInfo();
+   mCommitsIndex.clear();
+   mCommitsIndex.squeeze();
+   mPendingChilds.clear();
+   mPendingChilds.squeeze();
+   mRowsOnTop = 0;
+   mShaIndex.clear();
+   mShaIndex.squeeze();
    mUntrackedFiles.clear();
    mUntrackedFiles.squeeze();
    mLanes.clear();
+   mLanesCheckpoints.clear();
 
-   mCommitsMap.reserve(totalCommits);
-   mCommits.resize(totalCommits);
+   resetSearchIndex();
+
+   mCommitsIndex.reserve(totalCommits);
+   mCommits.reserve(totalCommits);
+   mCommits.resize(1);
+   mShaIndex.reserve(totalCommits);
 
    QLog_Debug("Cache", QString("Adding WIP revision."));
 
-   insertWipRevision(parentSha, files);
+   insertWipRevision(ObjectId::fromString(parentSha), files);
+
+   mShaIndex.append(CommitInfo::ZERO_ID);
+   mShaIndexSorted = true;
+}
+
+void GitCache::appendCommits(QVector<CommitInfo> commits)
+{
+   QMutexLocker lock(&mCommitsMutex);
+
+   QLog_Debug("Cache", QString("Adding {%1} committed revisions.").arg(commits.count()));
+
+   storeCommits(commits, true);
+}
+
+void GitCache::restoreCommits(QVector<CommitInfo> commits, QMap<int, Lanes> lanesCheckpoints)
+{
+   QMutexLocker lock(&mCommitsMutex);
+
+   QLog_Debug("Cache", QString("Restoring {%1} committed revisions.").arg(commits.count()));
+
+   storeCommits(commits, false);
+
+   mLanesCheckpoints = std::move(lanesCheckpoints);
+}
+
+int GitCache::prependCommits(QVector<CommitInfo> commits, const QString &wipParentSha, const RevisionFiles &wipFiles)
+{
+   QMutexLocker lock(&mRevisionsMutex);
+   QMutexLocker lock2(&mCommitsMutex);
+
+   commits.erase(std::remove_if(commits.begin(), commits.end(),
+                                [this](const CommitInfo &commit) { return mCommitsIndex.contains(commit.id()); }),
+                 commits.end());
+
+   const auto total = commits.count();
+
+   QLog_Debug("Cache", QString("Adding {%1} new revisions on top of the history.").arg(total));
+
+   // The key of the WIP changes with the rows on top
+   if (const auto oldWipParent = rowOf(mWipCommit.firstParentId()); oldWipParent > 0)
+      mCommits[oldWipParent].removeChild(keyOfRow(0));
+
+   shiftRows(total);
+
+   // The lanes are calculated from the top: first the WIP, then the new commits
+   mLanes.clear();
+   mWipCommit = CommitInfo();
+   insertWipRevision(ObjectId::fromString(wipParentSha), wipFiles);
+
+   auto row = 1;
+
+   for (auto &commit : commits)
+   {
+      if (isLanesCheckpoint(row))
+         mLanesCheckpoints.insert(row, mLanes);
+
+      LanesLayout::calculateLanes(mLanes, commit);
+
+      commit.pos = keyOfRow(row);
+      commit.mChilds.clear();
+
+      mCommitsIndex.insert(commit.id(), keyOfRow(row));
+      mShaIndex.append(commit.id());
+
+      ++row;
+   }
+
+   // The new commits go between the placeholder of the WIP and the stored commits, the stored commits don't move
+   commits.prepend(CommitInfo());
+   mCommits.removeFirst();
+   mCommits.prepend(std::move(commits));
+
+   QVector<int> updatedParents;
+
+   for (auto child = 1; child <= total; ++child)
+   {
+      for (const auto &parent : qAsConst(mCommits.at(child).mParents))
+      {
+         if (const auto parentRow = rowOf(parent); parentRow > 0)
+         {
+            mCommits[parentRow].appendChild(keyOfRow(child));
+            updatedParents.append(parentRow);
+         }
+      }
+   }
+
+   if (const auto wipParent = rowOf(mWipCommit.firstParentId()); wipParent > 0)
+   {
+      mCommits[wipParent].appendChild(keyOfRow(0));
+      updatedParents.append(wipParent);
+   }
+
+   for (const auto parentRow : qAsConst(updatedParents))
+   {
+      auto &childs = mCommits[parentRow].mChilds;
+      std::sort(childs.begin(), childs.end());
+   }
+
+   // The stored commits only need new lanes until the lanes converge with the state they had before
+   auto lastUpdatedRow = total;
+   const auto totalRows = mCommits.count();
+
+   for (; row < totalRows; ++row)
+   {
+      if (const auto checkpoint = mLanesCheckpoints.find(row); checkpoint != mLanesCheckpoints.end())
+      {
+         if (*checkpoint == mLanes)
+            break;
+
+         *checkpoint = mLanes;
+      }
+
+      LanesLayout::calculateLanes(mLanes, mCommits.at(row));
+      lastUpdatedRow = row;
+   }
+
+   if (total > 0)
+   {
+      // Only the new SHAs are sorted, then they're merged with the ones that were already sorted
+      const auto sorted = mShaIndexSorted;
+      const auto newShas = mShaIndex.begin() + (mShaIndex.count() - total);
+
+      std::sort(newShas, mShaIndex.end());
+
+      if (sorted)
+         std::inplace_merge(mShaIndex.begin(), newShas, mShaIndex.end());
+      else
+         std::sort(mShaIndex.begin(), mShaIndex.end());
+
+      mShaIndexSorted = true;
 
-   QLog_Debug("Cache", QString("Adding committed revisions."));
+      addToSearchIndex(mCommits.mid(1, total));
+   }
+
+   QLog_Debug("Cache", QString("The lanes were calculated again until the row {%1}.").arg(lastUpdatedRow));
+
+   return lastUpdatedRow;
+}
+
+QMap<int, Lanes> GitCache::lanesCheckpoints() const
+{
+   QMutexLocker lock(&mCommitsMutex);
 
-   QHash<QString, QVector<CommitInfo *>> tmpChildsStorage;
-   auto count = 0;
+   return mLanesCheckpoints;
+}
+
+void GitCache::storeCommits(QVector<CommitInfo> &commits, bool computeLanes)
+{
+   const auto wipParentSha = mWipCommit.firstParentId();
 
    for (auto &commit : commits)
    {
-      calculateLanes(commit);
+      const auto sha = commit.id();
+      const auto row = mCommits.count();
 
-      const auto sha = commit.sha;
+      // A commit that is already stored comes from a history that overlaps with the one in the cache
+      if (mCommitsIndex.contains(sha))
+         continue;
 
-      if (sha == mCommitsMap.value(CommitInfo::ZERO_SHA).firstParent())
-         commit.appendChild(&mCommitsMap[CommitInfo::ZERO_SHA]);
+      if (computeLanes)
+      {
+         if (isLanesCheckpoint(row))
+            mLanesCheckpoints.insert(row, mLanes);
+
+         LanesLayout::calculateLanes(mLanes, commit);
+      }
+
+      // The commit could come from a previous load, its relations are rebuilt from scratch
+      commit.mChilds.clear();
+
+      if (sha == wipParentSha)
+         commit.appendChild(keyOfRow(0));
 
-      mCommitsMap[sha] = commit;
-      mCommits[++count] = &mCommitsMap[sha];
+      commit.pos = keyOfRow(row);
 
-      if (tmpChildsStorage.contains(sha))
+      if (const auto childs = mPendingChilds.find(sha); childs != mPendingChilds.end())
       {
-         for (const auto &child : qAsConst(tmpChildsStorage[sha]))
-            mCommitsMap[sha].appendChild(child);
+         for (const auto child : qAsConst(childs.value()))
+            commit.appendChild(child);
 
-         tmpChildsStorage.remove(sha);
+         mPendingChilds.erase(childs);
       }
 
-      for (const auto &parent : qAsConst(mCommitsMap[sha].mParentsSha))
-         tmpChildsStorage[parent].append(&mCommitsMap[sha]);
+      for (const auto &parent : qAsConst(commit.mParents))
+         mPendingChilds[parent].append(keyOfRow(row));
+
+      mCommitsIndex.insert(sha, keyOfRow(row));
+      mShaIndex.append(sha);
+      mCommits.append(std::move(commit));
    }
 
-   mCommitsMap.squeeze();
+   if (!commits.isEmpty())
+      mShaIndexSorted = false;
+}
+
+void GitCache::finishSetup()
+{
+   QMutexLocker lock(&mCommitsMutex);
+
+   mCommitsIndex.squeeze();
    mCommits.squeeze();
 
-   tmpChildsStorage.clear();
-   tmpChildsStorage.squeeze();
+   mPendingChilds.clear();
+   mPendingChilds.squeeze();
+
+   // The index is sorted here, in the loader thread, so the first abbreviated lookup from the UI doesn't pay for it.
+   sortShaIndex();
+
+   buildSearchIndex();
 }
 
 CommitInfo GitCache::commitInfo(int row)
 {
    QMutexLocker lock(&mCommitsMutex);
 
-   const auto commit = row >= 0 && row < mCommits.count() ? mCommits.at(row) : nullptr;
+   return row >= 0 && row < mCommits.count() ? commitWithRows(row) : CommitInfo();
+}
+
+CommitInfo GitCache::commitWithRows(int row) const
+{
+   auto commit = commitAt(row);
 
-   return commit ? *commit : CommitInfo();
+   if (row > 0)
+   {
+      commit.pos = row;
+
+      for (auto &child : commit.mChilds)
+         child = rowOfKey(child);
+   }
+
+   return commit;
 }
 
-auto GitCache::searchCommit(const QString &text, const int startingPoint) const
+int GitCache::rowOf(const ObjectId &sha) const
 {
-   return std::find_if(mCommits.constBegin() + startingPoint, mCommits.constEnd(),
-                       [text](CommitInfo *info) { return info->contains(text); });
+   if (sha == CommitInfo::ZERO_ID)
+      return mWipCommit.isValid() ? 0 : -1;
+
+   const auto iter = mCommitsIndex.constFind(sha);
+
+   return iter != mCommitsIndex.cend() ? rowOfKey(*iter) : -1;
 }
 
-auto GitCache::reverseSearchCommit(const QString &text, int startingPoint) const
+GitCache::CommitsSnapshot GitCache::snapshot() const
 {
-   const auto startEndPos = startingPoint > 0 ? mCommits.count() - startingPoint + 1 : 0;
+   QMutexLocker lock(&mCommitsMutex);
 
-   return std::find_if(mCommits.crbegin() + startEndPos, mCommits.crend(),
-                       [text](CommitInfo *info) { return info->contains(text); });
+   return { mCommits, mWipCommit, mLanesCheckpoints };
 }
 
-CommitInfo GitCache::searchCommitInfo(const QString &text, int startingPoint, bool reverse)
+QVector<int> GitCache::searchCommits(const QString &text)
 {
    QMutexLocker lock(&mCommitsMutex);
-   CommitInfo commit;
 
-   if (!reverse)
+   QVector<QPair<int, int>> matches;
+   const auto addMatch = [this, &text, &matches](int row) {
+      if (const auto rank = CommitSearchIndex::matchRank(mCommits.at(row), text); rank != -1)
+         matches.append(qMakePair(rank, row));
+   };
+
+   auto indexed = false;
+
+   if (CommitSearchIndex::canSearch(text))
    {
-      auto commitIter = searchCommit(text, startingPoint);
+      QMutexLocker lock2(&mSearchMutex);
+
+      if (mSearchIndexReady)
+      {
+         indexed = true;
 
-      if (commitIter == mCommits.constEnd())
-         commitIter = searchCommit(text);
+         // The SHAs are not part of the index
+         const auto shaRow = findRowByPrefix(text);
 
-      if (commitIter != mCommits.constEnd())
-         commit = **commitIter;
+         if (shaRow > 0)
+            matches.append(qMakePair(0, shaRow));
+
+         const auto candidates = mSearchIndex.candidates(text);
+
+         for (const auto &candidate : candidates)
+         {
+            if (const auto row = rowOf(candidate); row > 0 && row != shaRow)
+               addMatch(row);
+         }
+      }
    }
-   else
+
+   if (!indexed)
    {
-      auto commitIter = reverseSearchCommit(text, startingPoint);
+      for (auto row = 1; row < mCommits.count(); ++row)
+         addMatch(row);
+   }
 
-      if (commitIter == mCommits.crend())
-         commitIter = reverseSearchCommit(text);
+   std::sort(matches.begin(), matches.end());
 
-      if (commitIter != mCommits.crend())
-         commit = **commitIter;
-   }
+   QVector<int> rows;
+   rows.reserve(matches.count());
 
-   return commit;
+   for (const auto &match : qAsConst(matches))
+      rows.append(match.second);
+
+   QLog_Debug("Cache", QString("Found {%1} commits that contain {%2}.").arg(rows.count()).arg(text));
+
+   return rows;
 }
 
 bool GitCache::isCommitInCurrentGeneologyTree(const QString &sha)
 {
    QMutexLocker lock(&mCommitsMutex);
 
-   return checkSha(sha, CommitInfo::ZERO_SHA);
+   return checkSha(ObjectId::fromString(sha), CommitInfo::ZERO_ID);
 }
 
 CommitInfo GitCache::commitInfo(const QString &sha)
 {
    QMutexLocker lock(&mCommitsMutex);
 
-   if (!sha.isEmpty())
+   if (sha.isEmpty())
+      return CommitInfo();
+
+   if (const auto row = rowOf(ObjectId::fromString(sha)); row != -1)
+      return commitWithRows(row);
+
+   const auto row = findRowByPrefix(sha);
+
+   return row != -1 ? commitWithRows(row) : CommitInfo();
+}
+
+bool GitCache::containsCommit(const ObjectId &sha) const
+{
+   QMutexLocker lock(&mCommitsMutex);
+
+   return rowOf(sha) != -1;
+}
+
+QHash<QString, QString> GitCache::resolveShas(const QStringList &shortShas)
+{
+   QMutexLocker lock(&mCommitsMutex);
+
+   QHash<QString, QString> shas;
+
+   for (const auto &shortSha : shortShas)
    {
-      const auto c = mCommitsMap.value(sha, CommitInfo());
+      if (shas.contains(shortSha))
+         continue;
 
-      if (!c.isValid())
-      {
-         const auto shas = mCommitsMap.keys();
-         const auto it = std::find_if(shas.cbegin(), shas.cend(),
-                                      [sha](const QString &shaToCompare) { return shaToCompare.startsWith(sha); });
+      if (const auto row = findRowByPrefix(shortSha); row != -1)
+         shas.insert(shortSha, commitAt(row).sha());
+   }
 
-         if (it != shas.cend())
-            return mCommitsMap.value(*it);
+   return shas;
+}
 
-         return CommitInfo();
-      }
+QBitArray GitCache::rowsOfShas(const QStringList &shas)
+{
+   QMutexLocker lock(&mCommitsMutex);
+
+   QBitArray rows(mCommits.count());
+
+   for (const auto &sha : shas)
+   {
+      auto row = rowOf(ObjectId::fromString(sha));
 
-      return c;
+      if (row == -1)
+         row = findRowByPrefix(sha);
+
+      if (row >= 0 && row < rows.size())
+         rows.setBit(row);
    }
 
-   return CommitInfo();
+   return rows;
+}
+
+int GitCache::findRowByPrefix(const QString &shortSha)
+{
+   const auto lowerBound = ObjectId::fromHexPrefix(shortSha);
+
+   if (lowerBound.isNull())
+      return -1;
+
+   sortShaIndex();
+
+   const auto iter = std::lower_bound(mShaIndex.cbegin(), mShaIndex.cend(), lowerBound);
+
+   if (iter == mShaIndex.cend() || !iter->startsWith(shortSha))
+      return -1;
+
+   return rowOf(*iter);
+}
+
+void GitCache::sortShaIndex()
+{
+   if (!mShaIndexSorted)
+   {
+      std::sort(mShaIndex.begin(), mShaIndex.end());
+      mShaIndexSorted = true;
+   }
+}
+
+void GitCache::insertInShaIndex(const ObjectId &sha)
+{
+   if (mShaIndexSorted)
+      mShaIndex.insert(std::lower_bound(mShaIndex.begin(), mShaIndex.end(), sha), sha);
+   else
+      mShaIndex.append(sha);
 }
 
 std::optional<RevisionFiles> GitCache::revisionFile(const QString &sha1, const QString &sha2) const
 {
    QMutexLocker lock(&mRevisionsMutex);
 
-   const auto iter = mRevisionFilesMap.constFind(qMakePair(sha1, sha2));
+   const auto id1 = ObjectId::fromString(sha1);
+   const auto id2 = ObjectId::fromString(sha2);
+
+   if (id1 != CommitInfo::ZERO_ID)
+      return mRevisionCache.files(id1, id2);
+
+   const auto iter = mRevisionFilesMap.constFind(qMakePair(id1, id2));
 
    if (iter != mRevisionFilesMap.cend())
       return *iter;
@@ -178,56 +515,83 @@ std::optional<RevisionFiles> GitCache::revisionFile(const QString &sha1, const Q
    return std::nullopt;
 }
 
+std::optional<QByteArray> GitCache::diff(const QString &sha1, const QString &sha2, const QString &file) const
+{
+   QMutexLocker lock(&mRevisionsMutex);
+
+   return mRevisionCache.diff(ObjectId::fromString(sha1), ObjectId::fromString(sha2), file);
+}
+
+void GitCache::insertDiff(const QString &sha1, const QString &sha2, const QByteArray &diff, const QString &file)
+{
+   QMutexLocker lock(&mRevisionsMutex);
+
+   mRevisionCache.insertDiff(ObjectId::fromString(sha1), ObjectId::fromString(sha2), file, diff);
+}
+
+void GitCache::releaseMemory()
+{
+   QMutexLocker lock(&mRevisionsMutex);
+
+   mRevisionCache.trim(REVISIONS_RELEASED_COST);
+}
+
 void GitCache::clearReferences()
 {
    QMutexLocker lock(&mReferencesMutex);
    mReferences.clear();
-   mReferences.squeeze();
 }
 
-void GitCache::insertWipRevision(const QString parentSha, const RevisionFiles &files)
+void GitCache::insertWipRevision(const ObjectId &parentSha, const RevisionFiles &files)
 {
-   auto newParentSha = parentSha;
-
-   QLog_Debug("Cache", QString("Updating the WIP commit. The actual parent has SHA {%1}.").arg(newParentSha));
+   QLog_Debug("Cache", QString("Updating the WIP commit. The actual parent has SHA {%1}.").arg(parentSha.toString()));
 
-   insertRevisionFile(CommitInfo::ZERO_SHA, newParentSha, files);
+   insertRevisionFile(CommitInfo::ZERO_ID, parentSha, files);
 
-   QStringList parents;
+   QVector<ObjectId> parents;
 
-   if (!newParentSha.isEmpty())
-      parents.append(newParentSha);
+   if (!parentSha.isNull())
+      parents.append(parentSha);
 
    if (mLanes.isEmpty())
-      mLanes.init(CommitInfo::ZERO_SHA);
+      mLanes.init(CommitInfo::ZERO_ID);
 
    const auto log = files.count() == mUntrackedFiles.count() ? tr("No local changes") : tr("Local changes");
-   CommitInfo c(CommitInfo::ZERO_SHA, parents, std::chrono::seconds(QDateTime::currentSecsSinceEpoch()), log);
-   calculateLanes(c);
+   CommitInfo c(CommitInfo::ZERO_ID, parents, std::chrono::seconds(QDateTime::currentSecsSinceEpoch()), log);
+   c.setLanes(LanesLayout::calculateLanes(mLanes, c));
 
-   if (mCommits[0])
-      c.setLanes(mCommits[0]->lanes());
+   if (mCommits.isEmpty())
+      mCommits.resize(1);
+   else if (mWipCommit.isValid())
+      c.setLanes(mWipCommit.lanes());
 
-   mCommitsMap.insert(CommitInfo::ZERO_SHA, std::move(c));
-   mCommits[0] = &mCommitsMap[CommitInfo::ZERO_SHA];
+   mWipCommit = std::move(c);
 }
 
 bool GitCache::insertRevisionFiles(const QString &sha1, const QString &sha2, const RevisionFiles &file)
 {
    QMutexLocker lock(&mRevisionsMutex);
 
-   return insertRevisionFile(sha1, sha2, file);
+   return insertRevisionFile(ObjectId::fromString(sha1), ObjectId::fromString(sha2), file);
 }
 
-bool GitCache::insertRevisionFile(const QString &sha1, const QString &sha2, const RevisionFiles &file)
+bool GitCache::insertRevisionFile(const ObjectId &sha1, const ObjectId &sha2, const RevisionFiles &file)
 {
    const auto key = qMakePair(sha1, sha2);
-   const auto emptyShas = !sha1.isEmpty() && !sha2.isEmpty();
-   const auto isWip = sha1 == CommitInfo::ZERO_SHA;
+   const auto emptyShas = !sha1.isNull() && !sha2.isNull();
+   const auto isWip = sha1 == CommitInfo::ZERO_ID;
 
-   if ((emptyShas || isWip) && mRevisionFilesMap.value(key) != file)
+   // The files of the commits never change, so they go to the cache that can evict them
+   if (!isWip && emptyShas)
    {
-      QLog_Debug("Cache", QString("Adding the revisions files between {%1} and {%2}.").arg(sha1, sha2));
+      mRevisionCache.insertFiles(sha1, sha2, file);
+      return true;
+   }
+
+   if (isWip && mRevisionFilesMap.value(key) != file)
+   {
+      QLog_Debug("Cache",
+                 QString("Adding the revisions files between {%1} and {%2}.").arg(sha1.toString(), sha2.toString()));
 
       mRevisionFilesMap.insert(key, file);
 
@@ -243,104 +607,169 @@ void GitCache::insertReference(const QString &sha, References::Type type, const
 
    QLog_Trace("Cache", QString("Adding a new reference with SHA {%1}.").arg(sha));
 
-   mReferences[sha].addReference(type, reference);
+   mReferences.insert(ObjectId::fromString(sha), type, reference);
 }
 
 void GitCache::deleteReference(const QString &sha, References::Type type, const QString &reference)
 {
    QMutexLocker lock(&mReferencesMutex);
 
-   mReferences[sha].removeReference(type, reference);
+   mReferences.remove(ObjectId::fromString(sha), type, reference);
 }
 
 bool GitCache::hasReferences(const QString &sha)
 {
    QMutexLocker lock(&mReferencesMutex);
 
-   return mReferences.contains(sha) && !mReferences.value(sha).isEmpty();
+   return mReferences.hasReferences(ObjectId::fromString(sha));
 }
 
 QStringList GitCache::getReferences(const QString &sha, References::Type type)
 {
    QMutexLocker lock(&mReferencesMutex);
 
-   return mReferences.value(sha).getReferences(type);
+   return mReferences.references(ObjectId::fromString(sha)).getReferences(type);
 }
 
 QString GitCache::getShaOfReference(const QString &referenceName, References::Type type) const
 {
    QMutexLocker lock(&mReferencesMutex);
 
-   for (auto iter = mReferences.cbegin(); iter != mReferences.cend(); ++iter)
+   return mReferences.sha(type, referenceName).toString();
+}
+
+ReferencesIndex GitCache::referencesSnapshot() const
+{
+   QMutexLocker lock(&mReferencesMutex);
+
+   return mReferences;
+}
+
+int GitCache::updateReferences(const ReferencesIndex &references, const QVector<References::Type> &types)
+{
+   QMutexLocker lock(&mReferencesMutex);
+
+   auto changes = 0;
+
+   for (const auto type : types)
    {
-      const auto references = iter.value().getReferences(type);
+      const auto oldShas = mReferences.shas(type);
+      const auto &newShas = references.shas(type);
 
-      for (const auto &reference : references)
-         if (reference == referenceName)
-            return iter.key();
+      for (auto iter = oldShas.cbegin(); iter != oldShas.cend(); ++iter)
+      {
+         if (!newShas.contains(iter.key()))
+         {
+            mReferences.remove(iter.value(), type, iter.key());
+            ++changes;
+         }
+      }
+
+      for (auto iter = newShas.cbegin(); iter != newShas.cend(); ++iter)
+      {
+         if (oldShas.value(iter.key()) != iter.value())
+         {
+            mReferences.insert(iter.value(), type, iter.key());
+            ++changes;
+         }
+      }
    }
 
-   return QString();
+   QLog_Debug("Cache", QString("Updated {%1} references.").arg(changes));
+
+   return changes;
 }
 
 void GitCache::reloadCurrentBranchInfo(const QString &currentBranch, const QString &currentSha)
 {
    QMutexLocker lock(&mReferencesMutex);
 
-   const auto lastItem = mReferences.end();
-   for (auto ref = mReferences.begin(); ref != lastItem; ++ref)
+   mReferences.insert(ObjectId::fromString(currentSha), References::Type::LocalBranch, currentBranch);
+}
+
+bool GitCache::updateWipCommit(const QString &parentSha, const RevisionFiles &files)
+{
    {
-      if (ref.value().getReferences(References::Type::LocalBranch).contains(currentBranch))
-      {
-         ref.value().removeReference(References::Type::LocalBranch, currentBranch);
+      QMutexLocker lock(&mRevisionsMutex);
+      QMutexLocker lock2(&mCommitsMutex);
+
+      if (!mConfigured)
+         return false;
 
-         const auto key = ref.key();
+      const auto parent = ObjectId::fromString(parentSha);
 
-         if (mReferences.value(key).isEmpty())
-            mReferences.remove(key);
+      // The WIP is the first child of its parent
+      if (const auto oldParent = mWipCommit.firstParentId(); oldParent != parent)
+      {
+         if (const auto oldParentRow = rowOf(oldParent); oldParentRow > 0)
+            mCommits[oldParentRow].removeChild(keyOfRow(0));
 
-         break;
+         if (const auto parentRow = rowOf(parent); parentRow > 0)
+            mCommits[parentRow].mChilds.prepend(keyOfRow(0));
       }
+
+      insertWipRevision(parent, files);
    }
 
-   mReferences[currentSha].addReference(References::Type::LocalBranch, currentBranch);
+   emit signalWipUpdated();
+
+   return true;
 }
 
-bool GitCache::updateWipCommit(const QString &parentSha, const RevisionFiles &files)
+void GitCache::insertCommit(CommitInfo commit)
 {
-   QMutexLocker lock(&mRevisionsMutex);
    QMutexLocker lock2(&mCommitsMutex);
 
-   if (mConfigured)
+   const auto sha = commit.id();
+   const auto parentSha = commit.firstParentId();
+
+   const auto parentRow = rowOf(parentSha);
+
+   // The key of the WIP changes with the rows on top
+   if (parentRow > 0)
+      mCommits[parentRow].removeChild(keyOfRow(0));
+
+   shiftRows(1);
+
+   commit.pos = keyOfRow(1);
+   commit.mChilds = { keyOfRow(0) };
+
+   // The lane that was waiting for the parent now waits for the new commit, and it's the parent again after it
+   if (const auto checkpoint = mLanesCheckpoints.constFind(2); checkpoint != mLanesCheckpoints.cend())
    {
-      insertWipRevision(parentSha, files);
-      return true;
+      auto lanes = checkpoint.value();
+      lanes.replaceSha(parentSha, sha);
+      mLanesCheckpoints.insert(1, lanes);
    }
 
-   return false;
-}
+   // The parent moved down with the rest of rows
+   if (parentRow > 0)
+      mCommits[parentRow + 1].appendChild(keyOfRow(1));
 
-void GitCache::insertCommit(CommitInfo commit)
-{
-   QMutexLocker lock2(&mCommitsMutex);
+   addToSearchIndex({ commit });
 
-   const auto sha = commit.sha;
-   const auto parentSha = commit.firstParent();
+   mCommits.removeFirst();
+   mCommits.prepend({ CommitInfo(), commit });
+   mCommitsIndex.insert(sha, keyOfRow(1));
 
-   commit.setLanes({ LaneType::ACTIVE });
-   commit.pos = 1;
+   insertInShaIndex(sha);
+}
 
-   mCommitsMap[sha] = std::move(commit);
-   mCommitsMap[sha].appendChild(&mCommitsMap[CommitInfo::ZERO_SHA]);
+void GitCache::shiftRows(int count)
+{
+   if (count == 0)
+      return;
 
-   mCommitsMap[parentSha].removeChild(&mCommitsMap[CommitInfo::ZERO_SHA]);
-   mCommitsMap[parentSha].appendChild(&mCommitsMap[sha]);
+   // The keys stored in the commits and in the index don't change, only their rows
+   mRowsOnTop += count;
 
-   const auto total = mCommits.count();
-   for (auto i = 1; i < total; ++i)
-      ++mCommits[i]->pos;
+   // There is a checkpoint every few hundreds of rows, they're the only rows moved
+   QMap<int, Lanes> checkpoints;
 
-   mCommits.insert(1, &mCommitsMap[sha]);
+   for (auto iter = mLanesCheckpoints.cbegin(); iter != mLanesCheckpoints.cend(); ++iter)
+      checkpoints.insert(iter.key() >= 1 ? iter.key() + count : iter.key(), iter.value());
+
+   mLanesCheckpoints = std::move(checkpoints);
 }
 
 void GitCache::updateCommit(const QString &oldSha, CommitInfo newCommit)
@@ -348,62 +777,47 @@ void GitCache::updateCommit(const QString &oldSha, CommitInfo newCommit)
    QMutexLocker lock(&mCommitsMutex);
    QMutexLocker lock2(&mRevisionsMutex);
 
-   auto &oldCommit = mCommitsMap[oldSha];
-   const auto oldCommitParens = oldCommit.parents();
-   const auto newCommitSha = newCommit.sha;
+   const auto oldId = ObjectId::fromString(oldSha);
+   const auto row = rowOf(oldId);
 
-   mCommitsMap.remove(oldSha);
-   mCommitsMap.insert(newCommitSha, std::move(newCommit));
-   mCommits[newCommit.pos] = &mCommitsMap[newCommitSha];
+   if (row <= 0 || row >= mCommits.count())
+      return;
 
-   for (const auto &parent : oldCommitParens)
-   {
-      mCommitsMap[parent].removeChild(&oldCommit);
-      mCommitsMap[parent].appendChild(&mCommitsMap[newCommitSha]);
-   }
+   mCommitsIndex.remove(oldId);
+
+   const auto newCommitSha = newCommit.id();
+   const auto newSha = newCommitSha.toString();
+
+   // The parents and the children keep pointing to the same row, so only the row itself needs to be replaced.
+   newCommit.pos = keyOfRow(row);
+   newCommit.mChilds = mCommits.at(row).mChilds;
+   mCommits[row] = std::move(newCommit);
+   mCommitsIndex.insert(newCommitSha, keyOfRow(row));
+
+   mShaIndex.removeOne(oldId);
+   insertInShaIndex(newCommitSha);
+
+   for (auto &lanes : mLanesCheckpoints)
+      lanes.replaceSha(oldId, newCommitSha);
+
+   // The old commit stays in the index but it's no longer found in the cache
+   addToSearchIndex({ mCommits.at(row) });
 
    const auto tags = getReferences(oldSha, References::Type::LocalTag);
    for (const auto &tag : tags)
    {
-      insertReference(newCommitSha, References::Type::LocalTag, tag);
+      insertReference(newSha, References::Type::LocalTag, tag);
       deleteReference(oldSha, References::Type::LocalTag, tag);
    }
 
    const auto localBranches = getReferences(oldSha, References::Type::LocalBranch);
    for (const auto &branch : localBranches)
    {
-      insertReference(newCommitSha, References::Type::LocalBranch, branch);
+      insertReference(newSha, References::Type::LocalBranch, branch);
       deleteReference(oldSha, References::Type::LocalBranch, branch);
    }
 }
 
-void GitCache::calculateLanes(CommitInfo &c)
-{
-   const auto sha = c.sha;
-
-   QLog_Trace("Cache", QString("Updating the lanes for SHA {%1}.").arg(sha));
-
-   bool isDiscontinuity;
-   bool isFork = mLanes.isFork(sha, isDiscontinuity);
-   bool isMerge = c.parentsCount() > 1;
-
-   if (isDiscontinuity)
-      mLanes.changeActiveLane(sha);
-
-   if (isFork)
-      mLanes.setFork(sha);
-   if (isMerge)
-      mLanes.setMerge(c.parents());
-   if (c.parentsCount() == 0)
-      mLanes.setInitial();
-
-   const auto lanes = mLanes.getLanes();
-
-   resetLanes(c, isFork);
-
-   c.setLanes(std::move(lanes));
-}
-
 bool GitCache::pendingLocalChanges()
 {
    QMutexLocker lock(&mCommitsMutex);
@@ -411,10 +825,12 @@ bool GitCache::pendingLocalChanges()
 
    auto localChanges = false;
 
-   if (const auto commit = mCommitsMap.value(CommitInfo::ZERO_SHA, CommitInfo()); commit.isValid())
+   if (mWipCommit.isValid())
    {
-      if (const auto rf = revisionFile(CommitInfo::ZERO_SHA, commit.firstParent()); rf)
-         localChanges = rf.value().count() - mUntrackedFiles.count() > 0;
+      const auto rf = mRevisionFilesMap.constFind(qMakePair(CommitInfo::ZERO_ID, mWipCommit.firstParentId()));
+
+      if (rf != mRevisionFilesMap.cend())
+         localChanges = rf->count() - mUntrackedFiles.count() > 0;
    }
 
    return localChanges;
@@ -423,84 +839,137 @@ bool GitCache::pendingLocalChanges()
 QVector<QPair<QString, QStringList>> GitCache::getBranches(References::Type type)
 {
    QMutexLocker lock(&mReferencesMutex);
-   QVector<QPair<QString, QStringList>> branches;
 
-   for (auto iter = mReferences.cbegin(); iter != mReferences.cend(); ++iter)
-      branches.append(QPair<QString, QStringList>(iter.key(), iter.value().getReferences(type)));
-
-   return branches;
+   return mReferences.shasWithReferences(type);
 }
 
 QMap<QString, QString> GitCache::getTags(References::Type tagType) const
 {
    QMutexLocker lock(&mReferencesMutex);
 
-   QMap<QString, QString> tags;
-
-   for (auto iter = mReferences.cbegin(); iter != mReferences.cend(); ++iter)
-   {
-      const auto tagNames = iter->getReferences(tagType);
-
-      for (const auto &tag : tagNames)
-         tags[tag] = iter.key();
-   }
-
-   return tags;
+   return mReferences.referencesOfType(tagType);
 }
 
 void GitCache::updateTags(QMap<QString, QString> remoteTags)
 {
+   ReferencesIndex tags;
    const auto end = remoteTags.cend();
 
    for (auto iter = remoteTags.cbegin(); iter != end; ++iter)
-      insertReference(iter.value(), References::Type::RemoteTag, iter.key());
+      tags.insert(ObjectId::fromString(iter.value()), References::Type::RemoteTag, iter.key());
+
+   updateReferences(tags, { References::Type::RemoteTag });
 
    emit signalCacheUpdated();
 }
 
-void GitCache::resetLanes(const CommitInfo &c, bool isFork)
+bool GitCache::checkSha(const ObjectId &originalSha, const ObjectId &currentSha) const
 {
-   const auto nextSha = c.parentsCount() == 0 ? QString() : c.firstParent();
+   auto sha = currentSha;
+
+   while (originalSha != sha)
+   {
+      const auto row = rowOf(sha);
 
-   mLanes.nextParent(nextSha);
+      if (row == -1)
+         return false;
+
+      sha = commitAt(row).firstParentId();
+   }
 
-   if (c.parentsCount() > 1)
-      mLanes.afterMerge();
-   if (isFork)
-      mLanes.afterFork();
-   if (mLanes.isBranch())
-      mLanes.afterBranch();
+   return true;
 }
 
-bool GitCache::checkSha(const QString &originalSha, const QString &currentSha) const
+bool GitCache::canSearchInIndex(const QString &text) const
 {
-   if (originalSha == currentSha)
-      return true;
+   QMutexLocker lock(&mSearchMutex);
 
-   if (const auto iter = mCommitsMap.find(currentSha); iter != mCommitsMap.cend())
-      return checkSha(originalSha, iter->firstParent());
+   return mSearchIndexReady && CommitSearchIndex::canSearch(text);
+}
 
-   return false;
+void GitCache::buildSearchIndex()
+{
+   // Only one index is built at a time, the previous one is no longer needed anyway
+   mSearchIndexBuild.waitForFinished();
+
+   QMutexLocker lock(&mSearchMutex);
+
+   const auto generation = ++mSearchIndexGeneration;
+   const auto commits = mCommits;
+
+   mSearchIndexReady = false;
+   mPendingSearchCommits.clear();
+
+   mSearchIndexBuild = QtConcurrent::run([this, commits, generation]() {
+      CommitSearchIndex index;
+
+      for (const auto &block : commits.blocks())
+         index.addCommits(block);
+
+      QMutexLocker lock(&mSearchMutex);
+
+      if (generation == mSearchIndexGeneration)
+      {
+         index.addCommits(mPendingSearchCommits);
+         mPendingSearchCommits.clear();
+
+         mSearchIndex = std::move(index);
+         mSearchIndexReady = true;
+
+         QLog_Debug("Cache", QString("The search index is ready."));
+      }
+   });
+}
+
+void GitCache::resetSearchIndex()
+{
+   QMutexLocker lock(&mSearchMutex);
+
+   ++mSearchIndexGeneration;
+   mSearchIndexReady = false;
+   mSearchIndex.clear();
+   mPendingSearchCommits.clear();
+}
+
+void GitCache::addToSearchIndex(const QVector<CommitInfo> &commits)
+{
+   QMutexLocker lock(&mSearchMutex);
+
+   if (mSearchIndexReady)
+      mSearchIndex.addCommits(commits);
+   else
+      mPendingSearchCommits.append(commits);
 }
 
 void GitCache::clearInternalData()
 {
    mCommits.clear();
    mCommits.squeeze();
-   mCommitsMap.clear();
-   mCommitsMap.squeeze();
+   mWipCommit = CommitInfo();
+   mCommitsIndex.clear();
+   mCommitsIndex.squeeze();
+   mPendingChilds.clear();
+   mPendingChilds.squeeze();
+   mRowsOnTop = 0;
+   mShaIndex.clear();
+   mShaIndex.squeeze();
    mReferences.clear();
+   // The revision cache is kept: the files and the diffs of a commit are the same after reloading the history
    mRevisionFilesMap.clear();
    mRevisionFilesMap.squeeze();
+   mWipFileObjects.clear();
    mUntrackedFiles.clear();
    mUntrackedFiles.squeeze();
    mLanes.clear();
-   mReferences.clear();
-   mReferences.squeeze();
+   mLanesCheckpoints.clear();
+
+   resetSearchIndex();
 }
 
 int GitCache::commitCount() const
 {
+   QMutexLocker lock(&mCommitsMutex);
+
    return mCommits.count();
 }
 
@@ -510,3 +979,20 @@ void GitCache::setUntrackedFilesList(QVector<QString> untrackedFiles)
    mUntrackedFiles.squeeze();
    mUntrackedFiles = std::move(untrackedFiles);
 }
+
+void GitCache::setWipFileObjects(QHash<QString, WipFileObjects> objects)
+{
+   QMutexLocker lock(&mRevisionsMutex);
+
+   mWipFileObjects = std::move(objects);
+}
+
+std::optional<WipFileObjects> GitCache::wipFileObjects(const QString &file) const
+{
+   QMutexLocker lock(&mRevisionsMutex);
+
+   if (const auto iter = mWipFileObjects.constFind(file); iter != mWipFileObjects.cend())
+      return *iter;
+
+   return std::nullopt;
+}
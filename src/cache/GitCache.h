@@ -24,24 +24,31 @@
  ***************************************************************************************/
 
 #include <CommitInfo.h>
+#include <CommitSearchIndex.h>
+#include <CommitStore.h>
+#include <ReferencesIndex.h>
+#include <RevisionCache.h>
 #include <RevisionFiles.h>
+#include <WipRevisionInfo.h>
 #include <lanes.h>
 
+#include <QBitArray>
+#include <QFuture>
 #include <QHash>
+#include <QMap>
 #include <QMutex>
 #include <QObject>
 #include <QSharedPointer>
 
 #include <optional>
 
-struct WipRevisionInfo;
-
 class GitCache : public QObject
 {
    Q_OBJECT
 
 signals:
    void signalCacheUpdated();
+   void signalWipUpdated();
 
 public:
    struct LocalBranchDistances
@@ -50,14 +57,57 @@ public:
       int behindOrigin = 0;
    };
 
+   /**
+    * @brief The CommitsSnapshot struct is a read-only copy of the commits of the cache that can be read without
+    * locking it. The blocks of commits are implicitly shared with the cache, so taking a snapshot doesn't copy them
+    * and the commits appended later only copy the last block. The positions and the children of the commits are
+    * stored as keys of the cache: commitInfo() returns them as rows.
+    */
+   struct CommitsSnapshot
+   {
+      CommitStore commits;
+      CommitInfo wip;
+      QMap<int, Lanes> lanesCheckpoints;
+
+      int count() const { return commits.count(); }
+      const CommitInfo &at(int row) const { return row == 0 ? wip : commits.at(row); }
+   };
+
    explicit GitCache(QObject *parent = nullptr);
    ~GitCache();
 
    int commitCount() const;
+   CommitsSnapshot snapshot() const;
 
    CommitInfo commitInfo(const QString &sha);
    CommitInfo commitInfo(int row);
-   CommitInfo searchCommitInfo(const QString &text, int startingPoint = 0, bool reverse = false);
+   bool containsCommit(const ObjectId &sha) const;
+   /**
+    * @brief searchCommits Searches @p text in the SHA, the title, the description, the author and the committer of all
+    * the commits. The search uses the trigram index of the commits once it's built in the background.
+    * @return The rows of the commits found, the best matches first and, within the same rank, in the order of the
+    * graph.
+    */
+   QVector<int> searchCommits(const QString &text);
+
+   /**
+    * @brief canSearchInIndex Tells if @p text can be searched in the index of the commits.
+    * @return True if the index is ready and @p text is long enough.
+    */
+   bool canSearchInIndex(const QString &text) const;
+
+   /**
+    * @brief resolveShas Resolves a list of abbreviated SHAs with a single lock of the cache.
+    * @return The full SHA of every abbreviated SHA found in the cache.
+    */
+   QHash<QString, QString> resolveShas(const QStringList &shortShas);
+
+   /**
+    * @brief rowsOfShas Resolves a list of SHAs, full or abbreviated, into the rows of the graph with a single lock of
+    * the cache.
+    * @return A bitmap with as many bits as rows where the rows of the SHAs found are set.
+    */
+   QBitArray rowsOfShas(const QStringList &shas);
    bool isCommitInCurrentGeneologyTree(const QString &sha);
    bool updateWipCommit(const QString &parentSha, const RevisionFiles &files);
    void insertCommit(CommitInfo commit);
@@ -66,17 +116,50 @@ public:
    bool insertRevisionFiles(const QString &sha1, const QString &sha2, const RevisionFiles &file);
    std::optional<RevisionFiles> revisionFile(const QString &sha1, const QString &sha2) const;
 
+   /**
+    * @brief diff Returns the diff between two commits if it was stored before. The diffs of the WIP are never stored.
+    * @param file The file of the diff or an empty string for the full diff of the commits.
+    * @return The output of git diff, as bytes, or nothing if it's not stored.
+    */
+   std::optional<QByteArray> diff(const QString &sha1, const QString &sha2, const QString &file = QString()) const;
+   void insertDiff(const QString &sha1, const QString &sha2, const QByteArray &diff, const QString &file = QString());
+
+   /**
+    * @brief releaseMemory Removes most of the files and the diffs of the commits, keeping the ones used last.
+    */
+   void releaseMemory();
+
    void clearReferences();
    void insertReference(const QString &sha, References::Type type, const QString &reference);
    void deleteReference(const QString &sha, References::Type type, const QString &reference);
    bool hasReferences(const QString &sha);
    QStringList getReferences(const QString &sha, References::Type type);
    QString getShaOfReference(const QString &referenceName, References::Type type) const;
+   /**
+    * @brief referencesSnapshot Returns a copy of all the references of the repository. The copy is implicitly shared
+    * with the cache, so a widget can read all the references it needs without locking the cache for every one.
+    */
+   ReferencesIndex referencesSnapshot() const;
+   /**
+    * @brief updateReferences Replaces the references of the given @p types with the ones in @p references. Only the
+    * references that were added, removed or moved are touched.
+    * @return The number of references that changed.
+    */
+   int updateReferences(const ReferencesIndex &references, const QVector<References::Type> &types);
    void reloadCurrentBranchInfo(const QString &currentBranch, const QString &currentSha);
 
    QVector<QString> getUntrackedFiles() const { return mUntrackedFiles; }
    void setUntrackedFilesList(QVector<QString> untrackedFiles);
    bool pendingLocalChanges();
+   /**
+    * @brief setWipFileObjects Replaces the blobs that the files of the WIP have in HEAD and in the index.
+    */
+   void setWipFileObjects(QHash<QString, WipFileObjects> objects);
+   /**
+    * @brief wipFileObjects Returns the blobs of a tracked file of the WIP.
+    * @return The blobs of @p file or nothing if it's not a tracked file with local changes.
+    */
+   std::optional<WipFileObjects> wipFileObjects(const QString &file) const;
 
    QVector<QPair<QString, QStringList>> getBranches(References::Type type);
    QMap<QString, QString> getTags(References::Type tagType) const;
@@ -85,33 +168,87 @@ public:
 
    bool isInitialized() const { return mInitialized; }
 
+protected:
+   /**
+    * @brief setup Replaces the history with @p commits, in the order of the rows of the graph, and the WIP whose parent
+    * is @p parentSha.
+    */
+   void setup(const QString &parentSha, const RevisionFiles &files, QVector<CommitInfo> commits);
+
 private:
    friend class GitRepoLoader;
 
    bool mInitialized = false;
    bool mConfigured = true;
    Lanes mLanes;
+   // State of the lanes before calculating some of the rows. The commits don't store their lanes: the view calculates
+   // the rows it paints from these checkpoints and only the top of the graph is calculated again when commits are
+   // added.
+   QMap<int, Lanes> mLanesCheckpoints;
    QVector<QString> mUntrackedFiles;
 
    mutable QMutex mCommitsMutex;
-   QVector<CommitInfo *> mCommits;
-   QHash<QString, CommitInfo> mCommitsMap;
+   // Commits stored in the same order as the rows of the graph. The first row belongs to the WIP commit, that is
+   // stored apart so updating it doesn't copy the commits shared with a snapshot. The relations between commits, the
+   // index and the position of the commits are stored as keys: the row minus the rows added on top of the history
+   // since it was loaded. Adding commits on top only changes the offset, not the keys of the commits stored before.
+   CommitStore mCommits;
+   CommitInfo mWipCommit;
+   QHash<ObjectId, int> mCommitsIndex;
+   QHash<ObjectId, QVector<int>> mPendingChilds;
+   int mRowsOnTop = 0;
+   QVector<ObjectId> mShaIndex;
+   bool mShaIndexSorted = true;
+
+   // The index is built in the background from a snapshot. The commits added meanwhile wait to be indexed.
+   mutable QMutex mSearchMutex;
+   CommitSearchIndex mSearchIndex;
+   QVector<CommitInfo> mPendingSearchCommits;
+   QFuture<void> mSearchIndexBuild;
+   int mSearchIndexGeneration = 0;
+   bool mSearchIndexReady = false;
 
    mutable QMutex mRevisionsMutex;
-   QHash<QPair<QString, QString>, RevisionFiles> mRevisionFilesMap;
+   // Only the files of the WIP: the ones of the commits are in the revision cache, that has a budget
+   QHash<QPair<ObjectId, ObjectId>, RevisionFiles> mRevisionFilesMap;
+   mutable RevisionCache mRevisionCache;
+   QHash<QString, WipFileObjects> mWipFileObjects;
 
    mutable QMutex mReferencesMutex;
-   QHash<QString, References> mReferences;
-
-   void setup(const QString &parentSha, const RevisionFiles &files, QVector<CommitInfo> commits);
+   ReferencesIndex mReferences;
+
+   void startSetup(const QString &parentSha, const RevisionFiles &files, int expectedCommits = 0);
+   void appendCommits(QVector<CommitInfo> commits);
+   void restoreCommits(QVector<CommitInfo> commits, QMap<int, Lanes> lanesCheckpoints);
+   int prependCommits(QVector<CommitInfo> commits, const QString &wipParentSha, const RevisionFiles &wipFiles);
+   QMap<int, Lanes> lanesCheckpoints() const;
+   void finishSetup();
    void setConfigurationDone() { mConfigured = true; }
 
-   bool insertRevisionFile(const QString &sha1, const QString &sha2, const RevisionFiles &file);
-   void insertWipRevision(const QString parentSha, const RevisionFiles &files);
-   void calculateLanes(CommitInfo &c);
-   auto searchCommit(const QString &text, int startingPoint = 0) const;
-   auto reverseSearchCommit(const QString &text, int startingPoint = 0) const;
-   void resetLanes(const CommitInfo &c, bool isFork);
-   bool checkSha(const QString &originalSha, const QString &currentSha) const;
+   bool insertRevisionFile(const ObjectId &sha1, const ObjectId &sha2, const RevisionFiles &file);
+   void insertWipRevision(const ObjectId &parentSha, const RevisionFiles &files);
+   void storeCommits(QVector<CommitInfo> &commits, bool computeLanes);
+   const CommitInfo &commitAt(int row) const { return row == 0 ? mWipCommit : mCommits.at(row); }
+   /**
+    * @brief commitWithRows Returns a copy of the commit of @p row with its position and its children as rows.
+    */
+   CommitInfo commitWithRows(int row) const;
+   int rowOfKey(int key) const { return key + mRowsOnTop; }
+   int keyOfRow(int row) const { return row - mRowsOnTop; }
+   /**
+    * @brief rowOf Returns the row of @p sha, 0 for the WIP, or -1 if it's not in the cache.
+    */
+   int rowOf(const ObjectId &sha) const;
+   int findRowByPrefix(const QString &shortSha);
+   /**
+    * @brief shiftRows Moves the rows of the commits down to make room for @p count commits after the WIP.
+    */
+   void shiftRows(int count);
+   void sortShaIndex();
+   void insertInShaIndex(const ObjectId &sha);
+   bool checkSha(const ObjectId &originalSha, const ObjectId &currentSha) const;
+   void buildSearchIndex();
+   void resetSearchIndex();
+   void addToSearchIndex(const QVector<CommitInfo> &commits);
    void clearInternalData();
 };
@@ -0,0 +1,88 @@
+#include "LanesLayout.h"
+
+namespace
+{
+// The view shows a few dozens of rows, the window leaves room to scroll in both directions before it's calculated again
+const int WINDOW_SIZE = 256;
+}
+
+void LanesLayout::setSource(const CommitStore &commits, const QMap<int, Lanes> &checkpoints)
+{
+   mCommits = commits;
+   mCheckpoints = checkpoints;
+   mWindowStart = 0;
+   mWindow.clear();
+}
+
+QVector<Lane> LanesLayout::lanesAt(int row) const
+{
+   if (row < mWindowStart || row >= mWindowStart + mWindow.count())
+      calculateWindow(row);
+
+   return row >= mWindowStart && row < mWindowStart + mWindow.count() ? mWindow.at(row - mWindowStart)
+                                                                       : QVector<Lane>();
+}
+
+QVector<Lane> LanesLayout::calculateLanes(Lanes &lanes, const CommitInfo &commit)
+{
+   const auto sha = commit.id();
+   const auto totalParents = commit.parentsCount();
+
+   bool isDiscontinuity;
+   const auto isFork = lanes.isFork(sha, isDiscontinuity);
+
+   if (isDiscontinuity)
+      lanes.changeActiveLane(sha);
+
+   if (isFork)
+      lanes.setFork(sha);
+   if (totalParents > 1)
+      lanes.setMerge(commit.parentIds());
+   if (totalParents == 0)
+      lanes.setInitial();
+
+   auto rowLanes = lanes.getLanes();
+
+   lanes.nextParent(totalParents == 0 ? ObjectId() : commit.firstParentId());
+
+   if (totalParents > 1)
+      lanes.afterMerge();
+   if (isFork)
+      lanes.afterFork();
+   if (lanes.isBranch())
+      lanes.afterBranch();
+
+   return rowLanes;
+}
+
+void LanesLayout::calculateWindow(int row) const
+{
+   mWindow.clear();
+   mWindowStart = 0;
+
+   if (row <= 0 || row >= mCommits.count())
+      return;
+
+   auto checkpoint = mCheckpoints.upperBound(row);
+
+   if (checkpoint == mCheckpoints.cbegin())
+      return;
+
+   --checkpoint;
+
+   const auto start = qMax(row - WINDOW_SIZE / 2, checkpoint.key());
+   const auto end = qMin(start + WINDOW_SIZE, mCommits.count());
+   auto lanes = checkpoint.value();
+
+   mWindow.reserve(end - start);
+
+   for (auto i = checkpoint.key(); i < end; ++i)
+   {
+      auto rowLanes = calculateLanes(lanes, mCommits.at(i));
+
+      if (i >= start)
+         mWindow.append(std::move(rowLanes));
+   }
+
+   mWindowStart = start;
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+/****************************************************************************************
+ ** GitQlient is an application to manage and operate one or several Git repositories. With
+ ** GitQlient you will be able to add commits, branches and manage all the options Git provides.
+ ** Copyright (C) 2021  Francesc Martinez
+ **
+ ** LinkedIn: www.linkedin.com/in/cescmm/
+ ** Web: www.francescmm.com
+ **
+ ** This program is free software; you can redistribute it and/or
+ ** modify it under the terms of the GNU Lesser General Public
+ ** License as published by the Free Software Foundation; either
+ ** version 2 of the License, or (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ ** Lesser General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Lesser General Public
+ ** License along with this library; if not, write to the Free Software
+ ** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ ***************************************************************************************/
+
+#include <CommitInfo.h>
+#include <CommitStore.h>
+#include <lanes.h>
+
+#include <QMap>
+#include <QVector>
+
+/**
+ * @brief The LanesLayout class calculates the lanes of the history graph on demand. The cache only keeps the state of
+ * the lanes before some of the rows (the checkpoints) and the layout replays the graph from the closest checkpoint to
+ * get the lanes of the rows that are painted. Only the lanes of a window of rows around the last row requested are
+ * kept in memory.
+ *
+ * The WIP commit is not part of the layout: it's calculated when the WIP is updated and it keeps its own lanes.
+ */
+class LanesLayout
+{
+public:
+   LanesLayout() = default;
+
+   /**
+    * @brief setSource Sets the commits and the checkpoints used to calculate the lanes. The window calculated before
+    * is discarded.
+    * @param commits The commits in the same order as the rows of the graph.
+    * @param checkpoints The state of the lanes before some of the rows.
+    */
+   void setSource(const CommitStore &commits, const QMap<int, Lanes> &checkpoints);
+
+   /**
+    * @brief lanesAt Returns the lanes of a row of the graph.
+    * @param row The row in the graph. The first row belongs to the WIP and it's not calculated by the layout.
+    * @return The lanes of the row, or an empty vector if the row can't be calculated.
+    */
+   QVector<Lane> lanesAt(int row) const;
+
+   /**
+    * @brief calculateLanes Moves the state of the lanes after @p commit.
+    * @param lanes The state of the lanes before @p commit.
+    * @param commit The commit to add to the graph.
+    * @return The lanes of the row of @p commit.
+    */
+   static QVector<Lane> calculateLanes(Lanes &lanes, const CommitInfo &commit);
+
+private:
+   CommitStore mCommits;
+   QMap<int, Lanes> mCheckpoints;
+   mutable int mWindowStart = 0;
+   mutable QVector<QVector<Lane>> mWindow;
+
+   void calculateWindow(int row) const;
+};
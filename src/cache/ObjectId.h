@@ -0,0 +1,219 @@
+#pragma once
+
+/****************************************************************************************
+ ** GitQlient is an application to manage and operate one or several Git repositories. With
+ ** GitQlient you will be able to add commits, branches and manage all the options Git provides.
+ ** Copyright (C) 2021  Francesc Martinez
+ **
+ ** LinkedIn: www.linkedin.com/in/cescmm/
+ ** Web: www.francescmm.com
+ **
+ ** This program is free software; you can redistribute it and/or
+ ** modify it under the terms of the GNU Lesser General Public
+ ** License as published by the Free Software Foundation; either
+ ** version 2 of the License, or (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ ** Lesser General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Lesser General Public
+ ** License along with this library; if not, write to the Free Software
+ ** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ ***************************************************************************************/
+
+#include <QHash>
+#include <QString>
+
+#include <cstring>
+
+/**
+ * @brief The ObjectId class stores a Git SHA-1 in its binary form (20 bytes) instead of the 40 chars hexadecimal
+ * string. It's the key used by the cache and the lanes: the hexadecimal representation is only built when a view
+ * needs to show it.
+ *
+ * A default constructed id is null and it's different from the all-zeros id used by the WIP commit.
+ */
+class ObjectId
+{
+public:
+   static constexpr int RAW_SIZE = 20;
+   static constexpr int HEX_SIZE = 40;
+
+   ObjectId() = default;
+
+   /**
+    * @brief fromHex Builds the id from the 40 hexadecimal chars in @p data.
+    * @return A null id if @p data is not a full SHA-1.
+    */
+   static ObjectId fromHex(const char *data, int size)
+   {
+      ObjectId id;
+
+      if (size != HEX_SIZE)
+         return id;
+
+      for (auto i = 0; i < RAW_SIZE; ++i)
+      {
+         const auto high = hexValue(data[2 * i]);
+         const auto low = hexValue(data[2 * i + 1]);
+
+         if (high < 0 || low < 0)
+            return ObjectId();
+
+         id.mData[i] = static_cast<uchar>((high << 4) | low);
+      }
+
+      id.mValid = true;
+
+      return id;
+   }
+
+   static ObjectId fromString(const QString &sha)
+   {
+      ObjectId id;
+
+      if (sha.length() != HEX_SIZE)
+         return id;
+
+      for (auto i = 0; i < RAW_SIZE; ++i)
+      {
+         const auto high = hexValue(sha.at(2 * i).unicode());
+         const auto low = hexValue(sha.at(2 * i + 1).unicode());
+
+         if (high < 0 || low < 0)
+            return ObjectId();
+
+         id.mData[i] = static_cast<uchar>((high << 4) | low);
+      }
+
+      id.mValid = true;
+
+      return id;
+   }
+
+   /**
+    * @brief fromRawData Builds the id from the 20 bytes in @p data.
+    */
+   static ObjectId fromRawData(const uchar *data)
+   {
+      ObjectId id;
+      memcpy(id.mData, data, RAW_SIZE);
+      id.mValid = true;
+
+      return id;
+   }
+
+   /**
+    * @brief fromHexPrefix Builds the smallest id that starts with the abbreviated SHA @p prefix. It's used as the
+    * lower bound when searching abbreviated SHAs in a sorted list of ids.
+    * @return A null id if @p prefix is empty or it's not hexadecimal.
+    */
+   static ObjectId fromHexPrefix(const QString &prefix)
+   {
+      ObjectId id;
+
+      if (prefix.isEmpty() || prefix.length() > HEX_SIZE)
+         return id;
+
+      for (auto i = 0; i < prefix.length(); ++i)
+      {
+         const auto nibble = hexValue(prefix.at(i).unicode());
+
+         if (nibble < 0)
+            return ObjectId();
+
+         id.mData[i / 2] |= static_cast<uchar>(i % 2 == 0 ? nibble << 4 : nibble);
+      }
+
+      id.mValid = true;
+
+      return id;
+   }
+
+   bool isNull() const { return !mValid; }
+
+   QString toString() const
+   {
+      if (!mValid)
+         return QString();
+
+      QString sha(HEX_SIZE, Qt::Uninitialized);
+      const auto out = sha.data();
+
+      for (auto i = 0; i < RAW_SIZE; ++i)
+      {
+         out[2 * i] = QLatin1Char(HEX_DIGITS[mData[i] >> 4]);
+         out[2 * i + 1] = QLatin1Char(HEX_DIGITS[mData[i] & 0xf]);
+      }
+
+      return sha;
+   }
+
+   /**
+    * @brief startsWith Checks if the hexadecimal form of the id starts with @p prefix. The comparison is case
+    * insensitive and doesn't allocate.
+    */
+   bool startsWith(const QString &prefix) const
+   {
+      if (!mValid || prefix.length() > HEX_SIZE)
+         return false;
+
+      for (auto i = 0; i < prefix.length(); ++i)
+      {
+         const auto nibble = (i % 2 == 0) ? (mData[i / 2] >> 4) : (mData[i / 2] & 0xf);
+
+         if (hexValue(prefix.at(i).unicode()) != nibble)
+            return false;
+      }
+
+      return true;
+   }
+
+   const uchar *constData() const { return mData; }
+
+   bool operator==(const ObjectId &other) const
+   {
+      return mValid == other.mValid && memcmp(mData, other.mData, RAW_SIZE) == 0;
+   }
+   bool operator!=(const ObjectId &other) const { return !(*this == other); }
+   bool operator<(const ObjectId &other) const
+   {
+      if (mValid != other.mValid)
+         return !mValid;
+
+      return memcmp(mData, other.mData, RAW_SIZE) < 0;
+   }
+
+private:
+   static constexpr const char *HEX_DIGITS = "0123456789abcdef";
+
+   uchar mData[RAW_SIZE] {};
+   bool mValid = false;
+
+   static int hexValue(ushort c)
+   {
+      if (c >= '0' && c <= '9')
+         return c - '0';
+      if (c >= 'a' && c <= 'f')
+         return c - 'a' + 10;
+      if (c >= 'A' && c <= 'F')
+         return c - 'A' + 10;
+
+      return -1;
+   }
+};
+
+Q_DECLARE_TYPEINFO(ObjectId, Q_PRIMITIVE_TYPE);
+
+/**
+ * @brief qHash The SHA-1 is already uniformly distributed so the first bytes are used as they are.
+ */
+inline uint qHash(const ObjectId &id, uint seed = 0)
+{
+   uint hash;
+   memcpy(&hash, id.constData(), sizeof(hash));
+
+   return hash ^ seed;
+}
@@ -0,0 +1,82 @@
+#include "ReferencesIndex.h"
+
+void ReferencesIndex::insert(const ObjectId &sha, References::Type type, const QString &name)
+{
+   const auto internedName = intern(name);
+   auto &shasOfReferences = shasOfType(type);
+
+   if (const auto oldSha = shasOfReferences.value(internedName); !oldSha.isNull() && oldSha != sha)
+      remove(oldSha, type, internedName);
+
+   mReferencesOfSha[sha].addReference(type, internedName);
+   shasOfReferences.insert(internedName, sha);
+}
+
+void ReferencesIndex::remove(const ObjectId &sha, References::Type type, const QString &name)
+{
+   if (const auto iter = mReferencesOfSha.find(sha); iter != mReferencesOfSha.end())
+   {
+      iter->removeReference(type, name);
+
+      if (iter->isEmpty())
+         mReferencesOfSha.erase(iter);
+   }
+
+   auto &shasOfReferences = shasOfType(type);
+
+   if (const auto iter = shasOfReferences.find(name); iter != shasOfReferences.end() && *iter == sha)
+      shasOfReferences.erase(iter);
+}
+
+ObjectId ReferencesIndex::sha(References::Type type, const QString &name) const
+{
+   return shas(type).value(name);
+}
+
+QMap<QString, QString> ReferencesIndex::referencesOfType(References::Type type) const
+{
+   QMap<QString, QString> references;
+   const auto &shasOfReferences = shas(type);
+
+   for (auto iter = shasOfReferences.cbegin(); iter != shasOfReferences.cend(); ++iter)
+      references.insert(iter.key(), iter.value().toString());
+
+   return references;
+}
+
+QVector<QPair<QString, QStringList>> ReferencesIndex::shasWithReferences(References::Type type) const
+{
+   QVector<QPair<QString, QStringList>> shas;
+   shas.reserve(mReferencesOfSha.count());
+
+   for (auto iter = mReferencesOfSha.cbegin(); iter != mReferencesOfSha.cend(); ++iter)
+   {
+      if (const auto references = iter->getReferences(type); !references.isEmpty())
+         shas.append(qMakePair(iter.key().toString(), references));
+   }
+
+   return shas;
+}
+
+void ReferencesIndex::clear()
+{
+   mReferencesOfSha.clear();
+   mReferencesOfSha.squeeze();
+
+   for (auto &shas : mShaOfReference)
+   {
+      shas.clear();
+      shas.squeeze();
+   }
+
+   mNames.clear();
+   mNames.squeeze();
+}
+
+QString ReferencesIndex::intern(const QString &name)
+{
+   if (const auto iter = mNames.constFind(name); iter != mNames.cend())
+      return *iter;
+
+   return *mNames.insert(name);
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+/****************************************************************************************
+ ** GitQlient is an application to manage and operate one or several Git repositories. With
+ ** GitQlient you will be able to add commits, branches and manage all the options Git provides.
+ ** Copyright (C) 2021  Francesc Martinez
+ **
+ ** LinkedIn: www.linkedin.com/in/cescmm/
+ ** Web: www.francescmm.com
+ **
+ ** This program is free software; you can redistribute it and/or
+ ** modify it under the terms of the GNU Lesser General Public
+ ** License as published by the Free Software Foundation; either
+ ** version 2 of the License, or (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ ** Lesser General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Lesser General Public
+ ** License along with this library; if not, write to the Free Software
+ ** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ ***************************************************************************************/
+
+
+#include <ObjectId.h>
+#include <References.h>
+
+#include <QHash>
+#include <QMap>
+#include <QSet>
+
+#include <array>
+
+/**
+ * @brief The ReferencesIndex class stores the references of the repository indexed in both directions: the references
+ * that point to a commit and the commit a reference points to. Both lookups are done in constant time.
+ *
+ * The names are interned: the same name is shared by both indexes and by all the copies of the index. The containers
+ * are implicitly shared, so a copy of the index is a cheap snapshot that can be read without locking the cache.
+ */
+class ReferencesIndex
+{
+public:
+   /**
+    * @brief insert Adds the reference @p name of the given @p type pointing to @p sha. A reference points to a single
+    * commit: if it already pointed to another one it's moved.
+    */
+   void insert(const ObjectId &sha, References::Type type, const QString &name);
+
+   /**
+    * @brief remove Removes the reference @p name of the given @p type if it points to @p sha.
+    */
+   void remove(const ObjectId &sha, References::Type type, const QString &name);
+
+   /**
+    * @brief sha Returns the commit the reference @p name of the given @p type points to.
+    * @return A null id if there is no such reference.
+    */
+   ObjectId sha(References::Type type, const QString &name) const;
+
+   /**
+    * @brief references Returns the references that point to @p sha.
+    */
+   References references(const ObjectId &sha) const { return mReferencesOfSha.value(sha); }
+
+   /**
+    * @brief hasReferences Tells if any reference points to @p sha.
+    */
+   bool hasReferences(const ObjectId &sha) const { return mReferencesOfSha.contains(sha); }
+
+   /**
+    * @brief referencesOfType Returns all the references of the given @p type sorted by name.
+    * @return A map of the name of the reference to the SHA it points to.
+    */
+   QMap<QString, QString> referencesOfType(References::Type type) const;
+
+   /**
+    * @brief shas Returns the SHA each reference of the given @p type points to, indexed by the name of the reference.
+    */
+   const QHash<QString, ObjectId> &shas(References::Type type) const { return mShaOfReference[static_cast<int>(type)]; }
+
+   /**
+    * @brief shasWithReferences Returns the references of the given @p type grouped by the commit they point to.
+    */
+   QVector<QPair<QString, QStringList>> shasWithReferences(References::Type type) const;
+
+   void clear();
+
+private:
+   static constexpr int TYPES_COUNT = 4;
+
+   QHash<ObjectId, References> mReferencesOfSha;
+   std::array<QHash<QString, ObjectId>, TYPES_COUNT> mShaOfReference;
+   QSet<QString> mNames;
+
+   QString intern(const QString &name);
+   QHash<QString, ObjectId> &shasOfType(References::Type type) { return mShaOfReference[static_cast<int>(type)]; }
+};
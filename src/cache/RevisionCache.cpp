@@ -0,0 +1,87 @@
+#include "RevisionCache.h"
+
+#include <CommitInfo.h>
+
+namespace
+{
+// Memory used by every entry apart from its content
+const int ENTRY_OVERHEAD = 128;
+}
+
+RevisionCache::RevisionCache(int maxCost)
+   : mEntries(maxCost)
+{
+}
+
+std::optional<RevisionFiles> RevisionCache::files(const ObjectId &sha1, const ObjectId &sha2)
+{
+   if (const auto entry = find({ Kind::Files, sha1, sha2, QString() }))
+      return entry->files;
+
+   return std::nullopt;
+}
+
+void RevisionCache::insertFiles(const ObjectId &sha1, const ObjectId &sha2, const RevisionFiles &files)
+{
+   if (isStored(sha1, sha2))
+   {
+      const auto entry = new Entry { files, QByteArray() };
+
+      mEntries.insert({ Kind::Files, sha1, sha2, QString() }, entry, ENTRY_OVERHEAD + files.memorySize());
+   }
+}
+
+std::optional<QByteArray> RevisionCache::diff(const ObjectId &sha1, const ObjectId &sha2, const QString &file)
+{
+   if (const auto entry = find({ Kind::Diff, sha1, sha2, file }))
+      return entry->diff;
+
+   return std::nullopt;
+}
+
+void RevisionCache::insertDiff(const ObjectId &sha1, const ObjectId &sha2, const QString &file, const QByteArray &diff)
+{
+   if (isStored(sha1, sha2))
+   {
+      const auto cost = ENTRY_OVERHEAD + static_cast<int>(sizeof(QChar)) * file.size() + diff.size();
+
+      mEntries.insert({ Kind::Diff, sha1, sha2, file }, new Entry { RevisionFiles(), diff }, cost);
+   }
+}
+
+void RevisionCache::trim(int maxCost)
+{
+   // QCache removes the entries used least recently when its budget shrinks
+   const auto budget = mEntries.maxCost();
+
+   mEntries.setMaxCost(qMax(0, maxCost));
+   mEntries.setMaxCost(budget);
+}
+
+void RevisionCache::clear()
+{
+   mEntries.clear();
+}
+
+RevisionCache::Stats RevisionCache::stats() const
+{
+   return { mHits, mMisses, mEntries.count(), mEntries.totalCost() };
+}
+
+bool RevisionCache::isStored(const ObjectId &sha1, const ObjectId &sha2)
+{
+   return !sha1.isNull() && !sha2.isNull() && sha1 != CommitInfo::ZERO_ID && sha2 != CommitInfo::ZERO_ID;
+}
+
+RevisionCache::Entry *RevisionCache::find(const Key &key)
+{
+   // Looking an entry up makes it the most recently used
+   const auto entry = mEntries.object(key);
+
+   if (entry)
+      ++mHits;
+   else
+      ++mMisses;
+
+   return entry;
+}
@@ -0,0 +1,126 @@
+#pragma once
+
+/****************************************************************************************
+ ** GitQlient is an application to manage and operate one or several Git repositories. With
+ ** GitQlient you will be able to add commits, branches and manage all the options Git provides.
+ ** Copyright (C) 2021  Francesc Martinez
+ **
+ ** LinkedIn: www.linkedin.com/in/cescmm/
+ ** Web: www.francescmm.com
+ **
+ ** This program is free software; you can redistribute it and/or
+ ** modify it under the terms of the GNU Lesser General Public
+ ** License as published by the Free Software Foundation; either
+ ** version 2 of the License, or (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ ** Lesser General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Lesser General Public
+ ** License along with this library; if not, write to the Free Software
+ ** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ ***************************************************************************************/
+
+#include <ObjectId.h>
+#include <RevisionFiles.h>
+
+#include <QByteArray>
+#include <QCache>
+#include <QString>
+
+#include <optional>
+
+/**
+ * @brief The RevisionCache class stores what Git returns for the commits of the history that doesn't change: the files
+ * modified between two commits, the diff of every file and the full diff. All of them share a budget of bytes and the
+ * ones used least recently are removed when it's exceeded.
+ *
+ * The WIP changes all the time, so it's never stored here. The class is not thread safe.
+ */
+class RevisionCache
+{
+public:
+   struct Stats
+   {
+      int hits = 0;
+      int misses = 0;
+      int entries = 0;
+      int cost = 0;
+   };
+
+   /**
+    * @brief Default constructor.
+    * @param maxCost The budget of bytes of the cache.
+    */
+   explicit RevisionCache(int maxCost);
+
+   /**
+    * @brief files Returns the files modified between two commits.
+    * @return The files or nothing if they are not stored.
+    */
+   std::optional<RevisionFiles> files(const ObjectId &sha1, const ObjectId &sha2);
+   void insertFiles(const ObjectId &sha1, const ObjectId &sha2, const RevisionFiles &files);
+
+   /**
+    * @brief diff Returns the diff between two commits, as Git wrote it.
+    * @param file The file of the diff or an empty string for the full diff of the commits.
+    * @return The diff or nothing if it's not stored.
+    */
+   std::optional<QByteArray> diff(const ObjectId &sha1, const ObjectId &sha2, const QString &file);
+   void insertDiff(const ObjectId &sha1, const ObjectId &sha2, const QString &file, const QByteArray &diff);
+
+   /**
+    * @brief trim Removes the entries used least recently until the cache uses less than @p maxCost bytes. The budget
+    * of the cache doesn't change.
+    */
+   void trim(int maxCost);
+   void clear();
+
+   /**
+    * @brief maxCost Returns the budget of bytes of the cache.
+    */
+   int maxCost() const { return mEntries.maxCost(); }
+
+   Stats stats() const;
+
+private:
+   enum class Kind
+   {
+      Files,
+      Diff
+   };
+
+   struct Key
+   {
+      Kind kind;
+      ObjectId sha1;
+      ObjectId sha2;
+      QString file;
+
+      bool operator==(const Key &other) const
+      {
+         return kind == other.kind && sha1 == other.sha1 && sha2 == other.sha2 && file == other.file;
+      }
+
+      friend uint qHash(const Key &key, uint seed = 0)
+      {
+         return qHash(key.sha1, seed) ^ (qHash(key.sha2, seed) * 31U) ^ qHash(key.file, seed)
+             ^ static_cast<uint>(key.kind);
+      }
+   };
+
+   struct Entry
+   {
+      RevisionFiles files;
+      QByteArray diff;
+   };
+
+   QCache<Key, Entry> mEntries;
+   int mHits = 0;
+   int mMisses = 0;
+
+   static bool isStored(const ObjectId &sha1, const ObjectId &sha2);
+   Entry *find(const Key &key);
+};
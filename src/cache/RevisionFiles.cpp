@@ -70,6 +70,19 @@ bool RevisionFiles::operator!=(const RevisionFiles &revFiles) const
    return !(*this == revFiles);
 }
 
+int RevisionFiles::memorySize() const
+{
+   auto size = static_cast<int>(sizeof(int)) * (mergeParent.count() + mFileStatus.count());
+
+   for (const auto &file : mFiles)
+      size += static_cast<int>(sizeof(QString) + sizeof(QChar) * file.size());
+
+   for (const auto &file : mRenamedFiles)
+      size += static_cast<int>(sizeof(QString) + sizeof(QChar) * file.size());
+
+   return size;
+}
+
 bool RevisionFiles::statusCmp(int idx, RevisionFiles::StatusFlag sf) const
 {
    if (idx >= mFileStatus.count())
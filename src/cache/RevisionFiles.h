@@ -46,6 +46,10 @@ public:
    QString getFile(int index) const { return mFiles.at(index); }
    QStringList getFiles() const { return mFiles.toList(); }
    bool containsFile(const QString &fileName) { return mFiles.contains(fileName); }
+   /**
+    * @brief memorySize Returns an estimation of the bytes used by the files and their status.
+    */
+   int memorySize() const;
 
 private:
    // Status information is split in a flags vector and in a string
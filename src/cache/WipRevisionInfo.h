@@ -1,5 +1,7 @@
 #pragma once
 
+#include <ObjectId.h>
+
 #include <QString>
 
 struct WipRevisionInfo
@@ -10,3 +12,13 @@ struct WipRevisionInfo
 
    bool isValid() const { return !parentSha.isEmpty() || !diffIndex.isEmpty() || !diffIndexCached.isEmpty(); }
 };
+
+/**
+ * @brief The WipFileObjects struct stores the blobs that a file of the WIP has in HEAD and in the index. A null id
+ * means that the file is not there.
+ */
+struct WipFileObjects
+{
+   ObjectId head;
+   ObjectId index;
+};
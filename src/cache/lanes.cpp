@@ -8,9 +8,9 @@
 */
 #include "lanes.h"
 
-#include <QStringList>
+#include <algorithm>
 
-void Lanes::init(const QString &expectedSha)
+void Lanes::init(const ObjectId &expectedSha)
 {
    clear();
    activeLane = 0;
@@ -23,17 +23,18 @@ void Lanes::clear()
    typeVec.squeeze();
    nextShaVec.clear();
    nextShaVec.squeeze();
+   lanesOfSha.clear();
 }
 
-bool Lanes::isFork(const QString &sha, bool &isDiscontinuity)
+bool Lanes::isFork(const ObjectId &sha, bool &isDiscontinuity)
 {
-   int pos = findNextSha(sha, 0);
-   isDiscontinuity = activeLane != pos;
+   const auto lanes = lanesOfSha.value(sha);
+   isDiscontinuity = activeLane != lanes.first;
 
-   return pos == -1 ? false : findNextSha(sha, pos + 1) != -1;
+   return lanes.count > 1;
 }
 
-void Lanes::setFork(const QString &sha)
+void Lanes::setFork(const ObjectId &sha)
 {
    auto rangeEnd = 0;
    auto idx = 0;
@@ -79,7 +80,7 @@ void Lanes::setFork(const QString &sha)
    }
 }
 
-void Lanes::setMerge(const QStringList &parents)
+void Lanes::setMerge(const QVector<ObjectId> &parents)
 {
    auto &t = typeVec[activeLane];
    auto wasFork = t.equals(NODE);
@@ -92,7 +93,7 @@ void Lanes::setMerge(const QStringList &parents)
 
    auto rangeStart = activeLane;
    auto rangeEnd = activeLane;
-   QStringList::const_iterator it(parents.constBegin());
+   auto it = parents.constBegin();
 
    for (++it; it != parents.constEnd(); ++it)
    { // skip first parent
@@ -160,7 +161,7 @@ void Lanes::setInitial()
       t.setType(LaneType::INITIAL);
 }
 
-void Lanes::changeActiveLane(const QString &sha)
+void Lanes::changeActiveLane(const ObjectId &sha)
 {
    auto &t = typeVec[activeLane];
 
@@ -209,10 +210,7 @@ void Lanes::afterFork()
    }
 
    while (typeVec.last().equals(LaneType::EMPTY))
-   {
-      typeVec.pop_back();
-      nextShaVec.pop_back();
-   }
+      removeLastLane();
 }
 
 bool Lanes::isBranch()
@@ -228,22 +226,89 @@ void Lanes::afterBranch()
    typeVec[activeLane].setType(LaneType::ACTIVE);
 }
 
-void Lanes::nextParent(const QString &sha)
+void Lanes::nextParent(const ObjectId &sha)
+{
+   setNextSha(activeLane, sha);
+}
+
+void Lanes::replaceSha(const ObjectId &oldSha, const ObjectId &newSha)
 {
-   nextShaVec[activeLane] = sha;
+   std::replace(nextShaVec.begin(), nextShaVec.end(), oldSha, newSha);
+   indexLanes();
 }
 
-int Lanes::findNextSha(const QString &next, int pos)
+int Lanes::findNextSha(const ObjectId &next, int pos)
 {
-   for (int i = pos; i < nextShaVec.count(); i++)
+   const auto lanes = lanesOfSha.value(next);
+
+   if (lanes.count == 0)
+      return -1;
+
+   if (pos <= lanes.first)
+      return lanes.first;
+
+   // Only the forks have more than one lane waiting for the same sha1
+   if (lanes.count > 1)
    {
-      if (nextShaVec[i] == next)
-         return i;
+      for (int i = pos; i < nextShaVec.count(); i++)
+      {
+         if (nextShaVec[i] == next)
+            return i;
+      }
    }
 
    return -1;
 }
 
+void Lanes::setNextSha(int lane, const ObjectId &sha)
+{
+   const auto oldSha = nextShaVec.at(lane);
+
+   if (oldSha == sha)
+      return;
+
+   if (const auto oldLanes = lanesOfSha.find(oldSha); oldLanes != lanesOfSha.end())
+   {
+      if (--oldLanes->count == 0)
+         lanesOfSha.erase(oldLanes);
+      else if (oldLanes->first == lane)
+      {
+         oldLanes->first = static_cast<int>(std::find(nextShaVec.cbegin() + lane + 1, nextShaVec.cend(), oldSha)
+                                            - nextShaVec.cbegin());
+      }
+   }
+
+   nextShaVec[lane] = sha;
+
+   auto &lanes = lanesOfSha[sha];
+
+   if (lanes.count++ == 0 || lane < lanes.first)
+      lanes.first = lane;
+}
+
+void Lanes::removeLastLane()
+{
+   const auto sha = nextShaVec.takeLast();
+
+   typeVec.pop_back();
+
+   // The last lane is never the first one that waits for a sha1 if there are more
+   if (const auto lanes = lanesOfSha.find(sha); lanes != lanesOfSha.end() && --lanes->count == 0)
+      lanesOfSha.erase(lanes);
+}
+
+void Lanes::indexLanes()
+{
+   lanesOfSha.clear();
+
+   for (int i = nextShaVec.count() - 1; i >= 0; --i)
+   {
+      auto &lanes = lanesOfSha[nextShaVec.at(i)];
+      lanes.first = i;
+      ++lanes.count;
+   }
+}
+
 int Lanes::findType(const LaneType type, int pos)
 {
    const auto typeVecCount = typeVec.count();
@@ -257,7 +322,7 @@ int Lanes::findType(const LaneType type, int pos)
    return -1;
 }
 
-int Lanes::add(const LaneType type, const QString &next, int pos)
+int Lanes::add(const LaneType type, const ObjectId &next, int pos)
 {
    if (pos < typeVec.count())
    {
@@ -265,13 +330,19 @@ int Lanes::add(const LaneType type, const QString &next, int pos)
       if (pos != -1)
       {
          typeVec[pos].setType(type);
-         nextShaVec[pos] = next;
+         setNextSha(pos, next);
          return pos;
       }
    }
 
    typeVec.append(type);
    nextShaVec.append(next);
+
+   auto &lanes = lanesOfSha[next];
+
+   if (lanes.count++ == 0)
+      lanes.first = nextShaVec.count() - 1;
+
    return typeVec.count() - 1;
 }
 
@@ -7,11 +7,12 @@
 #ifndef LANES_H
 #define LANES_H
 
-#include <QString>
+#include <QHash>
 #include <QVector>
 
 #include <LaneType.h>
 #include <Lane.h>
+#include <ObjectId.h>
 
 //
 //  At any given time, the Lanes class represents a single revision (row) of the history graph.
@@ -23,36 +24,57 @@
 //
 //  The ListView class is responsible for rendering the glyphs.
 //
+//  The lanes that wait for each sha1 are also indexed, so finding the lane of a revision doesn't compare it with the
+//  hashes of all the lanes.
+//
 
 class Lanes
 {
 public:
    Lanes() = default;
    bool isEmpty() { return typeVec.empty(); }
-   void init(const QString &expectedSha);
+   void init(const ObjectId &expectedSha);
    void clear();
-   bool isFork(const QString &sha, bool &isDiscontinuity);
-   void setFork(const QString &sha);
-   void setMerge(const QStringList &parents);
+   bool isFork(const ObjectId &sha, bool &isDiscontinuity);
+   void setFork(const ObjectId &sha);
+   void setMerge(const QVector<ObjectId> &parents);
    void setInitial();
-   void changeActiveLane(const QString &sha);
+   void changeActiveLane(const ObjectId &sha);
    void afterMerge();
    void afterFork();
    bool isBranch();
    void afterBranch();
-   void nextParent(const QString &sha);
+   void nextParent(const ObjectId &sha);
+   void replaceSha(const ObjectId &oldSha, const ObjectId &newSha);
    void setLanes(QVector<Lane> &ln) { ln = typeVec; } // O(1) vector is implicitly shared
    QVector<Lane> getLanes() const { return typeVec; }
+   bool operator==(const Lanes &lanes) const
+   {
+      return activeLane == lanes.activeLane && typeVec == lanes.typeVec && nextShaVec == lanes.nextShaVec;
+   }
+   bool operator!=(const Lanes &lanes) const { return !(*this == lanes); }
 
 private:
-   int findNextSha(const QString &next, int pos);
+   friend class CommitGraphFile;
+
+   struct LanesOfSha
+   {
+      int first = -1;
+      int count = 0;
+   };
+
+   int findNextSha(const ObjectId &next, int pos);
+   void setNextSha(int lane, const ObjectId &sha);
+   void removeLastLane();
+   void indexLanes();
    int findType(LaneType type, int pos);
-   int add(LaneType type, const QString &next, int pos);
+   int add(LaneType type, const ObjectId &next, int pos);
    bool isNode(Lane lane) const;
 
-   int activeLane;
+   int activeLane = 0;
    QVector<Lane> typeVec; // Describes which glyphs should be drawn.
-   QVector<QString> nextShaVec; // The sha1 hashes of the next commit to appear in each lane (column).
+   QVector<ObjectId> nextShaVec; // The sha1 hashes of the next commit to appear in each lane (column).
+   QHash<ObjectId, LanesOfSha> lanesOfSha; // The first lane that waits for each sha1 and how many lanes wait for it.
    LaneType NODE = LaneType::MERGE_FORK;
    LaneType NODE_R = LaneType::MERGE_FORK_R;
    LaneType NODE_L = LaneType::MERGE_FORK_L;
@@ -59,7 +59,7 @@ void AmendWidget::configure(const QString &sha)
       const auto author = commit.author.split("<");
       ui->leAuthorName->setText(author.first());
       ui->leAuthorEmail->setText(author.last().mid(0, author.last().count() - 1));
-      ui->teDescription->setPlainText(commit.longLog.trimmed());
+      ui->teDescription->setPlainText(commit.longLog());
       ui->leCommitTitle->setText(commit.shortLog);
 
       blockSignals(true);
@@ -127,14 +127,14 @@ void AmendWidget::commitChanges()
             {
                const auto newSha = mGit->getLastCommit().output.trimmed();
                auto commit = mCache->commitInfo(mCurrentSha);
-               const auto oldSha = commit.sha;
-               commit.sha = newSha;
+               const auto oldSha = commit.sha();
+               commit.setSha(newSha);
                commit.committer = author;
                commit.author = author;
 
                const auto log = msg.split("\n\n");
                commit.shortLog = log.constFirst();
-               commit.longLog = log.constLast();
+               commit.setLongLog(log.constLast());
 
                mCache->updateCommit(oldSha, std::move(commit));
 
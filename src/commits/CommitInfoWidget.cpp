@@ -57,10 +57,10 @@ void CommitInfoWidget::configure(const QString &sha)
    {
       const auto commit = mCache->commitInfo(sha);
 
-      if (!commit.sha.isEmpty())
+      if (commit.isValid())
       {
          QLog_Info("UI", QString("Loading information of the commit {%1}").arg(sha));
-         mCurrentSha = commit.sha;
+         mCurrentSha = commit.sha();
          mParentSha = commit.firstParent();
 
          mInfoPanel->configure(commit);
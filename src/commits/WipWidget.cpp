@@ -91,7 +91,7 @@ void WipWidget::commitChanges()
 
                newCommit.committer = QString("%1<%2>").arg(committer.mUserName, committer.mUserEmail);
                newCommit.author = QString("%1<%2>").arg(committer.mUserName, committer.mUserEmail);
-               newCommit.longLog = ui->teDescription->toPlainText();
+               newCommit.setLongLog(ui->teDescription->toPlainText());
 
                mCache->insertCommit(newCommit);
                mCache->deleteReference(lastShaBeforeCommit, References::Type::LocalBranch, mGit->getCurrentBranch());
@@ -1,8 +1,10 @@
 INCLUDEPATH += $$PWD
 
 HEADERS += \
+    $$PWD/DiffEngine.h \
     $$PWD/DiffHelper.h \
     $$PWD/DiffInfo.h \
+    $$PWD/DiffLinesView.h \
     $$PWD/FileBlameWidget.h \
     $$PWD/FileDiffEditor.h \
     $$PWD/FileDiffHighlighter.h \
@@ -11,9 +13,14 @@ HEADERS += \
     $$PWD/FileEditor.h \
     $$PWD/FullDiffWidget.h \
     $$PWD/IDiffWidget.h \
-    $$PWD/LineNumberArea.h
+    $$PWD/LineNumberArea.h \
+    $$PWD/UnifiedDiff.h \
+    $$PWD/WordDiff.h \
+    $$PWD/WordDiffWorker.h
 
 SOURCES += \
+    $$PWD/DiffEngine.cpp \
+    $$PWD/DiffLinesView.cpp \
     $$PWD/FileBlameWidget.cpp \
     $$PWD/FileDiffEditor.cpp \
     $$PWD/FileDiffHighlighter.cpp \
@@ -22,4 +29,7 @@ SOURCES += \
     $$PWD/FileEditor.cpp \
     $$PWD/FullDiffWidget.cpp \
     $$PWD/IDiffWidget.cpp \
-    $$PWD/LineNumberArea.cpp
+    $$PWD/LineNumberArea.cpp \
+    $$PWD/UnifiedDiff.cpp \
+    $$PWD/WordDiff.cpp \
+    $$PWD/WordDiffWorker.cpp
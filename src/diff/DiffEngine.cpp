@@ -0,0 +1,311 @@
+#include "DiffEngine.h"
+
+#include <QHash>
+#include <QVector>
+
+#include <algorithm>
+#include <cstring>
+
+namespace
+{
+// Same amount of bytes Git reads to tell if a file is binary
+const int BINARY_CHECK_SIZE = 8000;
+// The edits are stored for every step of the algorithm, so files that need more are left to Git
+const int MAX_EDITS = 2000;
+
+struct Line
+{
+   const char *data = nullptr;
+   int size = 0;
+   uint hash = 0;
+};
+
+// The same chars git diff -w ignores
+bool isSpace(char c)
+{
+   return c == ' ' || c == '\t' || c == '\n' || c == '\v' || c == '\f' || c == '\r';
+}
+
+uint hashIgnoringSpaces(const char *begin, const char *end)
+{
+   // FNV-1a
+   uint hash = 2166136261U;
+
+   for (; begin < end; ++begin)
+   {
+      if (!isSpace(*begin))
+      {
+         hash ^= static_cast<uchar>(*begin);
+         hash *= 16777619U;
+      }
+   }
+
+   return hash;
+}
+
+bool operator==(const Line &first, const Line &second)
+{
+   if (first.hash != second.hash)
+      return false;
+
+   auto firstCurrent = first.data;
+   auto secondCurrent = second.data;
+   const auto firstEnd = first.data + first.size;
+   const auto secondEnd = second.data + second.size;
+
+   while (true)
+   {
+      while (firstCurrent < firstEnd && isSpace(*firstCurrent))
+         ++firstCurrent;
+
+      while (secondCurrent < secondEnd && isSpace(*secondCurrent))
+         ++secondCurrent;
+
+      if (firstCurrent == firstEnd || secondCurrent == secondEnd)
+         return firstCurrent == firstEnd && secondCurrent == secondEnd;
+
+      if (*firstCurrent++ != *secondCurrent++)
+         return false;
+   }
+}
+
+uint qHash(const Line &line, uint seed = 0)
+{
+   return line.hash ^ seed;
+}
+
+// The lines are split with memchr, that is vectorized by the C library
+QVector<Line> splitLines(const QByteArray &content)
+{
+   QVector<Line> lines;
+   auto current = content.constData();
+   const auto end = current + content.size();
+
+   while (current < end)
+   {
+      auto lineEnd = static_cast<const char *>(memchr(current, '\n', static_cast<size_t>(end - current)));
+
+      if (!lineEnd)
+         lineEnd = end;
+
+      lines.append({ current, static_cast<int>(lineEnd - current), hashIgnoringSpaces(current, lineEnd) });
+      current = lineEnd + 1;
+   }
+
+   return lines;
+}
+
+QVector<int> internLines(const QVector<Line> &lines, QHash<Line, int> &ids)
+{
+   QVector<int> lineIds;
+   lineIds.reserve(lines.count());
+
+   for (const auto &line : lines)
+   {
+      auto iter = ids.find(line);
+
+      if (iter == ids.end())
+         iter = ids.insert(line, ids.count());
+
+      lineIds.append(*iter);
+   }
+
+   return lineIds;
+}
+
+void appendLine(QByteArray &diff, char prefix, const Line &line)
+{
+   diff.append(prefix);
+   diff.append(line.data, line.size);
+   diff.append('\n');
+}
+}
+
+namespace DiffEngine
+{
+bool isBinary(const QByteArray &content)
+{
+   return memchr(content.constData(), '\0', static_cast<size_t>(qMin(content.size(), BINARY_CHECK_SIZE))) != nullptr;
+}
+
+bool matchSequences(const QVector<int> &first, const QVector<int> &second, QVector<QPair<int, int>> &matches)
+{
+   const auto firstCount = first.count();
+   const auto secondCount = second.count();
+   const auto maxEdits = qMin(firstCount + secondCount, MAX_EDITS);
+
+   // The furthest position in the first sequence for every diagonal, and a copy of the diagonals of every step
+   QVector<int> furthest(2 * maxEdits + 3, 0);
+   QVector<QVector<int>> steps;
+   const auto offset = maxEdits + 1;
+   auto edits = -1;
+
+   for (auto step = 0; step <= maxEdits && edits == -1; ++step)
+   {
+      for (auto diagonal = -step; diagonal <= step; diagonal += 2)
+      {
+         const auto down = diagonal == -step
+             || (diagonal != step && furthest.at(offset + diagonal - 1) < furthest.at(offset + diagonal + 1));
+         auto x = down ? furthest.at(offset + diagonal + 1) : furthest.at(offset + diagonal - 1) + 1;
+         auto y = x - diagonal;
+
+         while (x < firstCount && y < secondCount && first.at(x) == second.at(y))
+         {
+            ++x;
+            ++y;
+         }
+
+         furthest[offset + diagonal] = x;
+
+         if (x >= firstCount && y >= secondCount)
+         {
+            edits = step;
+            break;
+         }
+      }
+
+      steps.append(furthest.mid(offset - step, 2 * step + 1));
+   }
+
+   if (edits == -1)
+      return false;
+
+   auto x = firstCount;
+   auto y = secondCount;
+
+   // The path is followed backwards from the end
+   for (auto step = edits; step > 0; --step)
+   {
+      const auto &previous = steps.at(step - 1);
+      const auto at = [&previous, step](int diagonal) { return previous.at(diagonal + step - 1); };
+      const auto diagonal = x - y;
+      const auto down = diagonal == -step || (diagonal != step && at(diagonal - 1) < at(diagonal + 1));
+      const auto previousDiagonal = down ? diagonal + 1 : diagonal - 1;
+      const auto previousX = at(previousDiagonal);
+      const auto previousY = previousX - previousDiagonal;
+
+      while (x > previousX && y > previousY)
+         matches.append({ --x, --y });
+
+      x = previousX;
+      y = previousY;
+   }
+
+   while (x > 0 && y > 0)
+      matches.append({ --x, --y });
+
+   std::reverse(matches.begin(), matches.end());
+
+   return true;
+}
+
+std::optional<QString> fullContextDiff(const QByteArray &oldContent, const QByteArray &newContent)
+{
+   if (isBinary(oldContent) || isBinary(newContent))
+      return std::nullopt;
+
+   const auto oldLines = splitLines(oldContent);
+   const auto newLines = splitLines(newContent);
+
+   QHash<Line, int> ids;
+   ids.reserve(oldLines.count() + newLines.count());
+
+   const auto oldIds = internLines(oldLines, ids);
+   const auto newIds = internLines(newLines, ids);
+
+   auto prefix = 0;
+   auto suffix = 0;
+
+   while (prefix < oldIds.count() && prefix < newIds.count() && oldIds.at(prefix) == newIds.at(prefix))
+      ++prefix;
+
+   while (suffix < oldIds.count() - prefix && suffix < newIds.count() - prefix
+          && oldIds.at(oldIds.count() - suffix - 1) == newIds.at(newIds.count() - suffix - 1))
+      ++suffix;
+
+   // The lines that don't exist in the other version can't match, so they're left out of the algorithm
+   QVector<bool> inOld(ids.count(), false);
+   QVector<bool> inNew(ids.count(), false);
+
+   for (auto i = prefix; i < oldIds.count() - suffix; ++i)
+      inOld[oldIds.at(i)] = true;
+
+   for (auto i = prefix; i < newIds.count() - suffix; ++i)
+      inNew[newIds.at(i)] = true;
+
+   QVector<int> oldCandidates;
+   QVector<int> newCandidates;
+
+   for (auto i = prefix; i < oldIds.count() - suffix; ++i)
+   {
+      if (inNew.at(oldIds.at(i)))
+         oldCandidates.append(i);
+   }
+
+   for (auto i = prefix; i < newIds.count() - suffix; ++i)
+   {
+      if (inOld.at(newIds.at(i)))
+         newCandidates.append(i);
+   }
+
+   QVector<int> oldSequence;
+   QVector<int> newSequence;
+   oldSequence.reserve(oldCandidates.count());
+   newSequence.reserve(newCandidates.count());
+
+   for (const auto line : qAsConst(oldCandidates))
+      oldSequence.append(oldIds.at(line));
+
+   for (const auto line : qAsConst(newCandidates))
+      newSequence.append(newIds.at(line));
+
+   QVector<QPair<int, int>> candidateMatches;
+
+   if (!matchSequences(oldSequence, newSequence, candidateMatches))
+      return std::nullopt;
+
+   QVector<QPair<int, int>> matches;
+   matches.reserve(prefix + candidateMatches.count() + suffix + 1);
+
+   for (auto i = 0; i < prefix; ++i)
+      matches.append({ i, i });
+
+   for (const auto &match : qAsConst(candidateMatches))
+      matches.append({ oldCandidates.at(match.first), newCandidates.at(match.second) });
+
+   for (auto i = suffix; i > 0; --i)
+      matches.append({ oldIds.count() - i, newIds.count() - i });
+
+   if (matches.count() == oldLines.count() && matches.count() == newLines.count())
+      return QString();
+
+   // The end of both versions closes the last change
+   matches.append({ oldLines.count(), newLines.count() });
+
+   QByteArray diff;
+   diff.reserve(oldContent.size() + newContent.size() + 2 * (oldLines.count() + newLines.count()));
+
+   auto oldLine = 0;
+   auto newLine = 0;
+
+   // Like Git, the deleted lines of a change go first and the lines that match are taken from the old version
+   for (const auto &match : qAsConst(matches))
+   {
+      for (; oldLine < match.first; ++oldLine)
+         appendLine(diff, '-', oldLines.at(oldLine));
+
+      for (; newLine < match.second; ++newLine)
+         appendLine(diff, '+', newLines.at(newLine));
+
+      if (oldLine < oldLines.count())
+         appendLine(diff, ' ', oldLines.at(oldLine));
+
+      ++oldLine;
+      ++newLine;
+   }
+
+   diff.chop(1);
+
+   return QString::fromUtf8(diff);
+}
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+/****************************************************************************************
+ ** GitQlient is an application to manage and operate one or several Git repositories. With
+ ** GitQlient you will be able to add commits, branches and manage all the options Git provides.
+ ** Copyright (C) 2021  Francesc Martinez
+ **
+ ** LinkedIn: www.linkedin.com/in/cescmm/
+ ** Web: www.francescmm.com
+ **
+ ** This program is free software; you can redistribute it and/or
+ ** modify it under the terms of the GNU Lesser General Public
+ ** License as published by the Free Software Foundation; either
+ ** version 2 of the License, or (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ ** Lesser General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Lesser General Public
+ ** License along with this library; if not, write to the Free Software
+ ** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ ***************************************************************************************/
+
+
+#include <QByteArray>
+#include <QPair>
+#include <QString>
+#include <QVector>
+
+#include <optional>
+
+/**
+ * @brief The DiffEngine namespace compares two versions of a file without running Git. It's used for the files of the
+ * WIP, whose versions are already in the working directory or in the index, and it produces the same lines git diff -w
+ * does with the whole file as context, so DiffHelper can process them in the same way.
+ *
+ * The lines are interned into ids that ignore the whitespace and the lines that only exist in one version are left out
+ * before running the Myers algorithm on the rest.
+ */
+namespace DiffEngine
+{
+/**
+ * @brief isBinary Tells if @p content is binary in the same way Git does: if there is a NUL byte in its first 8000
+ * bytes.
+ */
+bool isBinary(const QByteArray &content);
+
+/**
+ * @brief matchSequences Runs the Myers algorithm on two sequences of ids.
+ * @param first The first sequence.
+ * @param second The second sequence.
+ * @param matches The pairs of positions that have the same id in both sequences, in order.
+ * @return False if the sequences are too different to be compared in a reasonable time.
+ */
+bool matchSequences(const QVector<int> &first, const QVector<int> &second, QVector<QPair<int, int>> &matches);
+
+/**
+ * @brief fullContextDiff Compares two versions of a file line by line ignoring the whitespace.
+ * @param oldContent The content of the old version.
+ * @param newContent The content of the new version.
+ * @return The lines of both versions with their prefix (' ', '-' or '+') and without the headers of git diff. It's
+ * empty if there are no changes and nothing if any version is binary or they are too different to be compared in a
+ * reasonable time.
+ */
+std::optional<QString> fullContextDiff(const QByteArray &oldContent, const QByteArray &newContent);
+}
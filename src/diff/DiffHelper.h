@@ -24,6 +24,8 @@
  ***************************************************************************************/
 
 #include <DiffInfo.h>
+#include <DiffLinesView.h>
+#include <UnifiedDiff.h>
 
 #include <QStringList>
 #include <QPair>
@@ -41,79 +43,55 @@ struct DiffChange
    QString oldFileName;
    int oldFileStartLine;
    QString header;
-   QString content;
+   /**
+    * @brief diff The diff the change belongs to. All the changes share it, so the lines of the hunk are not copied.
+    */
+   UnifiedDiff diff;
+   /**
+    * @brief hunk The hunk of the change in @ref diff, or -1 if the file has no hunks.
+    */
+   int hunk = -1;
    QPair<QStringList, QVector<ChunkDiffInfo::ChunkInfo>> oldData;
    QPair<QStringList, QVector<ChunkDiffInfo::ChunkInfo>> newData;
 };
 
-inline void extractLinesFromHeader(QString header, int &startOldFile, int &startNewFile)
-{
-   header = header.split(" @@ ").first();
-   header.remove("@");
-   header = header.trimmed();
-   auto modifications = header.split(" ");
-   startOldFile = std::abs(modifications.first().split(",").first().toInt());
-   startNewFile = std::abs(modifications.last().split(",").first().toInt());
-}
-
-inline QVector<DiffChange> splitDiff(const QString &diff)
+/**
+ * @brief splitDiff Splits the output of git diff in one change per hunk. The files without hunks, like the binary
+ * ones, are one change without content.
+ * @param diff The output of Git as it was read: it's parsed without decoding it.
+ */
+inline QVector<DiffChange> splitDiff(const QByteArray &diff)
 {
    QVector<DiffHelper::DiffChange> changes;
 
-#if QT_VERSION >= QT_VERSION_CHECK(5, 14, 0)
-   const auto flag = Qt::SkipEmptyParts;
-#else
-   const auto flag = QString::SkipEmptyParts;
-#endif
-
-   const auto chunks = diff.split("diff --git", flag);
+   const auto unifiedDiff = UnifiedDiff::parse(diff);
+   const auto &hunks = unifiedDiff.hunks();
 
-   for (const auto &chunk : chunks)
+   for (const auto &file : unifiedDiff.files())
    {
-      auto lines = chunk.split("\n");
       DiffHelper::DiffChange change;
+      change.oldFileName = unifiedDiff.text(file.oldName);
+      change.newFileName = unifiedDiff.text(file.newName);
+      change.oldFileStartLine = 0;
+      change.newFileStartLine = 0;
+      change.diff = unifiedDiff;
 
-      auto filesStr = lines.takeFirst();
-      auto files = filesStr.trimmed().split(" ");
-      change.newFileName = files.first().remove("a/");
-      change.oldFileName = files.last().remove("b/");
+      if (file.hunkCount == 0)
+         changes.append(change);
 
-      auto isA = lines.constFirst().startsWith("copy ") || lines.constFirst().startsWith("index ")
-          || lines.constFirst().startsWith("new ");
-      auto isB = lines.constFirst().startsWith("old ") || lines.constFirst().startsWith("rename ")
-          || lines.constFirst().startsWith("similarity ");
-      auto isC = lines.constFirst().startsWith("+++ ") || lines.constFirst().startsWith("--- ");
-
-      while (isA || isB || isC)
+      for (auto i = file.firstHunk; i < file.firstHunk + file.hunkCount; ++i)
       {
-         lines.takeFirst();
+         const auto &hunk = hunks.at(i);
 
-         isA = lines.constFirst().startsWith("copy ") || lines.constFirst().startsWith("index ")
-             || lines.constFirst().startsWith("new ");
-         isB = lines.constFirst().startsWith("old ") || lines.constFirst().startsWith("rename ")
-             || lines.constFirst().startsWith("similarity ");
-         isC = lines.constFirst().startsWith("+++ ") || lines.constFirst().startsWith("--- ");
-      }
+         change.header = unifiedDiff.text(hunk.header);
+         change.hunk = i;
+         change.oldFileStartLine = hunk.oldStart;
+         change.newFileStartLine = hunk.newStart;
 
-      for (auto &line : lines)
-      {
-         if (line.startsWith("@@"))
-         {
-            if (!change.content.isEmpty())
-            {
-               changes.append(change);
-               change.content.clear();
-            }
-
-            change.header = line;
-            extractLinesFromHeader(change.header, change.oldFileStartLine, change.newFileStartLine);
-         }
-         else
-            change.content.append(line + "\n");
+         changes.append(change);
       }
-
-      changes.append(change);
    }
+
    return changes;
 }
 
@@ -125,13 +103,21 @@ inline DiffInfo processDiff(const QString &text, QPair<QStringList, QVector<Chun
    int oldFileRow = 1;
    int newFileRow = 1;
 
-   const auto lines = text.split("\n");
-   for (auto line : lines)
+   // The lines are read in place: only the text without the prefix is copied in the lists of each file
+   for (auto start = 0; start <= text.length();)
    {
-      if (line.startsWith('-'))
-      {
-         line.remove(0, 1);
+      auto end = text.indexOf('\n', start);
 
+      if (end == -1)
+         end = text.length();
+
+      const auto prefix = start < end ? text.at(start) : QChar();
+      const auto line = start < end ? text.mid(start + 1, end - start - 1) : QString();
+
+      start = end + 1;
+
+      if (prefix == '-')
+      {
          if (diff.oldFile.startLine == -1)
             diff.oldFile.startLine = oldFileRow;
 
@@ -139,10 +125,8 @@ inline DiffInfo processDiff(const QString &text, QPair<QStringList, QVector<Chun
 
          ++oldFileRow;
       }
-      else if (line.startsWith('+'))
+      else if (prefix == '+')
       {
-         line.remove(0, 1);
-
          if (diff.newFile.startLine == -1)
          {
             diff.newFile.startLine = newFileRow;
@@ -155,8 +139,6 @@ inline DiffInfo processDiff(const QString &text, QPair<QStringList, QVector<Chun
       }
       else
       {
-         line.remove(0, 1);
-
          if (diff.oldFile.startLine != -1)
             diff.oldFile.endLine = oldFileRow - 1;
 
@@ -184,13 +166,105 @@ inline DiffInfo processDiff(const QString &text, QPair<QStringList, QVector<Chun
       }
    }
 
-   diffInfo.fullDiff = lines;
    diffInfo.newFileDiff = newFileData.first;
    diffInfo.oldFileDiff = oldFileData.first;
 
    return diffInfo;
 }
 
+/**
+ * @brief processDiff Splits the lines of the hunk @p hunk of @p diff in the old and the new file, like the text
+ * version does. The lines are read from the spans of the diff: only the text of each line is decoded.
+ */
+inline DiffInfo processDiff(const UnifiedDiff &diff, int hunk,
+                            QPair<QStringList, QVector<ChunkDiffInfo::ChunkInfo>> &newFileData,
+                            QPair<QStringList, QVector<ChunkDiffInfo::ChunkInfo>> &oldFileData)
+{
+   DiffInfo diffInfo;
+   ChunkDiffInfo chunk;
+   int oldFileRow = 1;
+   int newFileRow = 1;
+
+   const auto closeChunk = [&]() {
+      if (chunk.oldFile.startLine != -1)
+         chunk.oldFile.endLine = oldFileRow - 1;
+
+      if (chunk.newFile.startLine != -1)
+         chunk.newFile.endLine = newFileRow - 1;
+
+      if (chunk.isValid())
+      {
+         if (chunk.newFile.isValid())
+            newFileData.second.append(chunk.newFile);
+
+         if (chunk.oldFile.isValid())
+            oldFileData.second.append(chunk.oldFile);
+
+         diffInfo.chunks.append(chunk);
+      }
+
+      chunk = ChunkDiffInfo();
+   };
+
+   if (hunk >= 0 && hunk < diff.hunks().count())
+   {
+      const auto &info = diff.hunks().at(hunk);
+
+      for (auto i = info.firstLine; i < info.firstLine + info.lineCount; ++i)
+      {
+         const auto &line = diff.lines().at(i);
+
+         switch (line.type)
+         {
+            case UnifiedDiff::LineType::Deletion:
+               if (chunk.oldFile.startLine == -1)
+                  chunk.oldFile.startLine = oldFileRow;
+
+               oldFileData.first.append(diff.text(line.content));
+               ++oldFileRow;
+               break;
+            case UnifiedDiff::LineType::Addition:
+               if (chunk.newFile.startLine == -1)
+               {
+                  chunk.newFile.startLine = newFileRow;
+                  chunk.newFile.addition = true;
+               }
+
+               newFileData.first.append(diff.text(line.content));
+               ++newFileRow;
+               break;
+            case UnifiedDiff::LineType::Context:
+            {
+               closeChunk();
+
+               const auto text = diff.text(line.content);
+               oldFileData.first.append(text);
+               newFileData.first.append(text);
+
+               ++oldFileRow;
+               ++newFileRow;
+               break;
+            }
+            case UnifiedDiff::LineType::NoNewLine:
+               break;
+         }
+      }
+   }
+
+   closeChunk();
+
+   diffInfo.newFileDiff = newFileData.first;
+   diffInfo.oldFileDiff = oldFileData.first;
+
+   return diffInfo;
+}
+
+inline void findString(const QString &s, DiffLinesView *view, QWidget *managerWidget)
+{
+   if (!s.isEmpty() && !view->find(s) && !view->find(s, true))
+      QMessageBox::information(managerWidget, QObject::tr("Text not found"), QObject::tr("Text not found."));
+}
+
 inline void findString(const QString &s, QPlainTextEdit *textEdit, QWidget *managerWidget)
 {
    if (!s.isEmpty())
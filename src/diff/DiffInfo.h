@@ -70,7 +70,6 @@ struct ChunkDiffInfo
 
 struct DiffInfo
 {
-   QStringList fullDiff;
    QStringList newFileDiff;
    QStringList oldFileDiff;
    QVector<ChunkDiffInfo> chunks;
@@ -0,0 +1,476 @@
+#include "DiffLinesView.h"
+
+#include <GitQlientStyles.h>
+#include <LineNumberArea.h>
+
+#include <QApplication>
+#include <QClipboard>
+#include <QKeyEvent>
+#include <QMenu>
+#include <QMouseEvent>
+#include <QPaintEvent>
+#include <QPainter>
+#include <QScrollBar>
+#include <QTextOption>
+
+#include <algorithm>
+
+namespace
+{
+const int TEXT_MARGIN = 4;
+const int TAB_SIZE = 8;
+// How much darker the words that changed are painted than the rest of their line
+const int WORD_CHANGE_DARKNESS = 150;
+}
+
+DiffLinesView::DiffLinesView(QWidget *parent)
+   : QAbstractScrollArea(parent)
+{
+   setAttribute(Qt::WA_DeleteOnClose);
+   setContextMenuPolicy(Qt::CustomContextMenu);
+   setFocusPolicy(Qt::StrongFocus);
+   viewport()->setCursor(Qt::IBeamCursor);
+
+   connect(this, &DiffLinesView::customContextMenuRequested, this, &DiffLinesView::showContextMenu);
+   connect(verticalScrollBar(), &QScrollBar::valueChanged, this, &DiffLinesView::signalScrollChanged);
+}
+
+void DiffLinesView::addNumberArea(LineNumberArea *numberArea)
+{
+   mLineNumberArea = numberArea;
+
+   updateLineNumberArea();
+}
+
+void DiffLinesView::loadDiff(const QString &text, const QVector<ChunkDiffInfo::ChunkInfo> &fileDiffInfo)
+{
+   mText = text;
+   mFileDiffInfo = fileDiffInfo;
+   mLineStarts.clear();
+   mLineTypes.clear();
+   mLongestLine = -1;
+   mSelectionAnchor = -1;
+   mSelectionEnd = -1;
+   mMatch = Match();
+   mWordChanges.clear();
+
+   auto longest = -1;
+
+   for (auto start = 0;;)
+   {
+      auto end = mText.indexOf(QLatin1Char('\n'), start);
+
+      if (end == -1)
+         end = mText.length();
+
+      // A tab can take up to TAB_SIZE columns
+      const auto columns = end - start + (TAB_SIZE - 1) * mText.midRef(start, end - start).count(QLatin1Char('\t'));
+
+      if (columns > longest)
+      {
+         longest = columns;
+         mLongestLine = mLineStarts.count();
+      }
+
+      auto type = LineType::Context;
+
+      // Without chunks the text is a unified diff and its lines are coloured by their prefix
+      if (mFileDiffInfo.isEmpty() && start < end)
+      {
+         switch (mText.at(start).toLatin1())
+         {
+            case '@':
+               type = LineType::Header;
+               break;
+            case '+':
+               type = LineType::Addition;
+               break;
+            case '-':
+               type = LineType::Deletion;
+               break;
+            default:
+               break;
+         }
+      }
+
+      mLineStarts.append(start);
+      mLineTypes.append(type);
+
+      if (end == mText.length())
+         break;
+
+      start = end + 1;
+   }
+
+   for (const auto &chunk : qAsConst(mFileDiffInfo))
+   {
+      for (auto line = qMax(0, chunk.startLine - 1); line < chunk.endLine && line < mLineTypes.count(); ++line)
+         mLineTypes[line] = chunk.addition ? LineType::Addition : LineType::Deletion;
+   }
+
+   updateTextWidth();
+   updateScrollBars();
+   updateLineNumberArea();
+
+   viewport()->update();
+}
+
+void DiffLinesView::clear()
+{
+   loadDiff(QString());
+}
+
+void DiffLinesView::moveScrollBarToPos(int value)
+{
+   blockSignals(true);
+   verticalScrollBar()->setValue(value);
+   blockSignals(false);
+}
+
+bool DiffLinesView::find(const QString &text, bool fromStart)
+{
+   auto from = 0;
+
+   if (!fromStart)
+      from = mMatch.offset != -1 ? mMatch.offset + 1 : mLineStarts.value(firstVisibleLine(), 0);
+
+   const auto offset = mText.indexOf(text, from, Qt::CaseInsensitive);
+
+   if (offset == -1)
+      return false;
+
+   mMatch.offset = offset;
+   mMatch.size = text.length();
+
+   const auto line = lineOf(offset);
+   const auto visibleLines = verticalScrollBar()->pageStep();
+
+   if (line < firstVisibleLine() || line >= firstVisibleLine() + visibleLines)
+      verticalScrollBar()->setValue(line - visibleLines / 2);
+
+   const auto left = textAdvance(lineText(line).left(offset - mLineStarts.at(line)).toString());
+   const auto scroll = horizontalScrollBar()->value();
+
+   if (left < scroll || left > scroll + viewport()->width() - TEXT_MARGIN)
+      horizontalScrollBar()->setValue(left - viewport()->width() / 2);
+
+   viewport()->update();
+
+   return true;
+}
+
+void DiffLinesView::addWordChanges(int line, const QVector<WordDiff::Range> &ranges)
+{
+   if (line < 0 || line >= lineCount() || ranges.isEmpty())
+      return;
+
+   mWordChanges.insert(line, ranges);
+
+   if (firstVisibleLine() <= line && line <= lastVisibleLine())
+      viewport()->update();
+}
+
+int DiffLinesView::firstVisibleLine() const
+{
+   return verticalScrollBar()->value();
+}
+
+int DiffLinesView::lastVisibleLine() const
+{
+   return firstVisibleLine() + viewport()->height() / lineHeight();
+}
+
+int DiffLinesView::lineHeight() const
+{
+   return fontMetrics().lineSpacing();
+}
+
+int DiffLinesView::lineNumberAreaWidth() const
+{
+   const auto width = fontMetrics().horizontalAdvance(QLatin1Char('9'));
+   auto digits = mLineNumberArea ? mLineNumberArea->widthInDigitsSize() : 0;
+   auto max = lineCount();
+
+   while (max >= 10)
+   {
+      max /= 10;
+      ++digits;
+   }
+
+   return width * digits;
+}
+
+void DiffLinesView::paintEvent(QPaintEvent *event)
+{
+   QPainter painter(viewport());
+
+   const auto height = lineHeight();
+   const auto rect = event->rect();
+   const auto scroll = horizontalScrollBar()->value();
+   const auto left = TEXT_MARGIN - scroll;
+   const auto textWidth = horizontalScrollBar()->maximum() + viewport()->width();
+   const auto spaceWidth = qMax(1, fontMetrics().horizontalAdvance(QLatin1Char(' ')));
+   // The lines are cut where they stop being visible, so a minified file doesn't lay out all its text
+   const auto maxColumns = 2 * (scroll + viewport()->width()) / spaceWidth + 1;
+   const auto selectionStart = qMin(mSelectionAnchor, mSelectionEnd);
+   const auto selectionEnd = qMax(mSelectionAnchor, mSelectionEnd);
+   const auto matchLine = mMatch.offset != -1 ? lineOf(mMatch.offset) : -1;
+   const auto green = GitQlientStyles::getGreen();
+   const auto red = GitQlientStyles::getRed();
+   const auto orange = GitQlientStyles::getOrange();
+   const auto selection = GitQlientStyles::getGraphSelectionColor();
+
+   auto boldFont = font();
+   boldFont.setWeight(QFont::ExtraBold);
+
+   QTextOption option(Qt::AlignLeft | Qt::AlignVCenter);
+   option.setWrapMode(QTextOption::NoWrap);
+   option.setTabStopDistance(spaceWidth * TAB_SIZE);
+
+   painter.setPen(GitQlientStyles::getTextColor());
+
+   for (auto line = firstVisibleLine(), top = 0; line < lineCount() && top <= rect.bottom(); ++line, top += height)
+   {
+      if (top + height < rect.top())
+         continue;
+
+      const QRect lineRect(0, top, viewport()->width(), height);
+      const auto type = mLineTypes.at(line);
+
+      if (selectionStart != -1 && selectionStart <= line && line <= selectionEnd)
+         painter.fillRect(lineRect, selection);
+      else if (type == LineType::Addition)
+         painter.fillRect(lineRect, green);
+      else if (type == LineType::Deletion)
+         painter.fillRect(lineRect, red);
+      else if (type == LineType::Header)
+         painter.fillRect(lineRect, orange);
+
+      const auto text = lineText(line).left(maxColumns).toString();
+      const auto wordChanges = mWordChanges.constFind(line);
+
+      if (wordChanges != mWordChanges.cend() && (type == LineType::Addition || type == LineType::Deletion)
+          && !(selectionStart != -1 && selectionStart <= line && line <= selectionEnd))
+      {
+         const auto color = (type == LineType::Addition ? green : red).darker(WORD_CHANGE_DARKNESS);
+         // The ranges don't count the prefix of the unified diffs
+         const auto prefix = mFileDiffInfo.isEmpty() ? 1 : 0;
+
+         for (const auto &range : *wordChanges)
+         {
+            const auto column = range.start + prefix;
+
+            if (column >= text.length())
+               break;
+
+            const auto rangeLeft = left + textAdvance(text.left(column));
+            const auto rangeWidth = left + textAdvance(text.left(column + range.length)) - rangeLeft;
+
+            painter.fillRect(QRect(rangeLeft, top, rangeWidth, height), color);
+         }
+      }
+
+      if (line == matchLine)
+      {
+         const auto column = mMatch.offset - mLineStarts.at(line);
+         const auto matchLeft = left + textAdvance(text.left(column));
+         const auto matchWidth = left + textAdvance(text.left(column + mMatch.size)) - matchLeft;
+
+         painter.fillRect(QRect(matchLeft, top, matchWidth, height), palette().highlight());
+      }
+
+      painter.setFont(type == LineType::Header ? boldFont : font());
+      painter.drawText(QRectF(left, top, textWidth, height), text, option);
+   }
+}
+
+void DiffLinesView::resizeEvent(QResizeEvent *event)
+{
+   QAbstractScrollArea::resizeEvent(event);
+
+   updateScrollBars();
+   updateLineNumberArea();
+}
+
+void DiffLinesView::changeEvent(QEvent *event)
+{
+   QAbstractScrollArea::changeEvent(event);
+
+   if (event->type() == QEvent::FontChange)
+   {
+      updateTextWidth();
+      updateScrollBars();
+      updateLineNumberArea();
+
+      viewport()->update();
+   }
+}
+
+void DiffLinesView::scrollContentsBy(int, int dy)
+{
+   viewport()->update();
+
+   if (dy != 0 && mLineNumberArea)
+      mLineNumberArea->update();
+}
+
+void DiffLinesView::mousePressEvent(QMouseEvent *event)
+{
+   if (event->button() != Qt::LeftButton || lineCount() == 0)
+   {
+      QAbstractScrollArea::mousePressEvent(event);
+      return;
+   }
+
+   const auto line = qBound(0, lineAt(event->pos().y()), lineCount() - 1);
+
+   if (!event->modifiers().testFlag(Qt::ShiftModifier) || mSelectionAnchor == -1)
+      mSelectionAnchor = line;
+
+   mSelectionEnd = line;
+
+   viewport()->update();
+}
+
+void DiffLinesView::mouseMoveEvent(QMouseEvent *event)
+{
+   if (!event->buttons().testFlag(Qt::LeftButton) || mSelectionAnchor == -1)
+   {
+      QAbstractScrollArea::mouseMoveEvent(event);
+      return;
+   }
+
+   const auto y = event->pos().y();
+
+   if (y < 0)
+      verticalScrollBar()->triggerAction(QAbstractSlider::SliderSingleStepSub);
+   else if (y > viewport()->height())
+      verticalScrollBar()->triggerAction(QAbstractSlider::SliderSingleStepAdd);
+
+   mSelectionEnd = qBound(0, lineAt(y), lineCount() - 1);
+
+   viewport()->update();
+}
+
+void DiffLinesView::keyPressEvent(QKeyEvent *event)
+{
+   if (event->matches(QKeySequence::Copy))
+      copySelection();
+   else if (event->matches(QKeySequence::SelectAll))
+   {
+      mSelectionAnchor = 0;
+      mSelectionEnd = lineCount() - 1;
+
+      viewport()->update();
+   }
+   else
+      QAbstractScrollArea::keyPressEvent(event);
+}
+
+QStringRef DiffLinesView::lineText(int line) const
+{
+   const auto start = mLineStarts.at(line);
+   const auto end = line + 1 < mLineStarts.count() ? mLineStarts.at(line + 1) - 1 : mText.length();
+
+   return mText.midRef(start, end - start);
+}
+
+int DiffLinesView::lineAt(int y) const
+{
+   const auto line = firstVisibleLine() + (y < 0 ? -1 : y / lineHeight());
+
+   return line < lineCount() ? line : -1;
+}
+
+int DiffLinesView::lineOf(int offset) const
+{
+   const auto iter = std::upper_bound(mLineStarts.cbegin(), mLineStarts.cend(), offset);
+
+   return static_cast<int>(iter - mLineStarts.cbegin()) - 1;
+}
+
+void DiffLinesView::updateScrollBars()
+{
+   const auto visibleLines = qMax(1, viewport()->height() / lineHeight());
+
+   verticalScrollBar()->setRange(0, qMax(0, lineCount() - visibleLines));
+   verticalScrollBar()->setPageStep(visibleLines);
+   verticalScrollBar()->setSingleStep(1);
+
+   horizontalScrollBar()->setRange(0, qMax(0, mTextWidth + 2 * TEXT_MARGIN - viewport()->width()));
+   horizontalScrollBar()->setPageStep(viewport()->width());
+   horizontalScrollBar()->setSingleStep(fontMetrics().horizontalAdvance(QLatin1Char(' ')) * 2);
+}
+
+void DiffLinesView::updateTextWidth()
+{
+   // Only the line with more columns is measured
+   mTextWidth = mLongestLine == -1 ? 0 : textAdvance(lineText(mLongestLine).toString());
+}
+
+int DiffLinesView::textAdvance(const QString &text) const
+{
+   // The tabs move the text to the same stops it's painted with
+   const auto tabWidth = qMax(1, fontMetrics().horizontalAdvance(QLatin1Char(' '))) * TAB_SIZE;
+   auto advance = 0;
+   auto start = 0;
+
+   for (auto tab = text.indexOf(QLatin1Char('\t')); tab != -1; tab = text.indexOf(QLatin1Char('\t'), start))
+   {
+      advance += fontMetrics().horizontalAdvance(text.mid(start, tab - start));
+      advance = (advance / tabWidth + 1) * tabWidth;
+      start = tab + 1;
+   }
+
+   return advance + fontMetrics().horizontalAdvance(text.mid(start));
+}
+
+void DiffLinesView::updateLineNumberArea()
+{
+   if (!mLineNumberArea)
+      return;
+
+   const auto width = lineNumberAreaWidth();
+   const auto cr = contentsRect();
+
+   setViewportMargins(width, 0, 0, 0);
+
+   mLineNumberArea->setGeometry(QRect(cr.left(), cr.top(), width, cr.height()));
+   mLineNumberArea->update();
+}
+
+void DiffLinesView::copySelection() const
+{
+   if (mSelectionAnchor == -1)
+      return;
+
+   const auto first = qMin(mSelectionAnchor, mSelectionEnd);
+   const auto last = qMax(mSelectionAnchor, mSelectionEnd);
+   const auto lastText = lineText(last);
+   const auto start = mLineStarts.at(first);
+
+   QApplication::clipboard()->setText(mText.mid(start, lastText.position() + lastText.length() - start));
+}
+
+void DiffLinesView::showContextMenu(const QPoint &pos)
+{
+   QMenu menu(this);
+
+   const auto copy = menu.addAction(tr("Copy"));
+   copy->setEnabled(mSelectionAnchor != -1);
+   connect(copy, &QAction::triggered, this, &DiffLinesView::copySelection);
+
+   const auto row = lineAt(pos.y()) + 1;
+   const auto chunk = std::find_if(mFileDiffInfo.cbegin(), mFileDiffInfo.cend(),
+                                   [row](const ChunkDiffInfo::ChunkInfo &chunk) {
+                                      return chunk.startLine <= row && row <= chunk.endLine;
+                                   });
+
+   if (row > 0 && chunk != mFileDiffInfo.cend())
+   {
+      const auto stageChunk = menu.addAction(tr("Stage chunk"));
+      connect(stageChunk, &QAction::triggered, this, [this, chunkId = chunk->id]() { emit signalStageChunk(chunkId); });
+   }
+
+   menu.exec(viewport()->mapToGlobal(pos));
+}
@@ -0,0 +1,177 @@
+#pragma once
+
+/****************************************************************************************
+ ** GitQlient is an application to manage and operate one or several Git repositories. With
+ ** GitQlient you will be able to add commits, branches and manage all the options Git provides.
+ ** Copyright (C) 2021  Francesc Martinez
+ **
+ ** LinkedIn: www.linkedin.com/in/cescmm/
+ ** Web: www.francescmm.com
+ **
+ ** This program is free software; you can redistribute it and/or
+ ** modify it under the terms of the GNU Lesser General Public
+ ** License as published by the Free Software Foundation; either
+ ** version 2 of the License, or (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ ** Lesser General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Lesser General Public
+ ** License along with this library; if not, write to the Free Software
+ ** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ ***************************************************************************************/
+
+
+#include <DiffInfo.h>
+#include <WordDiff.h>
+
+#include <QAbstractScrollArea>
+#include <QHash>
+#include <QString>
+#include <QVector>
+
+class LineNumberArea;
+
+/**
+ * @brief The DiffLinesView class shows the text of a file diff without a QTextDocument. The text is kept as it comes
+ * and a table with the offset of every line is built when it's loaded: only the lines that are visible are painted,
+ * with the background of the additions and the deletions painted directly.
+ *
+ * The vertical scroll bar moves line by line, so scrolling and jumping to a chunk don't depend on the size of the file.
+ * The lines can be selected with the mouse and copied.
+ */
+class DiffLinesView : public QAbstractScrollArea
+{
+   Q_OBJECT
+
+signals:
+   /**
+    * @brief signalScrollChanged Signal emitted when the scrollbar changes its position.
+    * @param value The new scrollbar position.
+    */
+   void signalScrollChanged(int value);
+
+   /**
+    * @brief signalStageChunk Signal triggered when the user orders to stage a chunk.
+    * @param id The internal chunk id.
+    */
+   void signalStageChunk(const QString &id);
+
+public:
+   explicit DiffLinesView(QWidget *parent = nullptr);
+
+   void addNumberArea(LineNumberArea *numberArea);
+
+   /**
+    * @brief loadDiff Loads the text of a diff.
+    * @param text The text representing a diff.
+    * @param fileDiffInfo The chunks of the file. If it's empty, the lines are coloured by their diff prefix.
+    */
+   void loadDiff(const QString &text,
+                 const QVector<ChunkDiffInfo::ChunkInfo> &fileDiffInfo = QVector<ChunkDiffInfo::ChunkInfo>());
+
+   /**
+    * @brief clear Removes the text of the view.
+    */
+   void clear();
+
+   /**
+    * @brief moveScrollBarToPos Moves the vertical scroll bar to the value defined in @p value without notifying it.
+    * @param value The first visible line.
+    */
+   void moveScrollBarToPos(int value);
+
+   /**
+    * @brief find Finds the next occurrence of @p text, ignoring the case, and scrolls to it.
+    * @param fromStart If true, the search starts from the beginning instead of the previous occurrence.
+    * @return True if the text was found.
+    */
+   bool find(const QString &text, bool fromStart = false);
+
+   /**
+    * @brief lineCount Returns the number of lines of the text.
+    */
+   int lineCount() const { return mLineStarts.count(); }
+
+   /**
+    * @brief addWordChanges Highlights the chars of a changed line that are different in the line it's paired with.
+    * The highlights are removed when a new text is loaded.
+    * @param line The line of the view.
+    * @param ranges The chars that changed, without counting the diff prefix.
+    */
+   void addWordChanges(int line, const QVector<WordDiff::Range> &ranges);
+
+   /**
+    * @brief firstVisibleLine Returns the line shown at the top of the view.
+    */
+   int firstVisibleLine() const;
+
+   /**
+    * @brief lastVisibleLine Returns the line shown at the bottom of the view.
+    */
+   int lastVisibleLine() const;
+
+   /**
+    * @brief lineHeight Returns the height of a line in pixels.
+    */
+   int lineHeight() const;
+
+   /**
+    * @brief lineNumberAreaWidth Returns the width of the line number area.
+    */
+   int lineNumberAreaWidth() const;
+
+protected:
+   void paintEvent(QPaintEvent *event) override;
+   void resizeEvent(QResizeEvent *event) override;
+   void changeEvent(QEvent *event) override;
+   void scrollContentsBy(int dx, int dy) override;
+   void mousePressEvent(QMouseEvent *event) override;
+   void mouseMoveEvent(QMouseEvent *event) override;
+   void keyPressEvent(QKeyEvent *event) override;
+
+private:
+   enum class LineType : quint8
+   {
+      Context,
+      Addition,
+      Deletion,
+      Header
+   };
+
+   struct Match
+   {
+      int offset = -1;
+      int size = 0;
+   };
+
+   QString mText;
+   QVector<int> mLineStarts;
+   QVector<LineType> mLineTypes;
+   QVector<ChunkDiffInfo::ChunkInfo> mFileDiffInfo;
+   LineNumberArea *mLineNumberArea = nullptr;
+   int mLongestLine = -1;
+   int mTextWidth = 0;
+   int mSelectionAnchor = -1;
+   int mSelectionEnd = -1;
+   Match mMatch;
+   QHash<int, QVector<WordDiff::Range>> mWordChanges;
+
+   /**
+    * @brief lineText Returns the text of @p line without the line break.
+    */
+   QStringRef lineText(int line) const;
+   int lineAt(int y) const;
+   int lineOf(int offset) const;
+   void updateTextWidth();
+   /**
+    * @brief textAdvance Returns the width of @p text painted with the tab stops of the view.
+    */
+   int textAdvance(const QString &text) const;
+   void updateScrollBars();
+   void updateLineNumberArea();
+   void copySelection() const;
+   void showContextMenu(const QPoint &pos);
+};
@@ -116,13 +116,20 @@ QVector<FileBlameWidget::Annotation> FileBlameWidget::processBlame(const QString
    const auto lines = blame.split("\n", QString::SkipEmptyParts);
 #endif
    QVector<Annotation> annotations;
+   QStringList shortShas;
+   shortShas.reserve(lines.count());
+
+   for (const auto &line : lines)
+      shortShas.append(line.left(line.indexOf('\t')));
+
+   const auto shas = mCache->resolveShas(shortShas);
+   auto lineIndex = 0;
 
    for (const auto &line : lines)
    {
       auto start = 0;
       auto indexOfTab = line.indexOf('\t');
-      const auto shortSha = line.mid(start, indexOfTab);
-      const auto revision = mCache->commitInfo(shortSha);
+      const auto sha = shas.value(shortShas.at(lineIndex++));
 
       start = indexOfTab + 1;
       indexOfTab = line.indexOf('\t', start);
@@ -140,9 +147,9 @@ QVector<FileBlameWidget::Annotation> FileBlameWidget::processBlame(const QString
       const auto lineText = lineNumAndContent.mid(0, divisorChar);
       const auto content = lineNumAndContent.mid(divisorChar + 1, lineNumAndContent.count() - lineText.count() - 1);
 
-      annotations.append({ revision.sha, name, dt, lineText.toInt(), content });
+      annotations.append({ sha, name, dt, lineText.toInt(), content });
 
-      if (revision.sha != CommitInfo::ZERO_SHA)
+      if (sha != CommitInfo::ZERO_SHA)
       {
          const auto dtSinceEpoch = dt.toSecsSinceEpoch();
 
@@ -272,7 +279,7 @@ ButtonLink *FileBlameWidget::createMessageLabel(const QString &sha, bool isFirst
    const auto revision = mCache->commitInfo(sha);
    auto commitMsg = tr("Local changes");
 
-   if (!revision.sha.isEmpty())
+   if (revision.isValid())
    {
       auto log = revision.shortLog;
 
@@ -1,20 +1,24 @@
 #include "FileDiffWidget.h"
 
 #include <CommitInfo.h>
+#include <DiffEngine.h>
 #include <DiffHelper.h>
-#include <FileDiffView.h>
+#include <DiffLinesView.h>
 #include <FileEditor.h>
 #include <GitBase.h>
 #include <GitCache.h>
 #include <GitHistory.h>
 #include <GitLocal.h>
+#include <GitObjectReader.h>
 #include <GitPatches.h>
 #include <GitQlientSettings.h>
 #include <LineNumberArea.h>
+#include <WordDiffWorker.h>
 
 #include <QCheckBox>
 #include <QDateTime>
 #include <QDir>
+#include <QFileInfo>
 #include <QHBoxLayout>
 #include <QLabel>
 #include <QLineEdit>
@@ -37,11 +41,13 @@ FileDiffWidget::FileDiffWidget(const QSharedPointer<GitBase> &git, QSharedPointe
    , mRevert(new QPushButton())
    , mFileNameLabel(new QLabel())
    , mTitleFrame(new QFrame())
-   , mNewFile(new FileDiffView())
+   , mNewFile(new DiffLinesView())
    , mSearchOld(new QLineEdit())
-   , mOldFile(new FileDiffView())
+   , mOldFile(new DiffLinesView())
    , mFileEditor(new FileEditor())
    , mViewStackedWidget(new QStackedWidget())
+   , mObjectReader(new GitObjectReader(mGit->getWorkingDir(), this))
+   , mWordDiff(new WordDiffWorker(this))
 {
    mNewFile->addNumberArea(new LineNumberArea(mNewFile));
    mOldFile->addNumberArea(new LineNumberArea(mOldFile));
@@ -83,7 +89,7 @@ FileDiffWidget::FileDiffWidget(const QSharedPointer<GitBase> &git, QSharedPointe
    mSearchOld->setPlaceholderText(tr("Press Enter to search a text... "));
    mSearchOld->setObjectName("SearchInput");
    connect(mSearchOld, &QLineEdit::editingFinished, this,
-           [this]() { DiffHelper::findString(mSearchOld->text(), mNewFile, this); });
+           [this]() { DiffHelper::findString(mSearchOld->text(), mOldFile, this); });
 
    const auto oldFileLayout = new QVBoxLayout();
    oldFileLayout->setContentsMargins(QMargins());
@@ -169,16 +175,18 @@ FileDiffWidget::FileDiffWidget(const QSharedPointer<GitBase> &git, QSharedPointe
       mSearchOld->setHidden(true);
    }
 
-   connect(mNewFile, &FileDiffView::signalScrollChanged, mOldFile, &FileDiffView::moveScrollBarToPos);
-   connect(mNewFile, &FileDiffView::signalStageChunk, this, &FileDiffWidget::stageChunk);
-   connect(mOldFile, &FileDiffView::signalScrollChanged, mNewFile, &FileDiffView::moveScrollBarToPos);
-   connect(mOldFile, &FileDiffView::signalStageChunk, this, &FileDiffWidget::stageChunk);
+   connect(mNewFile, &DiffLinesView::signalScrollChanged, mOldFile, &DiffLinesView::moveScrollBarToPos);
+   connect(mNewFile, &DiffLinesView::signalStageChunk, this, &FileDiffWidget::stageChunk);
+   connect(mOldFile, &DiffLinesView::signalScrollChanged, mNewFile, &DiffLinesView::moveScrollBarToPos);
+   connect(mOldFile, &DiffLinesView::signalStageChunk, this, &FileDiffWidget::stageChunk);
+   connect(mWordDiff, &WordDiffWorker::changesFound, this, &FileDiffWidget::showWordChanges);
 
    setAttribute(Qt::WA_DeleteOnClose);
 }
 
 void FileDiffWidget::clear()
 {
+   mWordDiff->cancel();
    mNewFile->clear();
 }
 
@@ -198,16 +206,8 @@ void FileDiffWidget::changeFontSize()
    auto font = mNewFile->font();
    font.setPointSize(fontSize);
 
-   auto cursor = mNewFile->textCursor();
-
-   mNewFile->selectAll();
    mNewFile->setFont(font);
-   mNewFile->setTextCursor(cursor);
-
-   cursor = mOldFile->textCursor();
-   mOldFile->selectAll();
    mOldFile->setFont(font);
-   mOldFile->setTextCursor(cursor);
 }
 
 bool FileDiffWidget::configure(const QString &currentSha, const QString &previousSha, const QString &file,
@@ -220,10 +220,17 @@ bool FileDiffWidget::configure(const QString &currentSha, const QString &previou
 
    QString text;
    GitHistory git(mGit);
+   auto wipDiff = currentSha == CommitInfo::ZERO_SHA ? diffWipFile(destFile, isStaged) : std::nullopt;
+   auto cachedDiff
+       = currentSha != CommitInfo::ZERO_SHA ? mCache->diff(currentSha, previousSha, destFile) : std::nullopt;
 
    // TODO: get file status instead of trying 3 diff methods
 
-   if (auto ret
+   if (wipDiff)
+      text = std::move(*wipDiff);
+   else if (cachedDiff)
+      text = QString::fromUtf8(*cachedDiff);
+   else if (auto ret
        = git.getFileDiff(currentSha == CommitInfo::ZERO_SHA ? QString() : currentSha, previousSha, destFile, isStaged);
        ret.success)
    {
@@ -240,6 +247,9 @@ bool FileDiffWidget::configure(const QString &currentSha, const QString &previou
          }
       }
 
+      // Only the diff between the two commits is cached, not the one of the file as untracked
+      const auto isCommitDiff = !text.isEmpty();
+
       if (text.isEmpty())
       {
          if (const auto ret = git.getUntrackedFileDiff(destFile); ret.success)
@@ -248,6 +258,9 @@ bool FileDiffWidget::configure(const QString &currentSha, const QString &previou
 
       if (text.startsWith("* "))
          return false;
+
+      if (isCommitDiff && currentSha != CommitInfo::ZERO_SHA)
+         mCache->insertDiff(currentSha, previousSha, text.toUtf8(), destFile);
    }
 
    mFileNameLabel->setText(file);
@@ -265,11 +278,15 @@ bool FileDiffWidget::configure(const QString &currentSha, const QString &previou
    mCurrentSha = currentSha;
    mPreviousSha = previousSha;
 
-   auto pos = 0;
-   for (auto i = 0; i < 5; ++i)
-      pos = text.indexOf("\n", pos + 1);
+   // The diff of Git starts with its headers
+   if (!wipDiff)
+   {
+      auto pos = 0;
+      for (auto i = 0; i < 5; ++i)
+         pos = text.indexOf("\n", pos + 1);
 
-   text = text.mid(pos + 1);
+      text = text.mid(pos + 1);
+   }
 
    if (!text.isEmpty())
    {
@@ -287,12 +304,16 @@ bool FileDiffWidget::configure(const QString &currentSha, const QString &previou
          mNewFile->blockSignals(true);
          mNewFile->loadDiff(newData.first.join('\n'), newData.second);
          mNewFile->blockSignals(false);
+
+         mWordDiff->start(WordDiff::pairLines(mChunks), mNewFile->firstVisibleLine(), mNewFile->lastVisibleLine());
       }
       else
       {
          mNewFile->blockSignals(true);
          mNewFile->loadDiff(text, {});
          mNewFile->blockSignals(false);
+
+         mWordDiff->start(WordDiff::pairLines(text, true), mNewFile->firstVisibleLine(), mNewFile->lastVisibleLine());
       }
 
       if (editMode)
@@ -314,6 +335,78 @@ bool FileDiffWidget::configure(const QString &currentSha, const QString &previou
    return false;
 }
 
+void FileDiffWidget::showWordChanges(const QVector<WordDiff::LineChanges> &changes)
+{
+   // The split view shows each line of the pair in its own file
+   const auto oldView = mFileVsFile ? mOldFile : mNewFile;
+
+   for (const auto &change : changes)
+   {
+      oldView->addWordChanges(change.oldLine, change.oldRanges);
+      mNewFile->addWordChanges(change.newLine, change.newRanges);
+   }
+}
+
+std::optional<QString> FileDiffWidget::diffWipFile(const QString &file, bool isStaged)
+{
+   const auto filePath = QString("%1/%2").arg(mGit->getWorkingDir(), file);
+   const QFileInfo fileInfo(filePath);
+
+   // Git compares the target of the links and not their content
+   if (fileInfo.isSymLink())
+      return std::nullopt;
+
+   const auto readWorkingFile = [&fileInfo, &filePath]() -> std::optional<QByteArray> {
+      if (!fileInfo.exists())
+         return QByteArray();
+
+      QFile workingFile(filePath);
+
+      if (!workingFile.open(QIODevice::ReadOnly))
+         return std::nullopt;
+
+      return workingFile.readAll();
+   };
+
+   if (mCache->getUntrackedFiles().contains(file))
+   {
+      const auto content = readWorkingFile();
+
+      return content ? DiffEngine::fullContextDiff(QByteArray(), *content) : std::nullopt;
+   }
+
+   const auto objects = mCache->wipFileObjects(file);
+
+   if (!objects)
+      return std::nullopt;
+
+   const auto readBlob = [this](const ObjectId &id) -> std::optional<QByteArray> {
+      return id.isNull() ? QByteArray() : mObjectReader->readBlob(id);
+   };
+
+   // A file that is not in the index has no unstaged changes
+   if (!isStaged && !objects->index.isNull())
+   {
+      const auto indexContent = readBlob(objects->index);
+      const auto workingContent = readWorkingFile();
+
+      if (!indexContent || !workingContent)
+         return std::nullopt;
+
+      // Like with Git, the file could be staged in the meantime so the staged changes are shown then
+      if (auto diff = DiffEngine::fullContextDiff(*indexContent, *workingContent); !diff || !diff->isEmpty())
+         return diff;
+   }
+
+   const auto headContent = readBlob(objects->head);
+   const auto indexContent = readBlob(objects->index);
+
+   if (!headContent || !indexContent)
+      return std::nullopt;
+
+   return DiffEngine::fullContextDiff(*headContent, *indexContent);
+}
+
 void FileDiffWidget::setSplitViewEnabled(bool enable)
 {
    mFileVsFile = enable;
@@ -26,12 +26,17 @@
 #include <IDiffWidget.h>
 
 #include <DiffInfo.h>
+#include <WordDiff.h>
 #include <QFrame>
 
-class FileDiffView;
+#include <optional>
+
+class DiffLinesView;
 class QPushButton;
 class CheckBox;
 class FileEditor;
+class GitObjectReader;
+class WordDiffWorker;
 class QStackedWidget;
 class QLabel;
 class QLineEdit;
@@ -138,15 +143,17 @@ private:
    QPushButton *mRevert = nullptr;
    QLabel *mFileNameLabel = nullptr;
    QFrame *mTitleFrame = nullptr;
-   FileDiffView *mNewFile = nullptr;
+   DiffLinesView *mNewFile = nullptr;
    QLineEdit *mSearchOld = nullptr;
-   FileDiffView *mOldFile = nullptr;
+   DiffLinesView *mOldFile = nullptr;
    QVector<int> mModifications;
    bool mFileVsFile = false;
    DiffInfo mChunks;
    int mCurrentChunkLine = 0;
    FileEditor *mFileEditor = nullptr;
    QStackedWidget *mViewStackedWidget = nullptr;
+   GitObjectReader *mObjectReader = nullptr;
+   WordDiffWorker *mWordDiff = nullptr;
 
    /**
     * @brief moveChunkUp Moves to the previous diff chunk.
@@ -177,4 +184,19 @@ private:
    void revertFile();
 
    void stageChunk(const QString &id);
+
+   /**
+    * @brief showWordChanges Highlights the words that changed in the lines of the diff.
+    * @param changes The chars that changed in every pair of lines.
+    */
+   void showWordChanges(const QVector<WordDiff::LineChanges> &changes);
+
+   /**
+    * @brief diffWipFile Compares the versions of a file of the WIP without running Git. The unstaged changes compare
+    * the index with the working directory and the staged ones HEAD with the index.
+    * @param file The file to compare.
+    * @param isStaged If true, the staged changes are compared. Otherwise, the unstaged ones unless there are none.
+    * @return The lines of the diff without the headers of Git or nothing if Git has to compare the file.
+    */
+   std::optional<QString> diffWipFile(const QString &file, bool isStaged);
 };
@@ -6,14 +6,23 @@
 #include <GitHistory.h>
 #include <GitQlientSettings.h>
 #include <GitQlientStyles.h>
+#include <UnifiedDiff.h>
+#include <WordDiffWorker.h>
 
 #include <QLineEdit>
 #include <QPushButton>
 #include <QScrollBar>
 #include <QTextCharFormat>
 #include <QTextCodec>
+#include <QTextDocument>
 #include <QVBoxLayout>
 
+namespace
+{
+// The lines are painted with the colour of the change, so the words that changed get a soft background of it
+const int WORD_CHANGE_ALPHA = 90;
+}
+
 FullDiffWidget::DiffHighlighter::DiffHighlighter(QTextDocument *document)
    : QSyntaxHighlighter(document)
 {
@@ -61,6 +70,35 @@ void FullDiffWidget::DiffHighlighter::highlightBlock(const QString &text)
    }
    if (myFormat.isValid())
       setFormat(0, text.length(), myFormat);
+
+   if (const auto ranges = mWordChanges.constFind(currentBlock().blockNumber()); ranges != mWordChanges.cend())
+   {
+      auto background = firstChar == '+' ? GitQlientStyles::getGreen() : GitQlientStyles::getRed();
+      background.setAlpha(WORD_CHANGE_ALPHA);
+
+      auto wordFormat = myFormat;
+      wordFormat.setBackground(background);
+
+      // The ranges don't count the prefix of the line
+      for (const auto &range : *ranges)
+         setFormat(range.start + 1, range.length, wordFormat);
+   }
+}
+
+void FullDiffWidget::DiffHighlighter::addWordChanges(int line, const QVector<WordDiff::Range> &ranges)
+{
+   if (ranges.isEmpty())
+      return;
+
+   mWordChanges.insert(line, ranges);
+
+   if (const auto block = document()->findBlockByNumber(line); block.isValid())
+      rehighlightBlock(block);
+}
+
+void FullDiffWidget::DiffHighlighter::clearWordChanges()
+{
+   mWordChanges.clear();
 }
 
 FullDiffWidget::FullDiffWidget(const QSharedPointer<GitBase> &git, QSharedPointer<GitCache> cache, QWidget *parent)
@@ -68,6 +106,7 @@ FullDiffWidget::FullDiffWidget(const QSharedPointer<GitBase> &git, QSharedPointe
    , mGoPrevious(new QPushButton())
    , mGoNext(new QPushButton())
    , mDiffWidget(new QPlainTextEdit())
+   , mWordDiff(new WordDiffWorker(this))
 {
    setAttribute(Qt::WA_DeleteOnClose);
 
@@ -110,18 +149,33 @@ FullDiffWidget::FullDiffWidget(const QSharedPointer<GitBase> &git, QSharedPointe
    mGoNext->setToolTip(tr("Next change"));
    mGoNext->setIcon(QIcon::fromTheme("go-down", QIcon(":/icons/arrow_down")));
    connect(mGoNext, &QPushButton::clicked, this, &FullDiffWidget::moveChunkDown);
+
+   connect(mWordDiff, &WordDiffWorker::changesFound, this, [this](const QVector<WordDiff::LineChanges> &changes) {
+      for (const auto &change : changes)
+      {
+         diffHighlighter->addWordChanges(change.oldLine, change.oldRanges);
+         diffHighlighter->addWordChanges(change.newLine, change.newRanges);
+      }
+   });
 }
 
 bool FullDiffWidget::reload()
 {
    if (mCurrentSha != CommitInfo::ZERO_SHA)
    {
+      if (const auto diff = mCache->diff(mCurrentSha, mPreviousSha))
+      {
+         loadDiff(mCurrentSha, mPreviousSha, *diff);
+         return true;
+      }
+
       GitHistory git(mGit);
       const auto ret = git.getCommitDiff(mCurrentSha, mPreviousSha);
 
-      if (ret.success && !ret.output.isEmpty())
+      if (ret && !ret->isEmpty())
       {
-         loadDiff(mCurrentSha, mPreviousSha, ret.output);
+         mCache->insertDiff(mCurrentSha, mPreviousSha, *ret);
+         loadDiff(mCurrentSha, mPreviousSha, *ret);
          return true;
       }
    }
@@ -129,31 +183,37 @@ bool FullDiffWidget::reload()
    return false;
 }
 
-void FullDiffWidget::processData(const QString &fileChunk)
+void FullDiffWidget::processData(const QByteArray &fileChunk)
 {
-   if (mPreviousDiffText != fileChunk)
+   if (mPreviousDiff != fileChunk)
    {
-      mPreviousDiffText = fileChunk;
+      mPreviousDiff = fileChunk;
 
-      auto count = 0;
-      const auto chunks = fileChunk.split("\n");
+      // The files and the lines to pair are read from the spans of the diff: the text is only decoded for the view
+      const auto diff = UnifiedDiff::parse(fileChunk);
 
-      for (const auto &chunk : chunks)
-      {
-         if (chunk.startsWith("diff --"))
-            mFilePositions.append(count);
+      mFilePositions.clear();
 
-         ++count;
-      }
+      for (const auto &file : diff.files())
+         mFilePositions.append(file.line);
 
       const auto pos = mDiffWidget->verticalScrollBar()->value();
 
+      mWordDiff->cancel();
+      diffHighlighter->clearWordChanges();
+
       mDiffWidget->setUpdatesEnabled(false);
       mDiffWidget->clear();
-      mDiffWidget->setPlainText(fileChunk);
+      mDiffWidget->setPlainText(QString::fromUtf8(fileChunk));
       mDiffWidget->moveCursor(QTextCursor::Start);
       mDiffWidget->verticalScrollBar()->setValue(pos);
       mDiffWidget->setUpdatesEnabled(true);
+
+      const auto firstVisibleLine = mDiffWidget->cursorForPosition(QPoint(0, 0)).blockNumber();
+      const auto lastVisibleLine
+          = mDiffWidget->cursorForPosition(QPoint(0, mDiffWidget->viewport()->height())).blockNumber();
+
+      mWordDiff->start(WordDiff::pairLines(diff), firstVisibleLine, lastVisibleLine);
    }
 }
 
@@ -187,7 +247,7 @@ void FullDiffWidget::moveChunkDown()
    }
 }
 
-void FullDiffWidget::loadDiff(const QString &sha, const QString &diffToSha, const QString &diffData)
+void FullDiffWidget::loadDiff(const QString &sha, const QString &diffToSha, const QByteArray &diffData)
 {
    mCurrentSha = sha;
    mPreviousSha = diffToSha;
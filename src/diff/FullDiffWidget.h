@@ -24,11 +24,14 @@
  ***************************************************************************************/
 
 #include <IDiffWidget.h>
+#include <WordDiff.h>
 
+#include <QHash>
 #include <QSyntaxHighlighter>
 
 class QPlainTextEdit;
 class QPushButton;
+class WordDiffWorker;
 
 /*!
  \brief The FullDiffWidget class is an overload class inherited from QTextEdit that process the output from a diff for a
@@ -60,25 +63,40 @@ public:
 
     \param sha The base commit SHA.
     \param diffToSha The commit SHA to compare to.
-    \param diffData The diff data returned by the git command.
+    \param diffData The diff data returned by the git command, as bytes.
     \return True if there is a diff to load, otherwise false.
    */
-   void loadDiff(const QString &sha, const QString &diffToSha, const QString &diffData);
+   void loadDiff(const QString &sha, const QString &diffToSha, const QByteArray &diffData);
 
    void changeFontSize() override;
 
 private:
    QPushButton *mGoPrevious = nullptr;
    QPushButton *mGoNext = nullptr;
-   QString mPreviousDiffText;
+   QByteArray mPreviousDiff;
    QPlainTextEdit *mDiffWidget = nullptr;
    QVector<int> mFilePositions;
+   WordDiffWorker *mWordDiff = nullptr;
 
    class DiffHighlighter : public QSyntaxHighlighter
    {
    public:
       DiffHighlighter(QTextDocument *document);
       void highlightBlock(const QString &text) override;
+
+      /**
+       * @brief addWordChanges Highlights the chars of a changed line that are different in the line it's paired with.
+       * @param line The line of the diff.
+       * @param ranges The chars that changed, without counting the diff prefix.
+       */
+      void addWordChanges(int line, const QVector<WordDiff::Range> &ranges);
+      /**
+       * @brief clearWordChanges Removes the highlights of the words. It must be called before loading a new text.
+       */
+      void clearWordChanges();
+
+   private:
+      QHash<int, QVector<WordDiff::Range>> mWordChanges;
    };
 
    DiffHighlighter *diffHighlighter = nullptr;
@@ -88,7 +106,7 @@ private:
 
     \param fileChunk The file chuck to compare.
    */
-   void processData(const QString &fileChunk);
+   void processData(const QByteArray &fileChunk);
    /**
     * @brief moveChunkUp Moves to the previous diff chunk.
     */
@@ -1,5 +1,6 @@
 #include <LineNumberArea.h>
 
+#include <DiffLinesView.h>
 #include <FileDiffView.h>
 #include <GitQlientStyles.h>
 #include <Colors.h>
@@ -16,6 +17,12 @@ LineNumberArea::LineNumberArea(FileDiffView *editor, bool allowComments)
    setMouseTracking(true);
 }
 
+LineNumberArea::LineNumberArea(DiffLinesView *view)
+   : QWidget(view)
+   , mLinesView(view)
+{
+}
+
 int LineNumberArea::widthInDigitsSize()
 {
    return 3;
@@ -23,7 +30,7 @@ int LineNumberArea::widthInDigitsSize()
 
 QSize LineNumberArea::sizeHint() const
 {
-   return { fileDiffWidget->lineNumberAreaWidth(), 0 };
+   return { mLinesView ? mLinesView->lineNumberAreaWidth() : fileDiffWidget->lineNumberAreaWidth(), 0 };
 }
 
 void LineNumberArea::setEditor(FileDiffView *editor)
@@ -34,6 +41,12 @@ void LineNumberArea::setEditor(FileDiffView *editor)
 
 void LineNumberArea::paintEvent(QPaintEvent *event)
 {
+   if (mLinesView)
+   {
+      paintLinesView(event);
+      return;
+   }
+
    QPainter painter(this);
 
    const auto fontWidth = fileDiffWidget->fontMetrics().horizontalAdvance(QLatin1Char(' '));
@@ -87,6 +100,23 @@ void LineNumberArea::paintEvent(QPaintEvent *event)
    }
 }
 
+void LineNumberArea::paintLinesView(QPaintEvent *event)
+{
+   QPainter painter(this);
+   painter.setPen(GitQlientStyles::getTextColor());
+
+   const auto offset = mLinesView->fontMetrics().horizontalAdvance(QLatin1Char(' '));
+   const auto height = mLinesView->lineHeight();
+   const auto bottom = event->rect().bottom();
+
+   for (auto line = mLinesView->firstVisibleLine(), top = 0; line < mLinesView->lineCount() && top <= bottom;
+        ++line, top += height)
+   {
+      if (top + height >= event->rect().top())
+         painter.drawText(0, top, width() - offset, height, Qt::AlignRight, QString::number(line + 1));
+   }
+}
+
 void LineNumberArea::mouseMoveEvent(QMouseEvent *e)
 {
    if (mCommentsAllowed)
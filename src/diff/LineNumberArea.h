@@ -27,6 +27,7 @@
 
 #include <QMap>
 
+class DiffLinesView;
 class FileDiffView;
 
 class LineNumberArea : public QWidget
@@ -42,6 +43,10 @@ public:
    using LinkId = int;
 
    LineNumberArea(FileDiffView *editor, bool allowComments = false);
+   /**
+    * @brief LineNumberArea Builds the line numbers of a DiffLinesView. Only the visible lines are painted.
+    */
+   explicit LineNumberArea(DiffLinesView *view);
 
    int widthInDigitsSize();
    QSize sizeHint() const override;
@@ -51,12 +56,17 @@ public:
 
 protected:
    void paintEvent(QPaintEvent *event) override;
+   /**
+    * @brief paintLinesView Paints the numbers of the lines of the DiffLinesView that are visible.
+    */
+   void paintLinesView(QPaintEvent *event);
    void mouseMoveEvent(QMouseEvent *e) override;
    void mousePressEvent(QMouseEvent *e) override;
    void mouseReleaseEvent(QMouseEvent *e) override;
 
 private:
-   FileDiffView *fileDiffWidget;
+   FileDiffView *fileDiffWidget = nullptr;
+   DiffLinesView *mLinesView = nullptr;
    bool mPressed = false;
    bool mCommentsAllowed = false;
    QMap<BookmarkLine, LinkId> mBookmarks;
@@ -0,0 +1,240 @@
+#include "UnifiedDiff.h"
+
+#include <cstring>
+
+namespace
+{
+template<int N>
+bool startsWith(const char *line, qint64 size, const char (&prefix)[N])
+{
+   return size >= N - 1 && memcmp(line, prefix, N - 1) == 0;
+}
+
+bool readNumber(const char *&current, const char *end, int &number)
+{
+   const auto start = current;
+   number = 0;
+
+   while (current < end && *current >= '0' && *current <= '9')
+      number = number * 10 + (*current++ - '0');
+
+   return current != start;
+}
+
+bool readRange(const char *&current, const char *end, int &start, int &count)
+{
+   if (!readNumber(current, end, start))
+      return false;
+
+   count = 1;
+
+   if (current < end && *current == ',')
+      return readNumber(++current, end, count);
+
+   return true;
+}
+
+bool readHunkHeader(const char *line, qint64 size, UnifiedDiff::Hunk &hunk)
+{
+   const auto end = line + size;
+   auto current = line + 4; // "@@ -"
+
+   if (!readRange(current, end, hunk.oldStart, hunk.oldCount) || end - current < 2 || memcmp(current, " +", 2) != 0)
+      return false;
+
+   current += 2;
+
+   return readRange(current, end, hunk.newStart, hunk.newCount);
+}
+
+/**
+ * @brief fileName Returns the file name that follows the first @p prefixSize bytes of a header line. The "a/" and "b/"
+ * prefixes, when the line has them, and the tab that Git adds after the names with spaces are removed.
+ */
+UnifiedDiff::Span fileName(const char *begin, const char *line, qint64 size, int prefixSize, bool hasPrefix = true)
+{
+   auto start = line + prefixSize;
+   auto end = line + size;
+
+   if (hasPrefix && end - start >= 2 && (start[0] == 'a' || start[0] == 'b') && start[1] == '/')
+      start += 2;
+
+   while (end > start && (end[-1] == '\t' || end[-1] == '\r'))
+      --end;
+
+   return { static_cast<int>(start - begin), static_cast<int>(end - start) };
+}
+
+/**
+ * @brief readGitNames Reads the names of the "diff --git a/name b/name" line. The names are only ambiguous when they
+ * contain " b/" and the file is renamed, but then the rename lines set them later.
+ */
+void readGitNames(const char *begin, const char *line, qint64 size, UnifiedDiff::File &file)
+{
+   const auto prefixSize = 11; // "diff --git "
+   const auto names = line + prefixSize;
+   const auto namesSize = static_cast<int>(size - prefixSize);
+   const auto half = (namesSize - 1) / 2;
+   auto separator = -1;
+
+   if (namesSize < 5)
+      return;
+
+   if (namesSize % 2 == 1 && names[half] == ' ' && memcmp(names + 2, names + half + 3, half - 2) == 0)
+      separator = half;
+   else
+   {
+      for (auto i = namesSize - 3; i > 0 && separator == -1; --i)
+      {
+         if (memcmp(names + i, " b/", 3) == 0)
+            separator = i;
+      }
+   }
+
+   if (separator == -1)
+      return;
+
+   file.oldName = fileName(begin, line, prefixSize + separator, prefixSize);
+   file.newName = fileName(begin, line, size, prefixSize + separator + 1);
+}
+}
+
+UnifiedDiff UnifiedDiff::parse(const QByteArray &data)
+{
+   UnifiedDiff diff;
+   diff.mData = data;
+
+   const auto begin = data.constData();
+   const auto end = begin + data.size();
+   auto lineNumber = 0;
+   auto oldRemaining = 0;
+   auto newRemaining = 0;
+   auto inHunk = false;
+
+   const auto closeFile = [&diff](int offset) {
+      if (!diff.mFiles.isEmpty() && diff.mFiles.constLast().hunkCount == 0)
+      {
+         auto &file = diff.mFiles.last();
+         file.header.size = offset - file.header.offset;
+      }
+   };
+
+   for (auto current = begin; current < end; ++lineNumber)
+   {
+      const auto lineEnd = static_cast<const char *>(memchr(current, '\n', static_cast<size_t>(end - current)));
+      const auto next = lineEnd ? lineEnd + 1 : end;
+      const auto size = (lineEnd ? lineEnd : end) - current;
+      const auto offset = static_cast<int>(current - begin);
+
+      if (inHunk)
+      {
+         Line line;
+         auto isLine = true;
+
+         switch (size == 0 ? ' ' : *current)
+         {
+            case ' ':
+               line.type = LineType::Context;
+               --oldRemaining;
+               --newRemaining;
+               break;
+            case '+':
+               line.type = LineType::Addition;
+               --newRemaining;
+               break;
+            case '-':
+               line.type = LineType::Deletion;
+               --oldRemaining;
+               break;
+            case '\\':
+               line.type = LineType::NoNewLine;
+               break;
+            default:
+               isLine = false;
+               break;
+         }
+
+         if (isLine)
+         {
+            // Some tools remove the space of the empty context lines
+            line.content.offset = size == 0 ? offset : offset + 1;
+            line.content.size = size == 0 ? 0 : static_cast<int>(size - 1);
+
+            diff.mLines.append(line);
+
+            auto &hunk = diff.mHunks.last();
+            ++hunk.lineCount;
+            hunk.body.size = static_cast<int>(next - begin) - hunk.body.offset;
+
+            // The mark of the missing line break follows the last line of the hunk
+            inHunk = oldRemaining > 0 || newRemaining > 0
+                || (next < end && *next == '\\' && line.type != LineType::NoNewLine);
+            current = next;
+            continue;
+         }
+
+         inHunk = false;
+      }
+
+      if (startsWith(current, size, "diff --git "))
+      {
+         closeFile(offset);
+
+         File file;
+         file.header.offset = offset;
+         file.line = lineNumber;
+         file.firstHunk = diff.mHunks.count();
+         readGitNames(begin, current, size, file);
+
+         diff.mFiles.append(file);
+      }
+      else if (!diff.mFiles.isEmpty())
+      {
+         auto &file = diff.mFiles.last();
+         Hunk hunk;
+
+         if (startsWith(current, size, "@@ -") && readHunkHeader(current, size, hunk))
+         {
+            if (file.hunkCount == 0)
+               file.header.size = offset - file.header.offset;
+
+            hunk.header = { offset, static_cast<int>(size) };
+            hunk.body.offset = static_cast<int>(next - begin);
+            hunk.line = lineNumber;
+            hunk.firstLine = diff.mLines.count();
+
+            diff.mHunks.append(hunk);
+            ++file.hunkCount;
+
+            oldRemaining = hunk.oldCount;
+            newRemaining = hunk.newCount;
+            inHunk = oldRemaining > 0 || newRemaining > 0;
+         }
+         else if (file.hunkCount == 0)
+         {
+            if (startsWith(current, size, "--- ") && !startsWith(current, size, "--- /dev/null"))
+               file.oldName = fileName(begin, current, size, 4);
+            else if (startsWith(current, size, "+++ ") && !startsWith(current, size, "+++ /dev/null"))
+               file.newName = fileName(begin, current, size, 4);
+            else if (startsWith(current, size, "rename from ") || startsWith(current, size, "copy from "))
+               file.oldName = fileName(begin, current, size, *current == 'r' ? 12 : 10, false);
+            else if (startsWith(current, size, "rename to ") || startsWith(current, size, "copy to "))
+               file.newName = fileName(begin, current, size, *current == 'r' ? 10 : 8, false);
+            else if (startsWith(current, size, "new file mode "))
+               file.isNew = true;
+            else if (startsWith(current, size, "deleted file mode "))
+               file.isDeleted = true;
+            else if (startsWith(current, size, "Binary files ") || startsWith(current, size, "GIT binary patch"))
+               file.isBinary = true;
+         }
+      }
+
+      current = next;
+   }
+
+   closeFile(data.size());
+
+   diff.mTotalLines = lineNumber;
+
+   return diff;
+}
@@ -0,0 +1,154 @@
+#pragma once
+
+/****************************************************************************************
+ ** GitQlient is an application to manage and operate one or several Git repositories. With
+ ** GitQlient you will be able to add commits, branches and manage all the options Git provides.
+ ** Copyright (C) 2021  Francesc Martinez
+ **
+ ** LinkedIn: www.linkedin.com/in/cescmm/
+ ** Web: www.francescmm.com
+ **
+ ** This program is free software; you can redistribute it and/or
+ ** modify it under the terms of the GNU Lesser General Public
+ ** License as published by the Free Software Foundation; either
+ ** version 2 of the License, or (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ ** Lesser General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Lesser General Public
+ ** License along with this library; if not, write to the Free Software
+ ** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ ***************************************************************************************/
+
+
+#include <QByteArray>
+#include <QString>
+#include <QVector>
+
+/**
+ * @brief The UnifiedDiff class parses the output of git diff in a single pass over its bytes. Nothing is copied: the
+ * files, the hunks and the lines are stored as tables of offsets in the original data, that is shared with the parser.
+ *
+ * The lines of a hunk are delimited by the counts in its header, so a deleted line that starts with "--- " or a
+ * context line that starts with "diff --git" are read as lines and not as headers.
+ */
+class UnifiedDiff
+{
+public:
+   /**
+    * @brief The Span struct is a range of bytes in the data of the diff.
+    */
+   struct Span
+   {
+      int offset = 0;
+      int size = 0;
+
+      bool isEmpty() const { return size == 0; }
+   };
+
+   enum class LineType : quint8
+   {
+      Context,
+      Addition,
+      Deletion,
+      /**
+       * @brief NoNewLine The "\ No newline at end of file" mark of the previous line.
+       */
+      NoNewLine
+   };
+
+   struct Line
+   {
+      /**
+       * @brief content The text of the line without its prefix nor the line break.
+       */
+      Span content;
+      LineType type = LineType::Context;
+   };
+
+   struct Hunk
+   {
+      /**
+       * @brief header The "@@ -a,b +c,d @@" line, including the text that follows it.
+       */
+      Span header;
+      /**
+       * @brief body The lines of the hunk as they are in the diff, with their prefixes and line breaks.
+       */
+      Span body;
+      /**
+       * @brief line The line of the header in the diff, starting from 0.
+       */
+      int line = 0;
+      int oldStart = 0;
+      int oldCount = 0;
+      int newStart = 0;
+      int newCount = 0;
+      int firstLine = 0;
+      int lineCount = 0;
+   };
+
+   struct File
+   {
+      /**
+       * @brief header The extended header of the file, from the "diff --git" line to the first hunk.
+       */
+      Span header;
+      Span oldName;
+      Span newName;
+      /**
+       * @brief line The line of the "diff --git" header in the diff, starting from 0.
+       */
+      int line = 0;
+      int firstHunk = 0;
+      int hunkCount = 0;
+      bool isBinary = false;
+      bool isNew = false;
+      bool isDeleted = false;
+   };
+
+   UnifiedDiff() = default;
+
+   /**
+    * @brief parse Parses the output of git diff. The text before the first "diff --git" line is ignored.
+    */
+   static UnifiedDiff parse(const QByteArray &data);
+
+   const QByteArray &data() const { return mData; }
+   const QVector<File> &files() const { return mFiles; }
+   const QVector<Hunk> &hunks() const { return mHunks; }
+   const QVector<Line> &lines() const { return mLines; }
+
+   /**
+    * @brief totalLines Returns the number of lines of the whole diff.
+    */
+   int totalLines() const { return mTotalLines; }
+
+   /**
+    * @brief bytes Returns the bytes of @p span without copying them. They're valid while the diff exists.
+    */
+   QByteArray bytes(const Span &span) const
+   {
+      return QByteArray::fromRawData(mData.constData() + span.offset, span.size);
+   }
+
+   /**
+    * @brief text Returns the text of @p span.
+    */
+   QString text(const Span &span) const { return QString::fromUtf8(mData.constData() + span.offset, span.size); }
+
+private:
+   QByteArray mData;
+   QVector<File> mFiles;
+   QVector<Hunk> mHunks;
+   QVector<Line> mLines;
+   int mTotalLines = 0;
+};
+
+Q_DECLARE_TYPEINFO(UnifiedDiff::Span, Q_PRIMITIVE_TYPE);
+Q_DECLARE_TYPEINFO(UnifiedDiff::Line, Q_PRIMITIVE_TYPE);
+Q_DECLARE_TYPEINFO(UnifiedDiff::Hunk, Q_PRIMITIVE_TYPE);
+Q_DECLARE_TYPEINFO(UnifiedDiff::File, Q_PRIMITIVE_TYPE);
@@ -0,0 +1,277 @@
+#include "WordDiff.h"
+
+#include <DiffEngine.h>
+
+#include <QHash>
+
+namespace
+{
+enum class CharType
+{
+   Word,
+   Space,
+   Other
+};
+
+CharType charType(QChar c)
+{
+   if (c.isLetterOrNumber() || c == QLatin1Char('_'))
+      return CharType::Word;
+
+   return c.isSpace() ? CharType::Space : CharType::Other;
+}
+
+// The words and the runs of whitespace are a single token and every other char is a token on its own
+QVector<WordDiff::Range> splitWords(const QString &text)
+{
+   QVector<WordDiff::Range> tokens;
+
+   for (auto start = 0; start < text.length();)
+   {
+      const auto type = charType(text.at(start));
+      auto end = start + 1;
+
+      if (type != CharType::Other)
+      {
+         while (end < text.length() && charType(text.at(end)) == type)
+            ++end;
+      }
+
+      tokens.append({ start, end - start });
+      start = end;
+   }
+
+   return tokens;
+}
+
+QVector<int> internWords(const QString &text, const QVector<WordDiff::Range> &tokens, QHash<QStringRef, int> &ids)
+{
+   QVector<int> tokenIds;
+   tokenIds.reserve(tokens.count());
+
+   for (const auto &token : tokens)
+   {
+      const auto word = text.midRef(token.start, token.length);
+      auto iter = ids.find(word);
+
+      if (iter == ids.end())
+         iter = ids.insert(word, ids.count());
+
+      tokenIds.append(*iter);
+   }
+
+   return tokenIds;
+}
+
+// The tokens that changed next to each other are joined in a single range
+QVector<WordDiff::Range> changedRanges(const QVector<WordDiff::Range> &tokens, const QVector<bool> &matched)
+{
+   QVector<WordDiff::Range> ranges;
+
+   for (auto i = 0; i < tokens.count(); ++i)
+   {
+      if (matched.at(i))
+         continue;
+
+      const auto &token = tokens.at(i);
+
+      if (!ranges.isEmpty() && ranges.last().start + ranges.last().length == token.start)
+         ranges.last().length += token.length;
+      else
+         ranges.append(token);
+   }
+
+   return ranges;
+}
+}
+
+namespace WordDiff
+{
+LineChanges compare(const LinePair &pair)
+{
+   LineChanges changes;
+   changes.oldLine = pair.oldLine;
+   changes.newLine = pair.newLine;
+
+   const auto oldTokens = splitWords(pair.oldText);
+   const auto newTokens = splitWords(pair.newText);
+
+   QHash<QStringRef, int> ids;
+   const auto oldIds = internWords(pair.oldText, oldTokens, ids);
+   const auto newIds = internWords(pair.newText, newTokens, ids);
+
+   QVector<QPair<int, int>> matches;
+
+   if (!DiffEngine::matchSequences(oldIds, newIds, matches))
+      return changes;
+
+   QVector<bool> oldMatched(oldTokens.count(), false);
+   QVector<bool> newMatched(newTokens.count(), false);
+   auto similar = false;
+
+   for (const auto &match : qAsConst(matches))
+   {
+      oldMatched[match.first] = true;
+      newMatched[match.second] = true;
+
+      // Sharing only whitespace doesn't make two lines similar
+      similar = similar || charType(pair.oldText.at(oldTokens.at(match.first).start)) != CharType::Space;
+   }
+
+   if (similar)
+   {
+      changes.oldRanges = changedRanges(oldTokens, oldMatched);
+      changes.newRanges = changedRanges(newTokens, newMatched);
+   }
+
+   return changes;
+}
+
+QVector<LinePair> pairLines(const QString &text, bool startsInHunk)
+{
+   QVector<LinePair> pairs;
+   QVector<LinePair> deleted;
+   auto added = 0;
+   auto inHunk = startsInHunk;
+
+   const auto flush = [&pairs, &deleted, &added]() {
+      deleted.resize(added);
+      pairs.append(deleted);
+      deleted.clear();
+      added = 0;
+   };
+
+   for (auto start = 0, line = 0; start <= text.length(); ++line)
+   {
+      auto end = text.indexOf(QLatin1Char('\n'), start);
+
+      if (end == -1)
+         end = text.length();
+
+      const auto content = text.midRef(start, end - start);
+      const auto prefix = content.isEmpty() ? QChar() : content.at(0);
+
+      start = end + 1;
+
+      if (!inHunk)
+      {
+         // The combined diffs of the merges have more than one prefix and they are not paired
+         inHunk = content.startsWith(QLatin1String("@@ "));
+         continue;
+      }
+
+      if (prefix == QLatin1Char('-'))
+      {
+         if (added > 0)
+            flush();
+
+         LinePair pair;
+         pair.oldLine = line;
+         pair.oldText = content.mid(1).toString();
+
+         deleted.append(pair);
+      }
+      else if (prefix == QLatin1Char('+'))
+      {
+         if (added < deleted.count())
+         {
+            auto &pair = deleted[added++];
+            pair.newLine = line;
+            pair.newText = content.mid(1).toString();
+         }
+      }
+      else
+      {
+         flush();
+
+         if (content.startsWith(QLatin1String("diff ")))
+            inHunk = false;
+      }
+   }
+
+   flush();
+
+   return pairs;
+}
+
+QVector<LinePair> pairLines(const UnifiedDiff &diff)
+{
+   QVector<LinePair> pairs;
+   QVector<LinePair> deleted;
+   auto added = 0;
+
+   const auto flush = [&pairs, &deleted, &added]() {
+      deleted.resize(added);
+      pairs.append(deleted);
+      deleted.clear();
+      added = 0;
+   };
+
+   const auto &lines = diff.lines();
+
+   for (const auto &hunk : diff.hunks())
+   {
+      // The lines of the hunk follow its header
+      for (auto i = 0; i < hunk.lineCount; ++i)
+      {
+         const auto &line = lines.at(hunk.firstLine + i);
+         const auto lineNumber = hunk.line + 1 + i;
+
+         if (line.type == UnifiedDiff::LineType::Deletion)
+         {
+            if (added > 0)
+               flush();
+
+            LinePair pair;
+            pair.oldLine = lineNumber;
+            pair.oldText = diff.text(line.content);
+
+            deleted.append(pair);
+         }
+         else if (line.type == UnifiedDiff::LineType::Addition)
+         {
+            if (added < deleted.count())
+            {
+               auto &pair = deleted[added++];
+               pair.newLine = lineNumber;
+               pair.newText = diff.text(line.content);
+            }
+         }
+         else if (line.type == UnifiedDiff::LineType::Context)
+            flush();
+      }
+
+      flush();
+   }
+
+   return pairs;
+}
+
+QVector<LinePair> pairLines(const DiffInfo &diff)
+{
+   QVector<LinePair> pairs;
+
+   for (const auto &chunk : diff.chunks)
+   {
+      if (!chunk.oldFile.isValid() || !chunk.newFile.isValid())
+         continue;
+
+      const auto count = qMin(chunk.oldFile.endLine - chunk.oldFile.startLine + 1,
+                              chunk.newFile.endLine - chunk.newFile.startLine + 1);
+
+      // The lines of the chunks start at 1
+      for (auto i = 0; i < count; ++i)
+      {
+         LinePair pair;
+         pair.oldLine = chunk.oldFile.startLine - 1 + i;
+         pair.newLine = chunk.newFile.startLine - 1 + i;
+         pair.oldText = diff.oldFileDiff.value(pair.oldLine);
+         pair.newText = diff.newFileDiff.value(pair.newLine);
+
+         pairs.append(pair);
+      }
+   }
+
+   return pairs;
+}
+}
@@ -0,0 +1,97 @@
+#pragma once
+
+/****************************************************************************************
+ ** GitQlient is an application to manage and operate one or several Git repositories. With
+ ** GitQlient you will be able to add commits, branches and manage all the options Git provides.
+ ** Copyright (C) 2021  Francesc Martinez
+ **
+ ** LinkedIn: www.linkedin.com/in/cescmm/
+ ** Web: www.francescmm.com
+ **
+ ** This program is free software; you can redistribute it and/or
+ ** modify it under the terms of the GNU Lesser General Public
+ ** License as published by the Free Software Foundation; either
+ ** version 2 of the License, or (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ ** Lesser General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Lesser General Public
+ ** License along with this library; if not, write to the Free Software
+ ** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ ***************************************************************************************/
+
+
+#include <DiffInfo.h>
+#include <UnifiedDiff.h>
+
+#include <QString>
+#include <QVector>
+
+/**
+ * @brief The WordDiff namespace finds the words that changed between a deleted line and the line added in its place.
+ * The deleted and the added lines of a change are paired in order, like most review tools do.
+ */
+namespace WordDiff
+{
+/**
+ * @brief The Range struct is a range of chars of a line, without its diff prefix.
+ */
+struct Range
+{
+   int start = 0;
+   int length = 0;
+};
+
+/**
+ * @brief The LinePair struct is a deleted line and the line added in its place, with their position in the view.
+ */
+struct LinePair
+{
+   int oldLine = -1;
+   int newLine = -1;
+   QString oldText;
+   QString newText;
+};
+
+/**
+ * @brief The LineChanges struct stores the chars that changed in both lines of a pair.
+ */
+struct LineChanges
+{
+   int oldLine = -1;
+   int newLine = -1;
+   QVector<Range> oldRanges;
+   QVector<Range> newRanges;
+};
+
+/**
+ * @brief compare Finds the words that changed in a pair of lines. The lines are split in words, runs of whitespace and
+ * punctuation chars.
+ * @return The ranges of both lines that changed. They are empty if the lines have nothing in common, since then the
+ * whole lines changed.
+ */
+LineChanges compare(const LinePair &pair);
+
+/**
+ * @brief pairLines Pairs the deleted and the added lines of the changes of a unified diff. The lines of the pairs are
+ * the lines of @p text.
+ * @param text The text of the diff.
+ * @param startsInHunk True if @p text is the content of a hunk without its headers.
+ */
+QVector<LinePair> pairLines(const QString &text, bool startsInHunk);
+
+/**
+ * @brief pairLines Pairs the deleted and the added lines of the hunks of a parsed diff. The lines of the pairs are the
+ * lines of the whole diff and only the text of the paired lines is decoded.
+ */
+QVector<LinePair> pairLines(const UnifiedDiff &diff);
+
+/**
+ * @brief pairLines Pairs the deleted and the added lines of the chunks of a diff split in the old and the new file. The
+ * lines of the pairs are the lines of each file.
+ */
+QVector<LinePair> pairLines(const DiffInfo &diff);
+}
@@ -0,0 +1,147 @@
+#include "WordDiffWorker.h"
+
+#include <QCache>
+#include <QMutex>
+#include <QtConcurrent>
+
+#include <algorithm>
+#include <functional>
+
+namespace
+{
+// Small enough to cancel quickly and to show the visible lines soon
+const int CHUNK_SIZE = 64;
+// Chars of the lines stored in the cache
+const int MAX_CACHE_COST = 8 * 1024 * 1024;
+
+using CacheKey = QPair<QString, QString>;
+using CachedRanges = QPair<QVector<WordDiff::Range>, QVector<WordDiff::Range>>;
+
+// The changes only depend on the content of the lines, so the cache is shared by all the views
+struct ChangesCache
+{
+   QMutex mutex;
+   QCache<CacheKey, CachedRanges> entries { MAX_CACHE_COST };
+};
+
+ChangesCache &changesCache()
+{
+   static ChangesCache cache;
+
+   return cache;
+}
+
+bool findInCache(const WordDiff::LinePair &pair, WordDiff::LineChanges &changes)
+{
+   auto &cache = changesCache();
+   QMutexLocker lock(&cache.mutex);
+
+   if (const auto ranges = cache.entries.object({ pair.oldText, pair.newText }))
+   {
+      changes.oldLine = pair.oldLine;
+      changes.newLine = pair.newLine;
+      changes.oldRanges = ranges->first;
+      changes.newRanges = ranges->second;
+
+      return true;
+   }
+
+   return false;
+}
+
+void storeInCache(const WordDiff::LinePair &pair, const WordDiff::LineChanges &changes)
+{
+   auto &cache = changesCache();
+   QMutexLocker lock(&cache.mutex);
+
+   cache.entries.insert({ pair.oldText, pair.newText }, new CachedRanges(changes.oldRanges, changes.newRanges),
+                        pair.oldText.length() + pair.newText.length());
+}
+}
+
+WordDiffWorker::WordDiffWorker(QObject *parent)
+   : QObject(parent)
+{
+   connect(&mWatcher, &QFutureWatcher<QVector<WordDiff::LineChanges>>::resultsReadyAt, this,
+           &WordDiffWorker::reportChanges);
+}
+
+WordDiffWorker::~WordDiffWorker()
+{
+   cancel();
+}
+
+void WordDiffWorker::start(const QVector<WordDiff::LinePair> &pairs, int firstVisibleLine, int lastVisibleLine)
+{
+   cancel();
+
+   QVector<WordDiff::LineChanges> cachedChanges;
+   QVector<WordDiff::LinePair> pendingPairs;
+
+   for (const auto &pair : pairs)
+   {
+      WordDiff::LineChanges changes;
+
+      if (findInCache(pair, changes))
+         cachedChanges.append(changes);
+      else
+         pendingPairs.append(pair);
+   }
+
+   if (!cachedChanges.isEmpty())
+      emit changesFound(cachedChanges);
+
+   if (pendingPairs.isEmpty())
+      return;
+
+   const auto isVisible = [firstVisibleLine, lastVisibleLine](const WordDiff::LinePair &pair) {
+      return (firstVisibleLine <= pair.oldLine && pair.oldLine <= lastVisibleLine)
+          || (firstVisibleLine <= pair.newLine && pair.newLine <= lastVisibleLine);
+   };
+
+   std::stable_partition(pendingPairs.begin(), pendingPairs.end(), isVisible);
+
+   QVector<QVector<WordDiff::LinePair>> chunks;
+
+   for (auto i = 0; i < pendingPairs.count(); i += CHUNK_SIZE)
+      chunks.append(pendingPairs.mid(i, CHUNK_SIZE));
+
+   std::function<QVector<WordDiff::LineChanges>(const QVector<WordDiff::LinePair> &)> compareChunk
+       = [](const QVector<WordDiff::LinePair> &chunk) {
+            QVector<WordDiff::LineChanges> changes;
+            changes.reserve(chunk.count());
+
+            for (const auto &pair : chunk)
+            {
+               changes.append(WordDiff::compare(pair));
+               storeInCache(pair, changes.last());
+            }
+
+            return changes;
+         };
+
+   mWatcher.setFuture(QtConcurrent::mapped(chunks, compareChunk));
+}
+
+void WordDiffWorker::cancel()
+{
+   if (mWatcher.isRunning())
+   {
+      mWatcher.cancel();
+      mWatcher.waitForFinished();
+   }
+}
+
+void WordDiffWorker::reportChanges(int begin, int end)
+{
+   if (mWatcher.isCanceled())
+      return;
+
+   QVector<WordDiff::LineChanges> changes;
+   const auto future = mWatcher.future();
+
+   for (auto i = begin; i < end; ++i)
+      changes.append(future.resultAt(i));
+
+   emit changesFound(changes);
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+/****************************************************************************************
+ ** GitQlient is an application to manage and operate one or several Git repositories. With
+ ** GitQlient you will be able to add commits, branches and manage all the options Git provides.
+ ** Copyright (C) 2021  Francesc Martinez
+ **
+ ** LinkedIn: www.linkedin.com/in/cescmm/
+ ** Web: www.francescmm.com
+ **
+ ** This program is free software; you can redistribute it and/or
+ ** modify it under the terms of the GNU Lesser General Public
+ ** License as published by the Free Software Foundation; either
+ ** version 2 of the License, or (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ ** Lesser General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Lesser General Public
+ ** License along with this library; if not, write to the Free Software
+ ** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ ***************************************************************************************/
+
+
+#include <WordDiff.h>
+
+#include <QFutureWatcher>
+#include <QObject>
+#include <QVector>
+
+/**
+ * @brief The WordDiffWorker class compares the pairs of changed lines of a diff word by word in the global thread pool,
+ * so opening a diff doesn't wait for it. The pairs are compared in groups and the changes are reported as soon as a
+ * group is done, starting with the pairs that are visible.
+ *
+ * The changes are cached by the content of the lines and shared by all the views, so opening a diff again reports them
+ * right away. Starting a new comparison cancels the previous one.
+ */
+class WordDiffWorker : public QObject
+{
+   Q_OBJECT
+
+signals:
+   /**
+    * @brief changesFound Signal triggered every time a group of pairs of lines has been compared.
+    * @param changes The chars that changed in every pair of the group.
+    */
+   void changesFound(const QVector<WordDiff::LineChanges> &changes);
+
+public:
+   explicit WordDiffWorker(QObject *parent = nullptr);
+   ~WordDiffWorker() override;
+
+   /**
+    * @brief start Compares @p pairs in the background. The pairs that are already cached are reported before it
+    * returns.
+    * @param pairs The pairs of lines to compare.
+    * @param firstVisibleLine The first line that is visible. The pairs with lines between it and @p lastVisibleLine
+    * are compared first.
+    * @param lastVisibleLine The last line that is visible.
+    */
+   void start(const QVector<WordDiff::LinePair> &pairs, int firstVisibleLine, int lastVisibleLine);
+
+   /**
+    * @brief cancel Stops the current comparison. The changes that were not reported yet are discarded.
+    */
+   void cancel();
+
+private:
+   QFutureWatcher<QVector<WordDiff::LineChanges>> mWatcher;
+
+   void reportChanges(int begin, int end);
+};
@@ -136,13 +136,24 @@ void AGitProcess::onCancel()
    waitForFinished();
 }
 
+void AGitProcess::onAbort()
+{
+   mCanceling = true;
+
+   if (state() != QProcess::NotRunning)
+      kill();
+}
+
 void AGitProcess::onReadyStandardOutput()
 {
    if (!mCanceling)
    {
       const auto standardOutput = readAllStandardOutput();
 
-      mRunOutput.append(QString::fromUtf8(standardOutput));
+      if (mKeepRawOutput)
+         mRawOutput.append(standardOutput);
+      else if (mKeepOutput)
+         mRunOutput.append(QString::fromUtf8(standardOutput));
 
       emit procDataReady(standardOutput);
    }
@@ -152,29 +163,50 @@ bool AGitProcess::execute(const QString &command)
 {
    mCommand = command;
 
-   auto processStarted = false;
    auto arguments = splitArgList(mCommand);
 
-   if (!arguments.isEmpty())
-   {
-      QStringList env = QProcess::systemEnvironment();
-      env << "GIT_TRACE=0"; // avoid choking on debug traces
-      env << "GIT_FLUSH=0"; // skip the fflush() in 'git log'
-      env << loginApp();
+   if (arguments.isEmpty())
+      return false;
+
+   const auto program = arguments.takeFirst();
+
+   return startProcess(program, arguments);
+}
+
+bool AGitProcess::execute(const QStringList &arguments)
+{
+   mCommand = QString("git %1").arg(arguments.join(' '));
+
+   return startProcess(QString("git"), arguments);
+}
+
+bool AGitProcess::startProcess(const QString &program, const QStringList &arguments)
+{
+   QStringList env = QProcess::systemEnvironment();
+   env << "GIT_TRACE=0"; // avoid choking on debug traces
+   env << "GIT_FLUSH=0"; // skip the fflush() in 'git log'
+   env << loginApp();
 
-      const auto gitAlternative = GitQlientSettings().globalValue("gitLocation", "").toString();
+   const auto gitAlternative = GitQlientSettings().globalValue("gitLocation", "").toString();
 
-      setEnvironment(env);
-      setProgram(gitAlternative.isEmpty() ? arguments.takeFirst() : gitAlternative);
-      setArguments(arguments);
-      start();
+   setEnvironment(env);
+   setProgram(gitAlternative.isEmpty() ? program : gitAlternative);
+   setArguments(arguments);
+   start();
 
-      processStarted = waitForStarted();
+   const auto processStarted = waitForStarted();
 
-      if (!processStarted)
-         QLog_Warning("Git", QString("Unable to start the process:\n%1\nMore info:\n%2").arg(mCommand, errorString()));
-      else
-         QLog_Debug("Git", QString("Process started: %1").arg(mCommand));
+   if (!processStarted)
+      QLog_Warning("Git", QString("Unable to start the process:\n%1\nMore info:\n%2").arg(mCommand, errorString()));
+   else
+   {
+      QLog_Debug("Git", QString("Process started: %1").arg(mCommand));
+
+      if (!mInput.isNull())
+      {
+         write(mInput);
+         closeWriteChannel();
+      }
    }
 
    return processStarted;
@@ -197,6 +229,8 @@ void AGitProcess::onFinished(int exitCode, QProcess::ExitStatus exitStatus)
       if (!mErrorOutput.isEmpty())
          mRunOutput = mErrorOutput;
    }
+   else if (mKeepRawOutput)
+      mRawOutput.append(readAllStandardOutput());
    else
       mRunOutput.append(readAllStandardOutput() + mErrorOutput);
 }
@@ -38,18 +38,38 @@ public:
    explicit AGitProcess(const QString &workingDir);
 
    virtual GitExecResult run(const QString &command) = 0;
+   /**
+    * @brief setInput Sets the data written to the standard input of Git once it starts. It's used to pass long lists
+    * of revisions with --stdin instead of the command line, that has a limited length.
+    */
+   void setInput(const QByteArray &input) { mInput = input; }
    void onCancel();
+   /**
+    * @brief onAbort Stops the process without waiting for it. Nothing else is delivered once it's called.
+    */
+   void onAbort();
 
 protected:
    QString mRunOutput;
+   // The output of the commands with NUL separators, that is cut at the first one when it's converted to text
+   QByteArray mRawOutput;
    QString mWorkingDirectory;
    QString mErrorOutput;
    QString mCommand;
+   QByteArray mInput;
    bool mRealError = false;
    bool mCanceling = false;
+   bool mKeepOutput = true;
+   bool mKeepRawOutput = false;
    bool execute(const QString &command);
+   /**
+    * @brief execute Starts Git with the arguments as they are. It's used when an argument comes from the user and it
+    * can't be parsed from a command line.
+    */
+   bool execute(const QStringList &arguments);
    virtual void onFinished(int exitCode, QProcess::ExitStatus exitStatus);
 
 private:
+   bool startProcess(const QString &program, const QStringList &arguments);
    void onReadyStandardOutput();
 };
@@ -7,21 +7,27 @@ HEADERS += \
     $$PWD/GitBranches.h \
     $$PWD/GitCloneProcess.h \
     $$PWD/GitConfig.h \
+    $$PWD/GitContentSearch.h \
     $$PWD/GitCredentials.h \
     $$PWD/GitExecResult.h \
     $$PWD/GitHistory.h \
+    $$PWD/GitJobScheduler.h \
     $$PWD/GitLocal.h \
     $$PWD/GitMerge.h \
+    $$PWD/GitObjectReader.h \
     $$PWD/GitPatches.h \
+    $$PWD/GitRefsReader.h \
     $$PWD/GitRemote.h \
     $$PWD/GitRepoLoader.h \
+    $$PWD/GitRepoWatcher.h \
     $$PWD/GitRequestorProcess.h \
     $$PWD/GitStashes.h \
     $$PWD/GitSubmodules.h \
     $$PWD/GitSubtree.h \
     $$PWD/GitSyncProcess.h \
     $$PWD/GitTags.h \
-    $$PWD/GitWip.h
+    $$PWD/GitWip.h \
+    $$PWD/GitWipUpdater.h
 
 SOURCES += \
     $$PWD/AGitProcess.cpp \
@@ -30,18 +36,24 @@ SOURCES += \
     $$PWD/GitBranches.cpp \
     $$PWD/GitCloneProcess.cpp \
     $$PWD/GitConfig.cpp \
+    $$PWD/GitContentSearch.cpp \
     $$PWD/GitCredentials.cpp \
     $$PWD/GitExecResult.cpp \
     $$PWD/GitHistory.cpp \
+    $$PWD/GitJobScheduler.cpp \
     $$PWD/GitLocal.cpp \
     $$PWD/GitMerge.cpp \
+    $$PWD/GitObjectReader.cpp \
     $$PWD/GitPatches.cpp \
+    $$PWD/GitRefsReader.cpp \
     $$PWD/GitRemote.cpp \
     $$PWD/GitRepoLoader.cpp \
+    $$PWD/GitRepoWatcher.cpp \
     $$PWD/GitRequestorProcess.cpp \
     $$PWD/GitStashes.cpp \
     $$PWD/GitSubmodules.cpp \
     $$PWD/GitSubtree.cpp \
     $$PWD/GitSyncProcess.cpp \
     $$PWD/GitTags.cpp \
-    $$PWD/GitWip.cpp
+    $$PWD/GitWip.cpp \
+    $$PWD/GitWipUpdater.cpp
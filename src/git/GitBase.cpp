@@ -44,9 +44,10 @@ QString GitBase::getGitDir() const
    return mGitDirectory;
 }
 
-GitExecResult GitBase::run(const QString &cmd) const
+GitExecResult GitBase::run(const QString &cmd, const QByteArray &input) const
 {
    GitSyncProcess p(mWorkingDirectory);
+   p.setInput(input);
 
    const auto ret = p.run(cmd);
    const auto runOutput = ret.output;
@@ -59,6 +60,19 @@ GitExecResult GitBase::run(const QString &cmd) const
    return ret;
 }
 
+std::optional<QByteArray> GitBase::runRaw(const QStringList &arguments, const QByteArray &input) const
+{
+   GitSyncProcess p(mWorkingDirectory);
+   p.setInput(input);
+
+   const auto ret = p.runRaw(arguments);
+
+   if (!ret)
+      QLog_Warning("Git", QString("Git command {git %1} has errors.").arg(arguments.join(' ')));
+
+   return ret;
+}
+
 void GitBase::updateCurrentBranch()
 {
    QLog_Trace("Git", "Updating the cached current branch");
@@ -92,3 +106,13 @@ GitExecResult GitBase::getLastCommit() const
 
    return ret;
 }
+
+void GitBase::invalidateRemoteTags()
+{
+   ++mRemoteTagsVersion;
+}
+
+int GitBase::remoteTagsVersion() const
+{
+   return mRemoteTagsVersion.load();
+}
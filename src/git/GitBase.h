@@ -25,12 +25,29 @@
 
 #include <GitExecResult.h>
 
+#include <QByteArray>
+#include <QStringList>
+
+#include <atomic>
+#include <optional>
+
 class GitBase final
 {
 public:
    explicit GitBase(const QString &workingDirectory);
 
-   GitExecResult run(const QString &cmd) const;
+   /**
+    * @brief run Runs a Git command and waits for it to finish.
+    * @param input The data written to the standard input of the command, if any.
+    */
+   GitExecResult run(const QString &cmd, const QByteArray &input = QByteArray()) const;
+   /**
+    * @brief runRaw Runs Git with the given arguments and returns its output as bytes. It's used by the commands whose
+    * output has NUL separators.
+    * @param input The data written to the standard input of the command, if any.
+    * @return The output or nothing if the command failed.
+    */
+   std::optional<QByteArray> runRaw(const QStringList &arguments, const QByteArray &input = QByteArray()) const;
 
    QString getWorkingDir() const;
 
@@ -44,8 +61,19 @@ public:
 
    GitExecResult getLastCommit() const;
 
+   /**
+    * @brief invalidateRemoteTags Marks the remote tags read before as outdated. It's called by the operations that
+    * push, fetch or change the tags of the remote.
+    */
+   void invalidateRemoteTags();
+   /**
+    * @brief remoteTagsVersion Returns the number of times the remote tags were invalidated.
+    */
+   int remoteTagsVersion() const;
+
 protected:
    QString mWorkingDirectory;
    QString mGitDirectory;
    QString mCurrentBranch;
+   std::atomic<int> mRemoteTagsVersion { 0 };
 };
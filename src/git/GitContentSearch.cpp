@@ -0,0 +1,114 @@
+#include "GitContentSearch.h"
+
+#include <GitBase.h>
+#include <GitRequestorProcess.h>
+
+#include <QLogger.h>
+
+using namespace QLogger;
+
+GitContentSearch::GitContentSearch(const QSharedPointer<GitBase> &gitBase, QObject *parent)
+   : QObject(parent)
+   , mGitBase(gitBase)
+{
+}
+
+GitContentSearch::~GitContentSearch()
+{
+   cancel();
+}
+
+bool GitContentSearch::start(const Options &options)
+{
+   cancel();
+
+   if (options.text.isEmpty())
+      return false;
+
+   QLog_Debug("Git", QString("Searching the changes that contain {%1}").arg(options.text));
+
+   // The text is passed as it is: it can have quotes or spaces that the command line parser would break
+   QStringList arguments { "log", "--no-color", "--pretty=format:%H" };
+   arguments.append(options.allBranches ? QString("--all") : QString("HEAD"));
+
+   if (options.mode == Mode::Occurrences)
+      arguments.append(QString("-S%1").arg(options.text));
+   else
+      arguments.append(QString("-G%1").arg(options.text));
+
+   if (options.since.isValid())
+      arguments.append(QString("--since=%1").arg(options.since.toString(Qt::ISODate)));
+
+   if (options.until.isValid())
+      arguments.append(QString("--until=%1").arg(options.until.toString(Qt::ISODate)));
+
+   arguments.append(QString("--"));
+
+   if (!options.path.isEmpty())
+      arguments.append(options.path);
+
+   const auto requestor = new GitRequestorProcess(mGitBase->getWorkingDir(), GitRequestorProcess::Mode::Streaming);
+   connect(requestor, &GitRequestorProcess::procDataReady, this, &GitContentSearch::processOutput);
+   connect(requestor, &GitRequestorProcess::procStreamFinished, this, &GitContentSearch::onProcessFinished);
+   connect(this, &GitContentSearch::abortSearch, requestor, &AGitProcess::onAbort);
+
+   mRunning = requestor->run(arguments).success;
+
+   return mRunning;
+}
+
+void GitContentSearch::cancel()
+{
+   if (mRunning)
+   {
+      QLog_Debug("Git", "Cancelling the search in the changes");
+
+      emit abortSearch(QPrivateSignal());
+
+      // The process is deleted by itself once it finishes
+      disconnect(this, &GitContentSearch::abortSearch, nullptr, nullptr);
+   }
+
+   mRunning = false;
+   mFound = 0;
+   mPendingOutput.clear();
+}
+
+void GitContentSearch::processOutput(const QByteArray &data)
+{
+   mPendingOutput.append(data);
+
+   const auto lastLineEnd = mPendingOutput.lastIndexOf('\n');
+
+   if (lastLineEnd < 0)
+      return;
+
+   QStringList shas;
+
+   for (const auto &line : mPendingOutput.left(lastLineEnd).split('\n'))
+   {
+      if (!line.isEmpty())
+         shas.append(QString::fromUtf8(line));
+   }
+
+   mPendingOutput.remove(0, lastLineEnd + 1);
+
+   if (!shas.isEmpty())
+   {
+      mFound += shas.count();
+
+      emit shasFound(shas);
+   }
+}
+
+void GitContentSearch::onProcessFinished(bool success)
+{
+   // The last SHA is not followed by a new line
+   processOutput(QByteArray("\n"));
+
+   mRunning = false;
+
+   QLog_Debug("Git", QString("The search in the changes found {%1} commits").arg(mFound));
+
+   emit finished(success);
+}
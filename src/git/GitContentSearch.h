@@ -0,0 +1,128 @@
+#pragma once
+
+/****************************************************************************************
+ ** GitQlient is an application to manage and operate one or several Git repositories. With
+ ** GitQlient you will be able to add commits, branches and manage all the options Git provides.
+ ** Copyright (C) 2021  Francesc Martinez
+ **
+ ** LinkedIn: www.linkedin.com/in/cescmm/
+ ** Web: www.francescmm.com
+ **
+ ** This program is free software; you can redistribute it and/or
+ ** modify it under the terms of the GNU Lesser General Public
+ ** License as published by the Free Software Foundation; either
+ ** version 2 of the License, or (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ ** Lesser General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Lesser General Public
+ ** License along with this library; if not, write to the Free Software
+ ** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ ***************************************************************************************/
+
+
+#include <QDateTime>
+#include <QObject>
+#include <QSharedPointer>
+#include <QStringList>
+
+class GitBase;
+
+/**
+ * @brief The GitContentSearch class looks for the commits whose changes contain a text (git log -S, also known as
+ * pickaxe) or whose diff matches a regular expression (git log -G). Git has to diff every commit so the search runs as
+ * a background process that can be cancelled, and the SHAs are delivered in chunks as soon as Git prints them.
+ */
+class GitContentSearch : public QObject
+{
+   Q_OBJECT
+
+signals:
+   /**
+    * @brief shasFound Signal triggered every time Git reports new matching commits.
+    * @param shas The SHAs found since the last time the signal was emitted.
+    */
+   void shasFound(const QStringList &shas);
+   /**
+    * @brief finished Signal triggered when Git finishes the search. It's not emitted if the search is cancelled.
+    * @param success False if Git failed, for instance because the regular expression is not valid.
+    */
+   void finished(bool success);
+   /**
+    * @brief abortSearch Internal signal to stop the running process.
+    */
+   void abortSearch(QPrivateSignal);
+
+public:
+   enum class Mode
+   {
+      Occurrences,
+      Changes
+   };
+
+   struct Options
+   {
+      /**
+       * @brief text The text to search.
+       */
+      QString text;
+      /**
+       * @brief mode Occurrences looks for the commits that change the number of occurrences of the text (-S). Changes
+       * looks for the commits whose diff has a line that matches the text as a regular expression (-G).
+       */
+      Mode mode = Mode::Occurrences;
+      /**
+       * @brief path Limits the search to the changes in this path. The whole tree is searched if it's empty.
+       */
+      QString path;
+      /**
+       * @brief since Limits the search to the commits done after this date if it's valid.
+       */
+      QDateTime since;
+      /**
+       * @brief until Limits the search to the commits done before this date if it's valid.
+       */
+      QDateTime until;
+      /**
+       * @brief allBranches Searches in all the references instead of the current branch.
+       */
+      bool allBranches = true;
+   };
+
+   explicit GitContentSearch(const QSharedPointer<GitBase> &gitBase, QObject *parent = nullptr);
+   ~GitContentSearch() override;
+
+   /**
+    * @brief start Cancels the running search, if any, and starts a new one.
+    * @param options The text to search and the limits of the search.
+    * @return True if Git was started.
+    */
+   bool start(const Options &options);
+
+   /**
+    * @brief cancel Stops the running search. No more signals are emitted for it.
+    */
+   void cancel();
+
+   /**
+    * @brief isRunning Tells if there is a search running.
+    */
+   bool isRunning() const { return mRunning; }
+
+   /**
+    * @brief foundCount Returns the number of commits found by the last search.
+    */
+   int foundCount() const { return mFound; }
+
+private:
+   QSharedPointer<GitBase> mGitBase;
+   QByteArray mPendingOutput;
+   int mFound = 0;
+   bool mRunning = false;
+
+   void processOutput(const QByteArray &data);
+   void onProcessFinished(bool success);
+};
@@ -44,7 +44,7 @@ GitExecResult GitHistory::history(const QString &file)
    return ret;
 }
 
-GitExecResult GitHistory::getBranchesDiff(const QString &base, const QString &head)
+std::optional<QByteArray> GitHistory::getBranchesDiff(const QString &base, const QString &head)
 {
    QLog_Debug("Git", QString("Getting diff between branches: {%1} and {%2}").arg(base, head));
 
@@ -62,41 +62,45 @@ GitExecResult GitHistory::getBranchesDiff(const QString &base, const QString &he
    if (retHead.success)
       fullHead.prepend(retHead.output + QStringLiteral("/"));
 
-   const auto cmd = QString("git diff %1...%2").arg(fullBase, fullHead);
+   // The diff is kept as bytes: it's parsed without decoding it
+   const QStringList arguments { "diff", QString("%1...%2").arg(fullBase, fullHead) };
 
-   QLog_Trace("Git", QString("Getting diff between branches: {%1}").arg(cmd));
+   QLog_Trace("Git", QString("Getting diff between branches: {git %1}").arg(arguments.join(' ')));
 
-   return mGitBase->run(cmd);
+   return mGitBase->runRaw(arguments);
 }
 
-GitExecResult GitHistory::getCommitDiff(const QString &sha, const QString &diffToSha)
+std::optional<QByteArray> GitHistory::getCommitDiff(const QString &sha, const QString &diffToSha)
 {
    if (!sha.isEmpty())
    {
       QLog_Debug("Git", QString("Executing diff for commit: {%1} to {%2}").arg(sha, diffToSha));
 
-      QString runCmd = QString("git diff-tree --no-color -r --patch-with-stat -m");
+      QStringList arguments { "diff-tree", "--no-color", "-r", "--patch-with-stat", "-m" };
 
       if (sha != CommitInfo::ZERO_SHA)
       {
-         runCmd += " -C ";
+         arguments << "-C";
 
+         // diffToSha could be empty
          if (diffToSha.isEmpty())
-            runCmd += " --root ";
+            arguments << "--root";
+         else
+            arguments << diffToSha;
 
-         runCmd.append(QString("%1 %2").arg(diffToSha, sha)); // diffToSha could be empty
+         arguments << sha;
       }
       else
-         runCmd = "git diff HEAD ";
+         arguments = QStringList { "diff", "HEAD" };
 
-      QLog_Trace("Git", QString("Executing diff for commit: {%1}").arg(runCmd));
+      QLog_Trace("Git", QString("Executing diff for commit: {git %1}").arg(arguments.join(' ')));
 
-      return mGitBase->run(runCmd);
+      return mGitBase->runRaw(arguments);
    }
    else
       QLog_Warning("Git", QString("Executing getCommitDiff with empty SHA"));
 
-   return qMakePair(false, QString());
+   return std::nullopt;
 }
 
 GitExecResult GitHistory::getFileDiff(const QString &currentSha, const QString &previousSha, const QString &file,
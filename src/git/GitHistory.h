@@ -25,8 +25,11 @@
 
 #include <GitExecResult.h>
 
+#include <QByteArray>
 #include <QSharedPointer>
 
+#include <optional>
+
 class GitBase;
 
 class GitHistory
@@ -36,8 +39,15 @@ public:
 
    GitExecResult blame(const QString &file, const QString &commitFrom);
    GitExecResult history(const QString &file);
-   GitExecResult getBranchesDiff(const QString &base, const QString &head);
-   GitExecResult getCommitDiff(const QString &sha, const QString &diffToSha);
+   /**
+    * @brief getBranchesDiff Returns the diff between two branches as Git writes it, or nothing if it failed.
+    */
+   std::optional<QByteArray> getBranchesDiff(const QString &base, const QString &head);
+   /**
+    * @brief getCommitDiff Returns the full diff of @p sha against @p diffToSha as Git writes it, or nothing if it
+    * failed.
+    */
+   std::optional<QByteArray> getCommitDiff(const QString &sha, const QString &diffToSha);
    GitExecResult getFileDiff(const QString &currentSha, const QString &previousSha, const QString &file, bool isStaged);
    GitExecResult getDiffFiles(const QString &sha, const QString &diffToSha);
    GitExecResult getUntrackedFileDiff(const QString &file) const;
@@ -0,0 +1,201 @@
+#include "GitJobScheduler.h"
+
+#include <GitRequestorProcess.h>
+
+#include <QLogger.h>
+
+using namespace QLogger;
+
+GitJob::GitJob(GitJobScheduler *scheduler, GitJobPriority priority, const QStringList &arguments)
+   : QObject(scheduler)
+   , mScheduler(scheduler)
+   , mArguments(arguments)
+   , mPriority(priority)
+{
+   mTimer.start();
+}
+
+void GitJob::cancel()
+{
+   if (--mRequests == 0)
+      mScheduler->cancel(this);
+}
+
+GitJobScheduler::GitJobScheduler(const QString &workingDir, int maxRunning, QObject *parent)
+   : QObject(parent)
+   , mWorkingDir(workingDir)
+   , mMaxRunning(qMax(1, maxRunning))
+{
+}
+
+GitJobScheduler::~GitJobScheduler()
+{
+   cancelAll();
+
+   for (auto iter = mStats.cbegin(); iter != mStats.cend(); ++iter)
+   {
+      const auto &stats = iter.value();
+
+      QLog_Info("Git",
+                QString("Git {%1} ran {%2} times ({%3} failed, {%4} cancelled): {%5} ms running, {%6} ms the longest, "
+                        "{%7} ms waiting.")
+                    .arg(iter.key())
+                    .arg(stats.runs)
+                    .arg(stats.failures)
+                    .arg(stats.cancellations)
+                    .arg(stats.runTime)
+                    .arg(stats.maxRunTime)
+                    .arg(stats.waitTime));
+   }
+}
+
+GitJob *GitJobScheduler::schedule(GitJobPriority priority, const QStringList &arguments)
+{
+   for (auto &lane : mLanes)
+   {
+      for (const auto job : qAsConst(lane))
+      {
+         if (job->mArguments != arguments)
+            continue;
+
+         ++job->mRequests;
+
+         if (priority < job->mPriority)
+         {
+            lane.removeOne(job);
+            job->mPriority = priority;
+            mLanes[static_cast<int>(priority)].append(job);
+         }
+
+         QLog_Trace("Git", QString("The job {git %1} is already waiting.").arg(arguments.join(' ')));
+
+         return job;
+      }
+   }
+
+   const auto job = new GitJob(this, priority, arguments);
+   mLanes[static_cast<int>(priority)].append(job);
+
+   // The job is started once the caller has connected to it
+   QMetaObject::invokeMethod(this, &GitJobScheduler::startJobs, Qt::QueuedConnection);
+
+   return job;
+}
+
+void GitJobScheduler::cancelAll()
+{
+   for (auto &lane : mLanes)
+   {
+      while (!lane.isEmpty())
+         cancel(lane.constFirst());
+   }
+
+   while (!mRunning.isEmpty())
+      cancel(mRunning.constFirst());
+}
+
+QString GitJobScheduler::commandName(const QStringList &arguments)
+{
+   for (const auto &argument : arguments)
+   {
+      if (!argument.startsWith('-'))
+         return argument;
+   }
+
+   return QString("git");
+}
+
+bool GitJobScheduler::canStart(GitJobPriority priority) const
+{
+   const auto maxRunning = priority == GitJobPriority::Background ? qMax(1, mMaxRunning - 1) : mMaxRunning;
+
+   return mRunning.count() < maxRunning;
+}
+
+void GitJobScheduler::startJobs()
+{
+   for (auto &lane : mLanes)
+   {
+      while (!lane.isEmpty() && canStart(lane.constFirst()->mPriority))
+         start(lane.takeFirst());
+
+      // The jobs with less priority wait until this lane is empty
+      if (!lane.isEmpty())
+         return;
+   }
+}
+
+void GitJobScheduler::start(GitJob *job)
+{
+   job->mWaitTime = job->mTimer.restart();
+
+   const auto process = new GitRequestorProcess(mWorkingDir);
+   connect(process, &GitRequestorProcess::procDataReady, job,
+           [job](const QByteArray &output) { job->mOutput = output; });
+   connect(process, static_cast<void (QProcess::*)(int, QProcess::ExitStatus)>(&QProcess::finished), job,
+           [this, job](int exitCode, QProcess::ExitStatus exitStatus) {
+              finish(job, exitStatus == QProcess::NormalExit && exitCode == 0);
+           });
+
+   job->mProcess = process;
+   mRunning.append(job);
+
+   if (!process->run(job->mArguments).success)
+   {
+      process->deleteLater();
+      finish(job, false);
+   }
+}
+
+void GitJobScheduler::finish(GitJob *job, bool success)
+{
+   if (!mRunning.removeOne(job))
+      return;
+
+   const auto runTime = job->mTimer.elapsed();
+   auto &stats = mStats[commandName(job->mArguments)];
+
+   ++stats.runs;
+   stats.failures += success ? 0 : 1;
+   stats.waitTime += job->mWaitTime;
+   stats.runTime += runTime;
+   stats.maxRunTime = qMax(stats.maxRunTime, runTime);
+
+   QLog_Debug("Git",
+              QString("Job {git %1} waited {%2} ms and ran {%3} ms.")
+                  .arg(job->mArguments.join(' '))
+                  .arg(job->mWaitTime)
+                  .arg(runTime));
+
+   emit job->finished(success, job->mOutput);
+
+   job->deleteLater();
+
+   startJobs();
+}
+
+void GitJobScheduler::cancel(GitJob *job)
+{
+   auto &lane = mLanes[static_cast<int>(job->mPriority)];
+
+   if (!lane.removeOne(job))
+   {
+      if (!mRunning.removeOne(job))
+         return;
+
+      if (job->mProcess)
+      {
+         // The process deletes itself once it's killed
+         disconnect(job->mProcess, nullptr, job, nullptr);
+         job->mProcess->onAbort();
+      }
+
+      ++mStats[commandName(job->mArguments)].cancellations;
+
+      startJobs();
+   }
+
+   QLog_Debug("Git", QString("Job {git %1} cancelled.").arg(job->mArguments.join(' ')));
+
+   job->deleteLater();
+}
@@ -0,0 +1,170 @@
+#pragma once
+
+/****************************************************************************************
+ ** GitQlient is an application to manage and operate one or several Git repositories. With
+ ** GitQlient you will be able to add commits, branches and manage all the options Git provides.
+ ** Copyright (C) 2021  Francesc Martinez
+ **
+ ** LinkedIn: www.linkedin.com/in/cescmm/
+ ** Web: www.francescmm.com
+ **
+ ** This program is free software; you can redistribute it and/or
+ ** modify it under the terms of the GNU Lesser General Public
+ ** License as published by the Free Software Foundation; either
+ ** version 2 of the License, or (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ ** Lesser General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Lesser General Public
+ ** License along with this library; if not, write to the Free Software
+ ** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ ***************************************************************************************/
+
+
+#include <QElapsedTimer>
+#include <QHash>
+#include <QList>
+#include <QObject>
+#include <QPointer>
+#include <QStringList>
+
+class GitJobScheduler;
+class GitRequestorProcess;
+
+/**
+ * @brief The GitJobPriority enum sets the lane where a job waits. The jobs of a lane don't start while there are jobs
+ * waiting in a lane with more priority.
+ */
+enum class GitJobPriority
+{
+   /**
+    * @brief Interactive Jobs the user is waiting for.
+    */
+   Interactive,
+   /**
+    * @brief Refresh Jobs that update what the user is seeing.
+    */
+   Refresh,
+   /**
+    * @brief Background Jobs nobody is waiting for, like the automatic fetch.
+    */
+   Background
+};
+
+/**
+ * @brief The GitJob class is a Git command scheduled in a GitJobScheduler. It's also the token to cancel it.
+ *
+ * The same job is given to everyone that schedules the same command while it's waiting, so it's only cancelled once
+ * all of them cancel it. The job is deleted once it finishes or it's cancelled.
+ */
+class GitJob : public QObject
+{
+   Q_OBJECT
+
+signals:
+   /**
+    * @brief finished Signal triggered when the Git process finishes. It's not triggered if the job is cancelled.
+    * @param success True if Git finished with exit code 0.
+    * @param output The standard output of Git.
+    */
+   void finished(bool success, const QByteArray &output);
+
+public:
+   QStringList arguments() const { return mArguments; }
+   GitJobPriority priority() const { return mPriority; }
+
+   /**
+    * @brief cancel Cancels the job for the one who scheduled it. A waiting job is removed from its lane and a running
+    * one is aborted when nobody else is waiting for it.
+    */
+   void cancel();
+
+private:
+   friend class GitJobScheduler;
+
+   GitJobScheduler *mScheduler = nullptr;
+   QStringList mArguments;
+   GitJobPriority mPriority;
+   QElapsedTimer mTimer;
+   qint64 mWaitTime = 0;
+   int mRequests = 1;
+   QPointer<GitRequestorProcess> mProcess;
+   QByteArray mOutput;
+
+   GitJob(GitJobScheduler *scheduler, GitJobPriority priority, const QStringList &arguments);
+};
+
+/**
+ * @brief The GitJobScheduler class runs the Git commands of a repository in the background. The commands wait in a
+ * lane for their priority and a limited number of them run at the same time. One of the places is kept for the jobs
+ * that are not in the background, so a slow fetch doesn't delay a refresh.
+ *
+ * A command that is already waiting is not scheduled again: the waiting job is given instead, and it's moved to the
+ * lane with more priority if needed.
+ *
+ * The time every command waits and runs is logged and added to the statistics of the scheduler.
+ */
+class GitJobScheduler : public QObject
+{
+   Q_OBJECT
+
+public:
+   struct Stats
+   {
+      int runs = 0;
+      int failures = 0;
+      int cancellations = 0;
+      qint64 waitTime = 0;
+      qint64 runTime = 0;
+      qint64 maxRunTime = 0;
+   };
+
+   /**
+    * @brief Default constructor.
+    * @param workingDir The working directory where Git runs.
+    * @param maxRunning The number of Git processes that can run at the same time.
+    * @param parent The parent object if needed.
+    */
+   explicit GitJobScheduler(const QString &workingDir, int maxRunning = 3, QObject *parent = nullptr);
+   ~GitJobScheduler() override;
+
+   /**
+    * @brief schedule Schedules a Git command.
+    * @param priority The priority of the command.
+    * @param arguments The arguments of Git, without the git program.
+    * @return The job of the command. It's owned by the scheduler.
+    */
+   GitJob *schedule(GitJobPriority priority, const QStringList &arguments);
+
+   /**
+    * @brief cancelAll Cancels all the jobs, including the ones that are running.
+    */
+   void cancelAll();
+
+   /**
+    * @brief stats Returns the statistics of the jobs that finished, by Git command (e.g. status or fetch).
+    */
+   QHash<QString, Stats> stats() const { return mStats; }
+
+private:
+   friend class GitJob;
+
+   static constexpr int TOTAL_LANES = 3;
+
+   QString mWorkingDir;
+   int mMaxRunning = 0;
+   QList<GitJob *> mLanes[TOTAL_LANES];
+   QList<GitJob *> mRunning;
+   QHash<QString, Stats> mStats;
+
+   static QString commandName(const QStringList &arguments);
+
+   bool canStart(GitJobPriority priority) const;
+   void startJobs();
+   void start(GitJob *job);
+   void finish(GitJob *job, bool success);
+   void cancel(GitJob *job);
+};
@@ -0,0 +1,132 @@
+#include "GitObjectReader.h"
+
+#include <GitQlientSettings.h>
+
+#include <QLogger.h>
+
+#include <QProcess>
+
+using namespace QLogger;
+
+namespace
+{
+const int START_TIMEOUT = 5000;
+const int READ_TIMEOUT = 5000;
+// Bigger blobs are not worth keeping in memory to compare them
+const qint64 MAX_BLOB_SIZE = 64 * 1024 * 1024;
+}
+
+GitObjectReader::GitObjectReader(const QString &workingDir, QObject *parent)
+   : QObject(parent)
+   , mWorkingDir(workingDir)
+{
+}
+
+GitObjectReader::~GitObjectReader()
+{
+   stop();
+}
+
+std::optional<QByteArray> GitObjectReader::readBlob(const ObjectId &id)
+{
+   if (id.isNull() || !start())
+      return std::nullopt;
+
+   mProcess->write(id.toString().toLatin1().append('\n'));
+
+   while (!mProcess->canReadLine())
+   {
+      if (!mProcess->waitForReadyRead(READ_TIMEOUT))
+      {
+         QLog_Warning("Git", QString("The object {%1} couldn't be read.").arg(id.toString()));
+         stop();
+         return std::nullopt;
+      }
+   }
+
+   // The header is "<id> <type> <size>" or "<id> missing"
+   const auto header = mProcess->readLine().trimmed().split(' ');
+
+   if (header.count() != 3)
+      return std::nullopt;
+
+   auto validSize = false;
+   const auto size = header.at(2).toLongLong(&validSize);
+
+   if (validSize && size > MAX_BLOB_SIZE)
+   {
+      // The content is not read, so the process is started again for the next read
+      stop();
+      return std::nullopt;
+   }
+
+   // The content is followed by a new line that's read too, so the next read starts clean
+   if (!validSize || !waitForBytes(size + 1))
+   {
+      QLog_Warning("Git", QString("The object {%1} couldn't be read.").arg(id.toString()));
+      stop();
+      return std::nullopt;
+   }
+
+   auto content = mProcess->read(size);
+   mProcess->read(1);
+
+   if (header.at(1) != "blob")
+      return std::nullopt;
+
+   return content;
+}
+
+bool GitObjectReader::start()
+{
+   if (mProcess && mProcess->state() == QProcess::Running)
+      return true;
+
+   stop();
+
+   const auto gitAlternative = GitQlientSettings().globalValue("gitLocation", "").toString();
+
+   mProcess = new QProcess(this);
+   mProcess->setWorkingDirectory(mWorkingDir);
+   mProcess->start(gitAlternative.isEmpty() ? QString("git") : gitAlternative,
+                   { QString("cat-file"), QString("--batch") });
+
+   if (!mProcess->waitForStarted(START_TIMEOUT))
+   {
+      QLog_Warning("Git", QString("Unable to start the object reader: %1").arg(mProcess->errorString()));
+      stop();
+      return false;
+   }
+
+   QLog_Debug("Git", QString("Object reader started for {%1}.").arg(mWorkingDir));
+
+   return true;
+}
+
+void GitObjectReader::stop()
+{
+   if (!mProcess)
+      return;
+
+   if (mProcess->state() != QProcess::NotRunning)
+   {
+      mProcess->closeWriteChannel();
+
+      if (!mProcess->waitForFinished(READ_TIMEOUT))
+         mProcess->kill();
+   }
+
+   delete mProcess;
+   mProcess = nullptr;
+}
+
+bool GitObjectReader::waitForBytes(qint64 size)
+{
+   while (mProcess->bytesAvailable() < size)
+   {
+      if (!mProcess->waitForReadyRead(READ_TIMEOUT))
+         return false;
+   }
+
+   return true;
+}
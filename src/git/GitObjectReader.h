@@ -0,0 +1,69 @@
+#pragma once
+
+/****************************************************************************************
+ ** GitQlient is an application to manage and operate one or several Git repositories. With
+ ** GitQlient you will be able to add commits, branches and manage all the options Git provides.
+ ** Copyright (C) 2021  Francesc Martinez
+ **
+ ** LinkedIn: www.linkedin.com/in/cescmm/
+ ** Web: www.francescmm.com
+ **
+ ** This program is free software; you can redistribute it and/or
+ ** modify it under the terms of the GNU Lesser General Public
+ ** License as published by the Free Software Foundation; either
+ ** version 2 of the License, or (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ ** Lesser General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Lesser General Public
+ ** License along with this library; if not, write to the Free Software
+ ** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ ***************************************************************************************/
+
+
+#include <ObjectId.h>
+
+#include <QObject>
+
+#include <optional>
+
+class QProcess;
+
+/**
+ * @brief The GitObjectReader class reads the content of the blobs of a repository through a single git cat-file
+ * process that keeps running between reads. The process is started with the first read and it's started again if it
+ * dies, so reading a blob doesn't cost a process every time.
+ *
+ * The objects are read by id: the ids never change their content, so the process never returns stale data.
+ */
+class GitObjectReader : public QObject
+{
+   Q_OBJECT
+
+public:
+   /**
+    * @brief Default constructor.
+    * @param workingDir The working directory of the repository.
+    * @param parent The parent of the reader.
+    */
+   explicit GitObjectReader(const QString &workingDir, QObject *parent = nullptr);
+   ~GitObjectReader();
+
+   /**
+    * @brief readBlob Reads the content of a blob. It blocks until the content is read.
+    * @param id The id of the blob.
+    * @return The content of the blob or nothing if it doesn't exist, it's not a blob or the process failed.
+    */
+   std::optional<QByteArray> readBlob(const ObjectId &id);
+
+private:
+   QString mWorkingDir;
+   QProcess *mProcess = nullptr;
+
+   bool start();
+   void stop();
+   bool waitForBytes(qint64 size);
+};
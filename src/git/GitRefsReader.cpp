@@ -0,0 +1,257 @@
+#include "GitRefsReader.h"
+
+#include <QDir>
+#include <QDirIterator>
+#include <QFile>
+#include <QHash>
+
+#include <cstring>
+
+#include <QLogger.h>
+
+using namespace QLogger;
+
+namespace
+{
+const char *NAMESPACES[] = { "refs/heads/", "refs/remotes/", "refs/tags/" };
+const int MAX_TAG_CHAIN = 10;
+
+bool isShown(const QByteArray &name)
+{
+   for (const auto prefix : NAMESPACES)
+   {
+      if (name.startsWith(prefix))
+         return true;
+   }
+
+   return false;
+}
+
+bool isTag(const QString &name)
+{
+   return name.startsWith(QString("refs/tags/"));
+}
+}
+
+GitRefsReader::GitRefsReader(const QString &gitDir)
+   : mCommonDir(gitDir)
+{
+   // The worktrees share the references of the main repository
+   QFile commonDirFile(QString("%1/commondir").arg(gitDir));
+
+   if (commonDirFile.open(QIODevice::ReadOnly))
+   {
+      const auto commonDir = QString::fromUtf8(commonDirFile.readAll().trimmed());
+      mCommonDir = QDir::cleanPath(QDir(gitDir).absoluteFilePath(commonDir));
+   }
+}
+
+std::optional<QVector<GitRefsReader::Reference>> GitRefsReader::read() const
+{
+   if (QDir(QString("%1/reftable").arg(mCommonDir)).exists())
+   {
+      QLog_Debug("Git", "The references are stored in a reftable and they can't be read directly.");
+      return std::nullopt;
+   }
+
+   QVector<Reference> references;
+
+   if (!readPackedRefs(references) || !readLooseRefs(references))
+      return std::nullopt;
+
+   return references;
+}
+
+bool GitRefsReader::readPackedRefs(QVector<Reference> &references) const
+{
+   QFile file(QString("%1/packed-refs").arg(mCommonDir));
+
+   // A repository without packed references is valid
+   if (!file.exists())
+      return true;
+
+   if (!file.open(QIODevice::ReadOnly))
+      return false;
+
+   const auto size = file.size();
+
+   if (size == 0)
+      return true;
+
+   const auto data = file.map(0, size);
+
+   if (!data)
+      return false;
+
+   const auto begin = reinterpret_cast<const char *>(data);
+   const auto end = begin + size;
+   auto peeledTraits = false;
+   auto fullyPeeled = false;
+   auto valid = true;
+   auto lastIsShown = false;
+
+   for (auto line = begin; line < end && valid;)
+   {
+      auto lineEnd = static_cast<const char *>(memchr(line, '\n', static_cast<size_t>(end - line)));
+
+      if (!lineEnd)
+         lineEnd = end;
+
+      const auto length = static_cast<int>(lineEnd - line);
+
+      if (line[0] == '#')
+      {
+         const auto header = QByteArray::fromRawData(line, length);
+
+         peeledTraits = header.contains(" peeled");
+         fullyPeeled = header.contains(" fully-peeled");
+      }
+      else if (line[0] == '^')
+      {
+         // The peeled object of the previous reference
+         if (lastIsShown)
+         {
+            auto &reference = references.last();
+            reference.peeledId = ObjectId::fromHex(line + 1, qMin(length - 1, ObjectId::HEX_SIZE));
+            reference.peelState = reference.peeledId.isNull() ? PeelState::Unknown : PeelState::Peeled;
+         }
+      }
+      else if (length > ObjectId::HEX_SIZE + 1 && line[ObjectId::HEX_SIZE] == ' ')
+      {
+         const auto name = QByteArray::fromRawData(line + ObjectId::HEX_SIZE + 1, length - ObjectId::HEX_SIZE - 1);
+
+         lastIsShown = isShown(name);
+
+         if (lastIsShown)
+         {
+            Reference reference;
+            reference.name = QString::fromUtf8(name);
+            reference.id = ObjectId::fromHex(line, ObjectId::HEX_SIZE);
+
+            // Without a peeled line the reference is not an annotated tag, if Git says it peeled the tags
+            if (isTag(reference.name))
+               reference.peelState = peeledTraits || fullyPeeled ? PeelState::NotAnnotated : PeelState::Unknown;
+
+            valid = !reference.id.isNull();
+
+            references.append(std::move(reference));
+         }
+      }
+      else if (length > 0)
+         valid = false;
+
+      line = lineEnd + 1;
+   }
+
+   file.unmap(data);
+
+   if (!valid)
+      QLog_Warning("Git", QString("The packed references of {%1} couldn't be read.").arg(mCommonDir));
+
+   return valid;
+}
+
+bool GitRefsReader::readLooseRefs(QVector<Reference> &references) const
+{
+   QHash<QString, int> packedRows;
+   packedRows.reserve(references.count());
+
+   for (auto i = 0; i < references.count(); ++i)
+      packedRows.insert(references.at(i).name, i);
+
+   for (const auto ns : NAMESPACES)
+   {
+      const auto nsDir = QString("%1/%2").arg(mCommonDir, QString::fromUtf8(ns));
+      QDirIterator iter(nsDir, QDir::Files | QDir::Hidden, QDirIterator::Subdirectories);
+
+      while (iter.hasNext())
+      {
+         const auto filePath = iter.next();
+
+         if (filePath.endsWith(QString(".lock")))
+            continue;
+
+         QFile file(filePath);
+
+         if (!file.open(QIODevice::ReadOnly))
+            return false;
+
+         const auto content = file.read(ObjectId::HEX_SIZE + 1).trimmed();
+
+         // Symbolic references like refs/remotes/origin/HEAD are not shown
+         if (content.startsWith("ref:"))
+            continue;
+
+         Reference reference;
+         reference.name = QString("%1%2").arg(QString::fromUtf8(ns), QDir(nsDir).relativeFilePath(filePath));
+         reference.id = ObjectId::fromHex(content.constData(), content.size());
+
+         if (reference.id.isNull())
+         {
+            QLog_Warning("Git", QString("The reference {%1} couldn't be read.").arg(filePath));
+            return false;
+         }
+
+         if (isTag(reference.name))
+            peelLooseTag(reference);
+
+         if (const auto row = packedRows.value(reference.name, -1); row != -1)
+            references[row] = std::move(reference);
+         else
+            references.append(std::move(reference));
+      }
+   }
+
+   return true;
+}
+
+void GitRefsReader::peelLooseTag(Reference &reference) const
+{
+   auto id = reference.id;
+
+   for (auto depth = 0; depth < MAX_TAG_CHAIN; ++depth)
+   {
+      const auto object = readLooseObject(id);
+
+      // The object is packed: it can't be read without Git
+      if (object.isEmpty())
+         break;
+
+      if (!object.startsWith("tag "))
+      {
+         reference.peelState = depth == 0 ? PeelState::NotAnnotated : PeelState::Peeled;
+         reference.peeledId = depth == 0 ? ObjectId() : id;
+         return;
+      }
+
+      // The header is followed by "object <sha>"
+      const auto objectField = object.indexOf("object ");
+
+      if (objectField == -1)
+         break;
+
+      id = ObjectId::fromHex(object.constData() + objectField + 7,
+                             qMin(ObjectId::HEX_SIZE, object.size() - objectField - 7));
+
+      if (id.isNull())
+         break;
+   }
+
+   reference.peelState = PeelState::Unknown;
+}
+
+QByteArray GitRefsReader::readLooseObject(const ObjectId &id) const
+{
+   const auto sha = id.toString();
+   QFile file(QString("%1/objects/%2/%3").arg(mCommonDir, sha.left(2), sha.mid(2)));
+
+   if (!file.open(QIODevice::ReadOnly))
+      return QByteArray();
+
+   // The loose objects are zlib streams: qUncompress expects them prefixed with the size of the uncompressed data,
+   // that is only a hint, and the tags are small.
+   QByteArray compressed("\x00\x00\x04\x00", 4);
+   compressed.append(file.readAll());
+
+   return qUncompress(compressed);
+}
@@ -0,0 +1,95 @@
+#pragma once
+
+/****************************************************************************************
+ ** GitQlient is an application to manage and operate one or several Git repositories. With
+ ** GitQlient you will be able to add commits, branches and manage all the options Git provides.
+ ** Copyright (C) 2021  Francesc Martinez
+ **
+ ** LinkedIn: www.linkedin.com/in/cescmm/
+ ** Web: www.francescmm.com
+ **
+ ** This program is free software; you can redistribute it and/or
+ ** modify it under the terms of the GNU Lesser General Public
+ ** License as published by the Free Software Foundation; either
+ ** version 2 of the License, or (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ ** Lesser General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Lesser General Public
+ ** License along with this library; if not, write to the Free Software
+ ** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ ***************************************************************************************/
+
+
+#include <ObjectId.h>
+
+#include <QString>
+#include <QVector>
+
+#include <optional>
+
+/**
+ * @brief The GitRefsReader class reads the references of a repository straight from the files in the Git directory,
+ * the packed-refs file and the loose references in refs/, without running Git. Only the branches, the remote branches
+ * and the tags are read.
+ *
+ * The annotated tags are peeled with the peeled lines of the packed-refs file or by reading the tag object when it's a
+ * loose object. The tags that can't be peeled that way are reported so the caller can decide what they are.
+ */
+class GitRefsReader
+{
+public:
+   enum class PeelState
+   {
+      Peeled,
+      NotAnnotated,
+      Unknown
+   };
+
+   struct Reference
+   {
+      /**
+       * @brief name The full name of the reference, e.g. refs/heads/master.
+       */
+      QString name;
+      /**
+       * @brief id The object the reference points to.
+       */
+      ObjectId id;
+      /**
+       * @brief peeledId The commit an annotated tag points to. It's null for the rest of references.
+       */
+      ObjectId peeledId;
+      PeelState peelState = PeelState::NotAnnotated;
+   };
+
+   /**
+    * @brief Default constructor.
+    * @param gitDir The Git directory of the repository. The references of a worktree are read from the common
+    * directory.
+    */
+   explicit GitRefsReader(const QString &gitDir);
+
+   /**
+    * @brief read Reads all the references. The loose references replace the packed ones with the same name.
+    * @return The references or std::nullopt if the repository stores them in a format that can't be read, like the
+    * reftable backend or SHA-256 object names.
+    */
+   std::optional<QVector<Reference>> read() const;
+
+   /**
+    * @brief commonDir Returns the directory where the references are stored.
+    */
+   QString commonDir() const { return mCommonDir; }
+
+private:
+   QString mCommonDir;
+
+   bool readPackedRefs(QVector<Reference> &references) const;
+   bool readLooseRefs(QVector<Reference> &references) const;
+   void peelLooseTag(Reference &reference) const;
+   QByteArray readLooseObject(const ObjectId &id) const;
+};
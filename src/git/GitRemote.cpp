@@ -25,6 +25,7 @@ GitExecResult GitRemote::pushBranch(const QString &branchName, bool force)
    {
       const auto remote = ret.output.isEmpty() ? QString("origin") : ret.output;
       ret = mGitBase->run(QString("git push %1 %2 %3").arg(remote, branchName, force ? QString("--force") : QString()));
+      mGitBase->invalidateRemoteTags();
    }
 
    return ret;
@@ -35,6 +36,7 @@ GitExecResult GitRemote::push(bool force)
    QLog_Debug("Git", QString("Executing push"));
 
    const auto ret = mGitBase->run(QString("git push ").append(force ? QString("--force") : QString()));
+   mGitBase->invalidateRemoteTags();
 
    return ret;
 }
@@ -46,8 +48,11 @@ GitExecResult GitRemote::pushCommit(const QString &sha, const QString &remoteBra
    GitConfig gitConfig(mGitBase);
    const auto remote = gitConfig.getRemoteForBranch(remoteBranch);
 
-   return mGitBase->run(QString("git push %1 %2:refs/heads/%3")
-                            .arg(remote.success ? remote.output : QString("origin"), sha, remoteBranch));
+   const auto ret = mGitBase->run(QString("git push %1 %2:refs/heads/%3")
+                                      .arg(remote.success ? remote.output : QString("origin"), sha, remoteBranch));
+   mGitBase->invalidateRemoteTags();
+
+   return ret;
 }
 
 GitExecResult GitRemote::pull()
@@ -55,6 +60,7 @@ GitExecResult GitRemote::pull()
    QLog_Debug("Git", QString("Executing pull"));
 
    auto ret = mGitBase->run("git pull");
+   mGitBase->invalidateRemoteTags();
 
    GitQlientSettings settings(mGitBase->getGitDir());
    const auto updateOnPull = settings.localValue("UpdateOnPull", true).toBool();
@@ -79,14 +85,25 @@ bool GitRemote::fetch()
 {
    QLog_Debug("Git", QString("Executing fetch with prune"));
 
+   const auto cmd = QString("git %1").arg(fetchArguments().join(' '));
+   const auto ret = mGitBase->run(cmd).success;
+   mGitBase->invalidateRemoteTags();
+
+   return ret;
+}
+
+QStringList GitRemote::fetchArguments() const
+{
    GitQlientSettings settings(mGitBase->getGitDir());
    const auto pruneOnFetch = settings.localValue("PruneOnFetch", true).toBool();
 
-   const auto cmd
-       = QString("git fetch --all --tags --force %1").arg(pruneOnFetch ? QString("--prune --prune-tags") : QString());
-   const auto ret = mGitBase->run(cmd).success;
+   QStringList arguments { "fetch", "--all", "--tags", "--force" };
 
-   return ret;
+   if (pruneOnFetch)
+      arguments << "--prune"
+                << "--prune-tags";
+
+   return arguments;
 }
 
 GitExecResult GitRemote::prune()
@@ -107,6 +124,7 @@ GitExecResult GitRemote::addRemote(const QString &remoteRepo, const QString &rem
    if (ret.success)
    {
       const auto ret2 = mGitBase->run(QString("git fetch %1").arg(remoteName));
+      mGitBase->invalidateRemoteTags();
    }
 
    return ret;
@@ -26,6 +26,7 @@
 #include <GitExecResult.h>
 
 #include <QSharedPointer>
+#include <QStringList>
 
 class GitBase;
 
@@ -39,6 +40,10 @@ public:
    GitExecResult pushCommit(const QString &sha, const QString &remoteBranch);
    GitExecResult pull();
    bool fetch();
+   /**
+    * @brief fetchArguments Returns the arguments of Git to fetch all the remotes, as set in the settings.
+    */
+   QStringList fetchArguments() const;
    GitExecResult prune();
    GitExecResult addRemote(const QString &remoteRepo, const QString &remoteName);
    GitExecResult removeRemote(const QString &remoteName);
@@ -1,11 +1,13 @@
 #include "GitRepoLoader.h"
 
+#include <CommitGraphFile.h>
 #include <GitBase.h>
 #include <GitBranches.h>
 #include <GitCache.h>
 #include <GitConfig.h>
 #include <GitLocal.h>
 #include <GitQlientSettings.h>
+#include <GitRefsReader.h>
 #include <GitRequestorProcess.h>
 #include <GitTags.h>
 #include <GitWip.h>
@@ -17,6 +19,65 @@
 using namespace QLogger;
 
 static const char *GIT_LOG_FORMAT("%m%HX%P%n%cn<%ce>%n%an<%ae>%n%at%n%s%n%b ");
+static const int BATCH_NOTIFY_INTERVAL_MS = 250;
+static const int REMOTE_TAGS_MAX_AGE_MS = 10 * 60 * 1000;
+
+namespace
+{
+// The history can be shown without the files of the WIP when its status can't be read
+GitWip::WipStatus readWipStatus(const QSharedPointer<GitBase> &gitBase, const QSharedPointer<GitCache> &cache)
+{
+   if (auto status = GitWip(gitBase, cache).getWipStatus())
+      return std::move(*status);
+
+   QLog_Warning("Git", QString("The status of the working directory couldn't be read."));
+
+   GitWip::WipStatus status;
+
+   if (const auto ret = gitBase->getLastCommit(); ret.success)
+      status.parentSha = ret.output.trimmed();
+
+   return status;
+}
+
+// The tips of the references are passed with --stdin: there can be too many for the command line
+QByteArray revisionsInput(const QVector<ObjectId> &revisions, const QVector<ObjectId> &excludedRevisions)
+{
+   QByteArray input;
+   input.reserve((revisions.count() + excludedRevisions.count()) * (ObjectId::HEX_SIZE + 2));
+
+   for (const auto &revision : revisions)
+      input.append(revision.toString().toLatin1()).append('\n');
+
+   for (const auto &revision : excludedRevisions)
+      input.append('^').append(revision.toString().toLatin1()).append('\n');
+
+   return input;
+}
+
+bool parseReferenceName(const QString &refName, References::Type &type, QString &name)
+{
+   if (refName.startsWith(QString("refs/tags/")))
+   {
+      type = References::Type::LocalTag;
+      name = refName.mid(10);
+   }
+   else if (refName.startsWith(QString("refs/heads/")))
+   {
+      type = References::Type::LocalBranch;
+      name = refName.mid(11);
+   }
+   else if (refName.startsWith(QString("refs/remotes/")) && !refName.endsWith(QString("HEAD")))
+   {
+      type = References::Type::RemoteBranches;
+      name = refName.mid(13);
+   }
+   else
+      return false;
+
+   return true;
+}
+}
 
 GitRepoLoader::GitRepoLoader(QSharedPointer<GitBase> gitBase, QSharedPointer<GitCache> cache,
                              const QSharedPointer<GitQlientSettings> &settings, QObject *parent)
@@ -26,6 +87,11 @@ GitRepoLoader::GitRepoLoader(QSharedPointer<GitBase> gitBase, QSharedPointer<Git
    , mSettings(settings)
    , mGitTags(new GitTags(mGitBase, mRevCache))
 {
+   // The remote tags are kept only if they could be read
+   connect(mGitTags.data(), &GitTags::remoteTagsReceived, this, [this](bool success) {
+      if (success)
+         mRemoteTagsAge.start();
+   });
 }
 
 void GitRepoLoader::cancelAll()
@@ -142,73 +208,129 @@ void GitRepoLoader::requestReferences()
 {
    QLog_Debug("Git", "Loading references...");
 
-   const auto requestor = new GitRequestorProcess(mGitBase->getWorkingDir());
-   connect(requestor, &GitRequestorProcess::procDataReady, this, &GitRepoLoader::processReferences);
-   connect(this, &GitRepoLoader::cancelAllProcesses, requestor, &AGitProcess::onCancel);
+   if (!readReferences())
+   {
+      const auto requestor = new GitRequestorProcess(mGitBase->getWorkingDir());
+      connect(requestor, &GitRequestorProcess::procDataReady, this, &GitRepoLoader::processReferences);
+      connect(this, &GitRepoLoader::cancelAllProcesses, requestor, &AGitProcess::onCancel);
+
+      requestor->run("git show-ref -d");
+   }
 
-   requestor->run("git show-ref -d");
+   requestRemoteTags();
+}
 
-   mGitTags->getRemoteTags();
+bool GitRepoLoader::readReferences()
+{
+   GitRefsReader reader(mGitBase->getGitDir());
+   const auto references = reader.read();
+
+   if (!references)
+      return false;
+
+   ReferencesIndex index;
+
+   for (const auto &reference : *references)
+   {
+      References::Type type;
+      QString name;
+
+      if (!parseReferenceName(reference.name, type, name))
+         continue;
+
+      auto sha = reference.id;
+
+      // As with git show-ref -d, only the annotated tags are shown and they point to the commit they tag
+      if (type == References::Type::LocalTag)
+      {
+         if (reference.peelState == GitRefsReader::PeelState::Unknown)
+         {
+            // A commit is not an annotated tag. The rest of the tag objects are packed and only Git can read them
+            if (mRevCache->containsCommit(reference.id))
+               continue;
+
+            QLog_Debug("Git", QString("The tag {%1} can't be peeled without Git.").arg(name));
+
+            return false;
+         }
+
+         if (reference.peelState == GitRefsReader::PeelState::NotAnnotated)
+            continue;
+
+         sha = reference.peeledId;
+      }
+
+      index.insert(sha, type, name);
+   }
+
+   applyReferences(index);
+
+   return true;
 }
 
 void GitRepoLoader::processReferences(QByteArray ba)
 {
-   if (mRefreshReferences)
-      mRevCache->clearReferences();
-
-   QString prevRefSha;
+   ReferencesIndex index;
    const auto referencesList = ba.split('\n');
 
    for (const auto &reference : referencesList)
    {
-      if (!reference.isEmpty())
+      if (reference.isEmpty())
+         continue;
+
+      auto refName = QString::fromUtf8(reference.mid(41));
+
+      // Only the peeled annotated tags are shown
+      if (refName.startsWith(QString("refs/tags/")))
       {
-         auto revSha = QString::fromUtf8(reference.left(40));
-         const auto refName = reference.mid(41);
+         if (!refName.endsWith(QString("^{}")))
+            continue;
 
-         if (!refName.startsWith("refs/tags/") || (refName.startsWith("refs/tags/") && refName.endsWith("^{}")))
-         {
-            References::Type type;
-            QString name;
+         refName.chop(3);
+      }
 
-            if (refName.startsWith("refs/tags/"))
-            {
-               type = References::Type::LocalTag;
-               name = QString::fromUtf8(refName.mid(10, reference.length()));
-               name.remove("^{}");
-            }
-            else if (refName.startsWith("refs/heads/"))
-            {
-               type = References::Type::LocalBranch;
-               name = QString::fromUtf8(refName.mid(11));
-            }
-            else if (refName.startsWith("refs/remotes/") && !refName.endsWith("HEAD"))
-            {
-               type = References::Type::RemoteBranches;
-               name = QString::fromUtf8(refName.mid(13));
-            }
-            else
-               continue;
+      References::Type type;
+      QString name;
 
-            mRevCache->insertReference(revSha, type, name);
-         }
-         prevRefSha = revSha;
+      if (parseReferenceName(refName, type, name))
+      {
+         const auto sha = ObjectId::fromHex(reference.constData(), qMin(reference.size(), ObjectId::HEX_SIZE));
+         index.insert(sha, type, name);
       }
    }
 
+   applyReferences(index);
+}
+
+void GitRepoLoader::applyReferences(const ReferencesIndex &references)
+{
+   // The remote tags come from another request
+   mRevCache->updateReferences(references,
+                               { References::Type::LocalTag, References::Type::LocalBranch,
+                                 References::Type::RemoteBranches });
+
    mRevCache->reloadCurrentBranchInfo(mGitBase->getCurrentBranch(), mGitBase->getLastCommit().output.trimmed());
 
-   --mSteps;
+   finishLoadingStep();
+}
 
-   if (mSteps == 0)
+void GitRepoLoader::requestRemoteTags()
+{
+   if (!mSettings->localValue("FetchRemoteTags", true).toBool())
+      return;
+
+   // A push, a fetch or a change of the tags of the remote outdates the remote tags received
+   if (const auto version = mGitBase->remoteTagsVersion(); version != mRemoteTagsVersion)
    {
-      mRevCache->setConfigurationDone();
+      mRemoteTagsAge.invalidate();
+      mRemoteTagsVersion = version;
+   }
 
-      emit signalLoadingFinished(mRefreshReferences);
+   // Asking for the remote tags needs the network: the ones received are kept for a while
+   if (mRemoteTagsAge.isValid() && mRemoteTagsAge.elapsed() < REMOTE_TAGS_MAX_AGE_MS)
+      return;
 
-      mLocked = false;
-      mRefreshReferences = false;
-   }
+   mGitTags->getRemoteTags();
 }
 
 void GitRepoLoader::requestRevisions()
@@ -238,17 +360,56 @@ void GitRepoLoader::requestRevisions()
          break;
    }
 
-   const auto baseCmd = QString("git log %1 --no-color --log-size --parents --boundary -z --pretty=format:%2 %3")
-                            .arg(order, QString::fromUtf8(GIT_LOG_FORMAT), commitsToRetrieve);
+   const auto logCmd = QString("git log %1 --no-color --log-size --parents -z --pretty=format:%2")
+                           .arg(order, QString::fromUtf8(GIT_LOG_FORMAT));
+   const auto baseCmd = QString("%1 --boundary %2").arg(logCmd, commitsToRetrieve);
 
    if (!mRevCache->isInitialized())
       emit signalLoadingStarted();
 
-   const auto requestor = new GitRequestorProcess(mGitBase->getWorkingDir());
-   connect(requestor, &GitRequestorProcess::procDataReady, this, &GitRepoLoader::processRevisions);
-   connect(this, &GitRepoLoader::cancelAllProcesses, requestor, &AGitProcess::onCancel);
+   GitConfig gitConfig(mGitBase);
+   const auto ret = gitConfig.getGitValue("log.showSignature");
+   const auto showSignature = ret.success ? ret.output.contains("true") : false;
 
-   requestor->run(baseCmd);
+   // The signature information is interleaved with the log so only the unsigned log can be processed while streaming
+   if (showSignature)
+   {
+      mLoadedTips.clear();
+
+      const auto requestor = new GitRequestorProcess(mGitBase->getWorkingDir());
+      connect(requestor, &GitRequestorProcess::procDataReady, this, &GitRepoLoader::processRevisions);
+      connect(this, &GitRepoLoader::cancelAllProcesses, requestor, &AGitProcess::onCancel);
+
+      requestor->run(baseCmd);
+   }
+   else
+   {
+      // The history of a limited log can't be extended with the new commits so it's not stored
+      mPersistHistory = maxCommits == 0;
+
+      if (mPersistHistory)
+      {
+         mLogKey = QString("%1 %2").arg(order, commitsToRetrieve);
+         mLogTips = getLogTips(commitsToRetrieve);
+
+         const auto done
+             = mRevCache->isInitialized() ? refreshLoadedHistory(logCmd) : loadCommitGraphFile(logCmd);
+
+         if (done)
+            return;
+      }
+
+      mLoadedTips.clear();
+      mStreamStarted = false;
+      mPendingLog.clear();
+
+      const auto requestor = new GitRequestorProcess(mGitBase->getWorkingDir(), GitRequestorProcess::Mode::Streaming);
+      connect(requestor, &GitRequestorProcess::procDataReady, this, &GitRepoLoader::processRevisionsChunk);
+      connect(requestor, &GitRequestorProcess::procStreamFinished, this, &GitRepoLoader::onRevisionsStreamFinished);
+      connect(this, &GitRepoLoader::cancelAllProcesses, requestor, &AGitProcess::onCancel);
+
+      requestor->run(baseCmd);
+   }
 }
 
 void GitRepoLoader::processRevisions(QByteArray ba)
@@ -268,17 +429,279 @@ void GitRepoLoader::processRevisions(QByteArray ba)
    if (!initialized)
       emit signalLoadingStarted();
 
-   const auto ret = gitConfig.getGitValue("log.showSignature");
-   const auto showSignature = ret.success ? ret.output.contains("true") : false;
-   auto commits = showSignature ? processSignedLog(ba) : processUnsignedLog(ba);
-   GitWip git(mGitBase, mRevCache);
-   const auto files = git.getUntrackedFiles();
+   auto commits = processSignedLog(ba);
+   auto status = readWipStatus(mGitBase, mRevCache);
+
+   mRevCache->setUntrackedFilesList(std::move(status.untrackedFiles));
+   mRevCache->setWipFileObjects(std::move(status.objects));
+   mRevCache->setup(status.parentSha, status.files, std::move(commits));
+
+   finishLoadingStep();
+}
+
+void GitRepoLoader::processRevisionsChunk(const QByteArray &chunk)
+{
+   mPendingLog.append(chunk);
+
+   // Only the complete records are processed, the rest waits for the next chunk
+   const auto lastRecordEnd = mPendingLog.lastIndexOf('\000');
+
+   if (lastRecordEnd != -1)
+   {
+      auto commits = parseLogRecords(mPendingLog, lastRecordEnd);
+      mPendingLog.remove(0, lastRecordEnd + 1);
+
+      appendRevisions(std::move(commits));
+   }
+}
+
+void GitRepoLoader::onRevisionsStreamFinished(bool success)
+{
+   if (success)
+      QLog_Info("Git", "Revisions received!");
+   else
+      QLog_Warning("Git", "The log finished with an error, the history received might be incomplete.");
+
+   // The last record is not followed by the NUL separator
+   if (!mPendingLog.isEmpty())
+   {
+      auto commits = parseLogRecords(mPendingLog, mPendingLog.size());
+      mPendingLog.clear();
+      mPendingLog.squeeze();
+
+      appendRevisions(std::move(commits));
+   }
+
+   if (!mStreamStarted)
+      prepareCacheSetup();
+
+   mRevCache->finishSetup();
+   mStreamStarted = false;
+
+   finishLoadingStep();
+
+   if (!mPersistHistory)
+      return;
+
+   if (success)
+   {
+      setHistoryLoaded();
+      saveCommitGraphFile();
+   }
+   else
+   {
+      // An incomplete history can't be extended later: the next load requests the full log again
+      CommitGraphFile(mGitBase->getGitDir()).remove();
+   }
+}
+
+void GitRepoLoader::prepareCacheSetup()
+{
+   auto status = readWipStatus(mGitBase, mRevCache);
+
+   mRevCache->setUntrackedFilesList(std::move(status.untrackedFiles));
+   mRevCache->setWipFileObjects(std::move(status.objects));
+   mRevCache->startSetup(status.parentSha, status.files);
+
+   mStreamStarted = true;
+}
+
+void GitRepoLoader::appendRevisions(QVector<CommitInfo> commits)
+{
+   if (commits.isEmpty())
+      return;
+
+   // The previous data is kept in the cache until the first batch is available
+   const auto firstBatch = !mStreamStarted;
+
+   if (firstBatch)
+   {
+      prepareCacheSetup();
+      mBatchTimer.start();
+   }
+
+   mRevCache->appendCommits(std::move(commits));
+
+   if (firstBatch || mBatchTimer.elapsed() >= BATCH_NOTIFY_INTERVAL_MS)
+   {
+      mBatchTimer.restart();
+
+      emit signalCommitsBatchReady(mRevCache->commitCount(), firstBatch);
+   }
+}
+
+QVector<ObjectId> GitRepoLoader::getLogTips(const QString &commitsToRetrieve) const
+{
+   QVector<ObjectId> tips;
+
+   // The log always includes HEAD: it's the default when there is no current branch and --all adds it
+   const auto ret = mGitBase->run(QString("git rev-parse HEAD %1").arg(commitsToRetrieve));
+
+   if (ret.success)
+   {
+      const auto lines = ret.output.split('\n');
+
+      for (const auto &line : lines)
+      {
+         if (const auto tip = ObjectId::fromString(line.trimmed()); !tip.isNull())
+            tips.append(tip);
+      }
+
+      std::sort(tips.begin(), tips.end());
+      tips.erase(std::unique(tips.begin(), tips.end()), tips.end());
+   }
+
+   return tips;
+}
+
+bool GitRepoLoader::loadCommitGraphFile(const QString &logCmd)
+{
+   if (mLogTips.isEmpty())
+      return false;
+
+   CommitGraphFile file(mGitBase->getGitDir());
+   CommitGraphFile::Content content;
+
+   if (!file.load(mLogKey, content) || content.commits.isEmpty())
+      return false;
+
+   // The stored history can only be extended if all of it is still reachable from the current references
+   if (content.tips != mLogTips && !isHistoryReachable(content.tips))
+   {
+      QLog_Info("Git", "The stored history is no longer valid, the full log is requested.");
+
+      file.remove();
+
+      return false;
+   }
+
+   QLog_Info("Git", QString("Showing {%1} revisions from the stored history.").arg(content.commits.count()));
+
+   prepareCacheSetup();
+   mRevCache->restoreCommits(std::move(content.commits), std::move(content.lanesCheckpoints));
+   mRevCache->finishSetup();
+   mStreamStarted = false;
 
-   mRevCache->setUntrackedFilesList(std::move(files));
-   const auto info = git.getWipInfo().value();
+   emit signalCommitsBatchReady(mRevCache->commitCount(), true);
 
-   mRevCache->setup(info.first, info.second, std::move(commits));
+   if (content.tips == mLogTips)
+   {
+      setHistoryLoaded();
+      finishLoadingStep();
+   }
+   else
+      requestNewRevisions(logCmd, content.tips);
+
+   return true;
+}
+
+bool GitRepoLoader::refreshLoadedHistory(const QString &logCmd)
+{
+   if (mLoadedTips.isEmpty() || mLogTips.isEmpty() || mLoadedLogKey != mLogKey)
+      return false;
+
+   // A rewritten history (rebase, reset, deleted branches) can't be refreshed by adding commits on top
+   if (mLoadedTips != mLogTips && !isHistoryReachable(mLoadedTips))
+   {
+      QLog_Info("Git", "The history shown is no longer valid, the full log is requested.");
+      return false;
+   }
+
+   requestNewRevisions(logCmd, mLoadedTips);
+
+   return true;
+}
+
+bool GitRepoLoader::isHistoryReachable(const QVector<ObjectId> &oldTips) const
+{
+   const auto ret = mGitBase->run(QString("git rev-list -n 1 --stdin"), revisionsInput(oldTips, mLogTips));
+
+   return ret.success && ret.output.trimmed().isEmpty();
+}
+
+void GitRepoLoader::requestNewRevisions(const QString &logCmd, const QVector<ObjectId> &oldTips)
+{
+   mPendingLog.clear();
+
+   if (oldTips == mLogTips)
+   {
+      // Only the WIP may have changed
+      processNewRevisions(true);
+      return;
+   }
+
+   QLog_Debug("Git", "Requesting the revisions that are not in the history shown...");
+
+   // Streamed to know if the log finished successfully: a partial log must not move the tips of the history shown
+   const auto requestor = new GitRequestorProcess(mGitBase->getWorkingDir(), GitRequestorProcess::Mode::Streaming);
+   connect(requestor, &GitRequestorProcess::procDataReady, this,
+           [this](const QByteArray &chunk) { mPendingLog.append(chunk); });
+   connect(requestor, &GitRequestorProcess::procStreamFinished, this, &GitRepoLoader::processNewRevisions);
+   connect(this, &GitRepoLoader::cancelAllProcesses, requestor, &AGitProcess::onCancel);
+
+   requestor->setInput(revisionsInput(mLogTips, oldTips));
+
+   // Without the new revisions the history shown stays as it is, but the loading can't wait for them
+   if (!requestor->run(QString("%1 --stdin").arg(logCmd)).success)
+   {
+      QLog_Warning("Git", "The new revisions couldn't be requested.");
+
+      requestor->deleteLater();
+      finishLoadingStep();
+   }
+}
+
+void GitRepoLoader::processNewRevisions(bool success)
+{
+   if (!success)
+   {
+      // The tips of the history shown are kept, so the next refresh requests the new revisions again
+      QLog_Warning("Git", "The new revisions couldn't be read, the history shown is not refreshed.");
+
+      mPendingLog.clear();
+      finishLoadingStep();
+      return;
+   }
+
+   auto commits = parseLogRecords(mPendingLog, mPendingLog.size());
+   mPendingLog.clear();
+   mPendingLog.squeeze();
 
+   QLog_Info("Git", QString("{%1} new revisions received!").arg(commits.count()));
+
+   auto status = readWipStatus(mGitBase, mRevCache);
+
+   mRevCache->setUntrackedFilesList(std::move(status.untrackedFiles));
+   mRevCache->setWipFileObjects(std::move(status.objects));
+
+   // The new commits go on top of the ones already loaded and only the lanes that change are calculated again
+   const auto previousCount = mRevCache->commitCount();
+   const auto lastUpdatedRow = mRevCache->prependCommits(std::move(commits), status.parentSha, status.files);
+   const auto newCommits = mRevCache->commitCount() - previousCount;
+
+   emit signalCommitsPrepended(newCommits, lastUpdatedRow);
+
+   setHistoryLoaded();
+   finishLoadingStep();
+
+   if (newCommits > 0)
+      saveCommitGraphFile();
+}
+
+void GitRepoLoader::setHistoryLoaded()
+{
+   mLoadedLogKey = mLogKey;
+   mLoadedTips = mLogTips;
+}
+
+void GitRepoLoader::saveCommitGraphFile()
+{
+   CommitGraphFile file(mGitBase->getGitDir());
+   file.save(mLogKey, mLogTips, mRevCache->snapshot().commits, mRevCache->lanesCheckpoints());
+}
+
+void GitRepoLoader::finishLoadingStep()
+{
    --mSteps;
 
    if (mSteps == 0)
@@ -292,20 +715,22 @@ void GitRepoLoader::processRevisions(QByteArray ba)
    }
 }
 
-QVector<CommitInfo> GitRepoLoader::processUnsignedLog(QByteArray &log) const
+QVector<CommitInfo> GitRepoLoader::parseLogRecords(const QByteArray &log, int end) const
 {
-   auto lines = log.split('\000');
    QVector<CommitInfo> commits;
-   commits.reserve(lines.count());
+   auto start = 0;
 
-   auto pos = 0;
-   while (!lines.isEmpty())
+   while (start < end)
    {
-      if (auto commit = CommitInfo { lines.takeFirst() }; commit.isValid())
-      {
-         commit.pos = ++pos;
+      auto recordEnd = log.indexOf('\000', start);
+
+      if (recordEnd == -1 || recordEnd > end)
+         recordEnd = end;
+
+      if (auto commit = CommitInfo { log.constData() + start, recordEnd - start }; commit.isValid())
          commits.append(std::move(commit));
-      }
+
+      start = recordEnd + 1;
    }
 
    return commits;
@@ -26,6 +26,7 @@
 #include <CommitInfo.h>
 #include <GitExecResult.h>
 
+#include <QElapsedTimer>
 #include <QObject>
 #include <QSharedPointer>
 #include <QVector>
@@ -35,6 +36,7 @@ class GitBase;
 class GitCache;
 class GitQlientSettings;
 class GitTags;
+class ReferencesIndex;
 
 class GitRepoLoader : public QObject
 {
@@ -43,6 +45,20 @@ class GitRepoLoader : public QObject
 signals:
    void signalLoadingStarted();
    void signalLoadingFinished(bool full);
+   /**
+    * @brief signalCommitsBatchReady Signal triggered while the log is being streamed, every time a new batch of commits
+    * is available in the cache.
+    * @param totalCommits The total of commits currently stored in the cache, including the WIP.
+    * @param firstBatch True if it's the first batch of the current load, the previous data is no longer valid.
+    */
+   void signalCommitsBatchReady(int totalCommits, bool firstBatch);
+   /**
+    * @brief signalCommitsPrepended Signal triggered when the history already shown is refreshed with the commits that
+    * were created or fetched since it was loaded.
+    * @param newCommits The number of commits added on top of the history, after the WIP.
+    * @param lastUpdatedRow The last row whose lanes were calculated again. The rows after it didn't change.
+    */
+   void signalCommitsPrepended(int newCommits, int lastUpdatedRow);
    void cancelAllProcesses(QPrivateSignal);
 
 public slots:
@@ -60,17 +76,51 @@ private:
    bool mShowAll = true;
    bool mLocked = false;
    bool mRefreshReferences = true;
+   bool mStreamStarted = false;
+   bool mPersistHistory = false;
    int mSteps = 0;
    QSharedPointer<GitBase> mGitBase;
    QSharedPointer<GitCache> mRevCache;
    QSharedPointer<GitQlientSettings> mSettings;
    QSharedPointer<GitTags> mGitTags;
+   QByteArray mPendingLog;
+   QElapsedTimer mBatchTimer;
+   QElapsedTimer mRemoteTagsAge;
+   int mRemoteTagsVersion = 0;
+   QString mLogKey;
+   QVector<ObjectId> mLogTips;
+   QString mLoadedLogKey;
+   QVector<ObjectId> mLoadedTips;
 
    bool configureRepoDirectory();
    void requestReferences();
+   /**
+    * @brief readReferences Reads the references from the files of the repository without running Git.
+    * @return False if they can't be read that way and they have to be requested to Git.
+    */
+   bool readReferences();
    void processReferences(QByteArray ba);
+   /**
+    * @brief applyReferences Updates the references of the cache with the ones read, only touching the ones that
+    * changed, and finishes the loading step.
+    */
+   void applyReferences(const ReferencesIndex &references);
+   void requestRemoteTags();
    void requestRevisions();
    void processRevisions(QByteArray ba);
-   QVector<CommitInfo> processUnsignedLog(QByteArray &log) const;
+   void processRevisionsChunk(const QByteArray &chunk);
+   void onRevisionsStreamFinished(bool success);
+   void prepareCacheSetup();
+   void appendRevisions(QVector<CommitInfo> commits);
+   void finishLoadingStep();
+   QVector<ObjectId> getLogTips(const QString &commitsToRetrieve) const;
+   bool loadCommitGraphFile(const QString &logCmd);
+   bool refreshLoadedHistory(const QString &logCmd);
+   bool isHistoryReachable(const QVector<ObjectId> &oldTips) const;
+   void requestNewRevisions(const QString &logCmd, const QVector<ObjectId> &oldTips);
+   void setHistoryLoaded();
+   void processNewRevisions(bool success);
+   void saveCommitGraphFile();
+   QVector<CommitInfo> parseLogRecords(const QByteArray &log, int end) const;
    QVector<CommitInfo> processSignedLog(QByteArray &log) const;
 };
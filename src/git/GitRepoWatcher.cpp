@@ -0,0 +1,398 @@
+#include "GitRepoWatcher.h"
+
+#include <GitBase.h>
+#include <GitRefsReader.h>
+
+#include <QLogger.h>
+
+#include <QDateTime>
+#include <QDir>
+#include <QFileInfo>
+#include <QtConcurrent>
+
+using namespace QLogger;
+
+namespace
+{
+// Every directory takes an inotify watch. The limit keeps big working directories (or the ones with build folders in
+// them) from exhausting the watches of the user.
+const int MAX_DIRECTORIES = 2000;
+const int DEBOUNCE_DELAY = 500;
+const int MAX_DEBOUNCE_DELAY = 2000;
+const int POLL_INTERVAL = 60000;
+const int UNWATCHED_POLL_INTERVAL = 15000;
+}
+
+GitRepoWatcher::GitRepoWatcher(const QString &workingDir, const QString &gitDir, QObject *parent)
+   : QObject(parent)
+   , mWorkingDir(QDir::cleanPath(workingDir))
+   , mGitDir(QDir::cleanPath(QDir(workingDir).absoluteFilePath(gitDir)))
+   , mCommonDir(GitRefsReader(mGitDir).commonDir())
+   , mRefsDir(QString("%1/refs").arg(mCommonDir))
+{
+   mDebounce.setSingleShot(true);
+   mDebounce.setInterval(DEBOUNCE_DELAY);
+
+   connect(&mDebounce, &QTimer::timeout, this, &GitRepoWatcher::processChanges);
+   connect(&mPoll, &QTimer::timeout, this, [this]() {
+      mPendingChanges |= WorkTree;
+      scheduleProcessing();
+   });
+   connect(&mWatcher, &QFileSystemWatcher::directoryChanged, this, &GitRepoWatcher::onDirectoryChanged);
+   connect(&mWatcher, &QFileSystemWatcher::fileChanged, this, &GitRepoWatcher::onFileChanged);
+   connect(&mScan, &QFutureWatcher<WorkTreeScan>::finished, this, &GitRepoWatcher::onScanFinished);
+}
+
+void GitRepoWatcher::start()
+{
+   const auto index = QString("%1/index").arg(mGitDir);
+   const auto head = QString("%1/HEAD").arg(mGitDir);
+   const auto packedRefs = QString("%1/packed-refs").arg(mCommonDir);
+
+   for (const auto &file : { index, head, packedRefs })
+      mGitFiles.insert(file, fileState(file));
+
+   auto directories = findDirectories(mRefsDir, MAX_DIRECTORIES);
+   directories.prepend(mGitDir);
+
+   if (mCommonDir != mGitDir)
+      directories.prepend(mCommonDir);
+
+   mWatcher.addPaths(directories);
+
+   const auto workingDir = mWorkingDir;
+   const auto limit = MAX_DIRECTORIES - mWatcher.directories().count();
+
+   mScan.setFuture(QtConcurrent::run([workingDir, limit]() {
+      WorkTreeScan scan;
+      scan.ignoredDirectories = findIgnoredDirectories(workingDir);
+      scan.directories = findDirectories(workingDir, limit, scan.ignoredDirectories);
+
+      return scan;
+   }));
+
+   updatePollInterval();
+}
+
+void GitRepoWatcher::setActive(bool active)
+{
+   if (mActive == active)
+      return;
+
+   mActive = active;
+
+   updatePollInterval();
+
+   if (mActive && mPendingChanges && !mDebounce.isActive())
+      processChanges();
+}
+
+void GitRepoWatcher::setModifiedFiles(const QStringList &files)
+{
+   if (!mModifiedFiles.isEmpty())
+      mWatcher.removePaths(mModifiedFiles);
+
+   mModifiedFiles.clear();
+
+   // The modified files count for the limit too, since they take a watch each
+   const auto available = MAX_DIRECTORIES - mWatcher.directories().count();
+
+   for (auto i = 0; i < files.count() && i < available; ++i)
+   {
+      const auto path = QString("%1/%2").arg(mWorkingDir, files.at(i));
+
+      if (QFileInfo(path).isFile())
+         mModifiedFiles.append(path);
+   }
+
+   if (!mModifiedFiles.isEmpty())
+      mWatcher.addPaths(mModifiedFiles);
+}
+
+QStringList GitRepoWatcher::findDirectories(const QString &root, int limit, const QSet<QString> &ignoredDirectories)
+{
+   QStringList directories;
+
+   if (!QFileInfo(root).isDir())
+      return directories;
+
+   directories.append(root);
+
+   // The directories are visited breadth first so, if the limit is reached, the top directories are the ones watched
+   for (auto i = 0; i < directories.count() && directories.count() <= limit; ++i)
+   {
+      const auto entries = QDir(directories.at(i)).entryInfoList(QDir::Dirs | QDir::NoDotAndDotDot | QDir::NoSymLinks
+                                                                 | QDir::Hidden);
+
+      for (const auto &entry : entries)
+      {
+         const auto path = entry.absoluteFilePath();
+
+         if (entry.fileName() != QStringLiteral(".git") && !ignoredDirectories.contains(path))
+            directories.append(path);
+      }
+   }
+
+   return directories;
+}
+
+QSet<QString> GitRepoWatcher::findIgnoredDirectories(const QString &workingDir)
+{
+   QSet<QString> directories;
+   const auto output = GitBase(workingDir).runRaw(
+       { "ls-files", "-z", "--others", "--ignored", "--exclude-standard", "--directory" });
+
+   if (!output)
+      return directories;
+
+   // The directories end with a slash, the rest are the ignored files
+   for (const auto &path : output->split('\0'))
+   {
+      if (path.endsWith('/'))
+         directories.insert(QString("%1/%2").arg(workingDir, QString::fromUtf8(path.chopped(1))));
+   }
+
+   return directories;
+}
+
+GitRepoWatcher::FileState GitRepoWatcher::fileState(const QString &path)
+{
+   const QFileInfo info(path);
+   FileState state;
+
+   if (info.exists())
+   {
+      state.modified = info.lastModified().toMSecsSinceEpoch();
+      state.size = info.size();
+   }
+
+   return state;
+}
+
+GitRepoWatcher::WorkTreeScan GitRepoWatcher::findNewDirectories(const QString &workingDir, const QString &refsDir,
+                                                                const QStringList &changedDirectories,
+                                                                QSet<QString> watched,
+                                                                const QSet<QString> &ignoredDirectories)
+{
+   WorkTreeScan scan;
+   QStringList createdDirectories;
+   QStringList workTreeDirectories;
+
+   for (const auto &directory : changedDirectories)
+   {
+      const auto entries = QDir(directory).entryInfoList(QDir::Dirs | QDir::NoDotAndDotDot | QDir::NoSymLinks
+                                                         | QDir::Hidden);
+
+      for (const auto &entry : entries)
+      {
+         const auto path = entry.absoluteFilePath();
+
+         if (entry.fileName() == QStringLiteral(".git") || watched.contains(path)
+             || isIgnored(path, workingDir, ignoredDirectories))
+         {
+            continue;
+         }
+
+         createdDirectories.append(path);
+
+         if (!path.startsWith(refsDir))
+            workTreeDirectories.append(path);
+      }
+   }
+
+   // The directories created in the working directory, like the one of a new build, may be ignored by Git
+   if (!workTreeDirectories.isEmpty())
+      scan.ignoredDirectories = GitRepoWatcher::ignoredDirectories(workingDir, workTreeDirectories);
+
+   const auto ignored = ignoredDirectories + scan.ignoredDirectories;
+
+   for (const auto &path : qAsConst(createdDirectories))
+   {
+      if (ignored.contains(path) || watched.contains(path))
+         continue;
+
+      const auto directories = findDirectories(path, MAX_DIRECTORIES, ignored);
+
+      for (const auto &newDirectory : directories)
+         watched.insert(newDirectory);
+
+      scan.directories.append(directories);
+   }
+
+   return scan;
+}
+
+QSet<QString> GitRepoWatcher::ignoredDirectories(const QString &workingDir, const QStringList &directories)
+{
+   QSet<QString> ignored;
+   QByteArray input;
+   const QDir dir(workingDir);
+
+   for (const auto &directory : directories)
+      input.append(dir.relativeFilePath(directory).toUtf8()).append('\0');
+
+   if (const auto output = GitBase(workingDir).runRaw({ "check-ignore", "-z", "--stdin" }, input))
+   {
+      for (const auto &path : output->split('\0'))
+      {
+         if (!path.isEmpty())
+            ignored.insert(dir.absoluteFilePath(QString::fromUtf8(path)));
+      }
+   }
+
+   return ignored;
+}
+
+bool GitRepoWatcher::isIgnored(const QString &path, const QString &workingDir, const QSet<QString> &ignoredDirectories)
+{
+   if (ignoredDirectories.isEmpty())
+      return false;
+
+   for (auto current = path; current.length() > workingDir.length(); current = QFileInfo(current).path())
+   {
+      if (ignoredDirectories.contains(current))
+         return true;
+   }
+
+   return false;
+}
+
+bool GitRepoWatcher::isIgnored(const QString &path) const
+{
+   return isIgnored(path, mWorkingDir, mIgnoredDirectories);
+}
+
+void GitRepoWatcher::onScanFinished()
+{
+   auto scan = mScan.result();
+   auto &directories = scan.directories;
+
+   mIgnoredDirectories.unite(scan.ignoredDirectories);
+
+   const auto limit = MAX_DIRECTORIES - mWatcher.directories().count();
+
+   if (directories.count() > limit)
+   {
+      QLog_Info("Git",
+                QString("The working directory {%1} has too many directories to watch. It will be checked every {%2} "
+                        "seconds.")
+                    .arg(mWorkingDir)
+                    .arg(UNWATCHED_POLL_INTERVAL / 1000));
+
+      mWorkTreeWatched = false;
+      directories = directories.mid(0, qMax(0, limit));
+   }
+
+   if (!directories.isEmpty())
+      mWatcher.addPaths(directories);
+
+   QLog_Debug("Git",
+              QString("Watching {%1} directories of {%2}.").arg(mWatcher.directories().count()).arg(mWorkingDir));
+
+   updatePollInterval();
+
+   // The directories created while scanning are looked for now
+   watchNewDirectories();
+}
+
+void GitRepoWatcher::onDirectoryChanged(const QString &path)
+{
+   if (path == mGitDir || path == mCommonDir)
+      mGitDirChanged = true;
+   else if (isIgnored(path))
+      return;
+   else
+   {
+      mPendingChanges |= path.startsWith(mRefsDir) ? References : WorkTree;
+      mChangedDirectories.insert(path);
+   }
+
+   scheduleProcessing();
+}
+
+void GitRepoWatcher::onFileChanged(const QString &path)
+{
+   if (isIgnored(path))
+      return;
+
+   if (mModifiedFiles.contains(path))
+      mChangedModifiedFiles.insert(QDir(mWorkingDir).relativeFilePath(path));
+
+   mPendingChanges |= WorkTree;
+
+   scheduleProcessing();
+}
+
+void GitRepoWatcher::scheduleProcessing()
+{
+   if (!mDebounce.isActive())
+      mPendingSince.start();
+
+   // The changes are reported even if the repository doesn't stop changing, like during a build
+   if (mPendingSince.elapsed() < MAX_DEBOUNCE_DELAY - DEBOUNCE_DELAY)
+      mDebounce.start();
+}
+
+void GitRepoWatcher::processChanges()
+{
+   // Git and GitQlient write more files than the ones that matter in the Git directory, like the lock files or the
+   // history cache, so only the changes in the index and in the references are taken into account.
+   if (mGitDirChanged)
+   {
+      mGitDirChanged = false;
+
+      for (auto iter = mGitFiles.begin(); iter != mGitFiles.end(); ++iter)
+      {
+         const auto state = fileState(iter.key());
+
+         if (state != iter.value())
+         {
+            mPendingChanges |= iter.key().endsWith(QStringLiteral("/index")) ? Index : References;
+            iter.value() = state;
+         }
+      }
+   }
+
+   watchNewDirectories();
+
+   if (mActive && mPendingChanges)
+   {
+      const auto changes = mPendingChanges;
+      const auto modifiedFiles = mChangedModifiedFiles.values();
+      mPendingChanges = {};
+      mChangedModifiedFiles.clear();
+
+      emit repositoryChanged(changes, modifiedFiles);
+   }
+}
+
+void GitRepoWatcher::watchNewDirectories()
+{
+   // Only one scan runs at a time: the changed directories wait for the current one to finish
+   if (mChangedDirectories.isEmpty() || mScan.isRunning())
+      return;
+
+   const auto watchedDirectories = mWatcher.directories();
+   QSet<QString> watched;
+
+   for (const auto &directory : watchedDirectories)
+      watched.insert(directory);
+
+   const auto changedDirectories = mChangedDirectories.values();
+   mChangedDirectories.clear();
+
+   // Listing the new directories and asking Git which of them are ignored blocks, so it's done in the background
+   mScan.setFuture(QtConcurrent::run(&GitRepoWatcher::findNewDirectories, mWorkingDir, mRefsDir, changedDirectories,
+                                     watched, mIgnoredDirectories));
+}
+
+void GitRepoWatcher::updatePollInterval()
+{
+   if (!mActive)
+   {
+      mPoll.stop();
+      return;
+   }
+
+   mPoll.start(mWorkTreeWatched ? POLL_INTERVAL : UNWATCHED_POLL_INTERVAL);
+}
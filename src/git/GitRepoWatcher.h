@@ -0,0 +1,159 @@
+#pragma once
+
+/****************************************************************************************
+ ** GitQlient is an application to manage and operate one or several Git repositories. With
+ ** GitQlient you will be able to add commits, branches and manage all the options Git provides.
+ ** Copyright (C) 2021  Francesc Martinez
+ **
+ ** LinkedIn: www.linkedin.com/in/cescmm/
+ ** Web: www.francescmm.com
+ **
+ ** This program is free software; you can redistribute it and/or
+ ** modify it under the terms of the GNU Lesser General Public
+ ** License as published by the Free Software Foundation; either
+ ** version 2 of the License, or (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ ** Lesser General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Lesser General Public
+ ** License along with this library; if not, write to the Free Software
+ ** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ ***************************************************************************************/
+
+
+#include <QElapsedTimer>
+#include <QFileSystemWatcher>
+#include <QFutureWatcher>
+#include <QHash>
+#include <QObject>
+#include <QSet>
+#include <QStringList>
+#include <QTimer>
+
+/**
+ * @brief The GitRepoWatcher class tells what changed in a repository: the index, the references or the files of the
+ * working directory. It watches the directories of the Git directory, the references and the working directory, and
+ * also the files that are already modified, so the changes that are made in place are noticed.
+ *
+ * The changes are coalesced: they are reported once the repository has been quiet for a moment. When the watcher is
+ * not active, the changes are kept and reported when it's activated again.
+ *
+ * The files that are modified in place and were not modified before can't be noticed through their directory, so the
+ * working directory is also checked periodically while the watcher is active. The check is more frequent when the
+ * working directory has too many directories to watch all of them.
+ *
+ * The directories ignored by Git, like the ones of the builds, are not watched: the changes in them don't change the
+ * status of the repository. The directories are found in the background, both the first time and when new ones are
+ * created.
+ */
+class GitRepoWatcher : public QObject
+{
+   Q_OBJECT
+
+public:
+   enum Change
+   {
+      Index = 0x1,
+      References = 0x2,
+      WorkTree = 0x4
+   };
+   Q_DECLARE_FLAGS(Changes, Change)
+
+signals:
+   /**
+    * @brief repositoryChanged Signal triggered when the repository changed and the watcher is active.
+    * @param changes The parts of the repository that changed.
+    * @param modifiedFiles The files that were already modified and were modified again, relative to the working
+    * directory. Their status doesn't change, so they're only known through the watcher.
+    */
+   void repositoryChanged(GitRepoWatcher::Changes changes, const QStringList &modifiedFiles);
+
+public:
+   /**
+    * @brief Default constructor.
+    * @param workingDir The working directory of the repository.
+    * @param gitDir The Git directory of the repository.
+    * @param parent The parent object if needed.
+    */
+   explicit GitRepoWatcher(const QString &workingDir, const QString &gitDir, QObject *parent = nullptr);
+
+   /**
+    * @brief start Starts watching the repository. The directories of the working directory are found in the background.
+    */
+   void start();
+
+   /**
+    * @brief setActive Activates or deactivates the watcher. An inactive watcher doesn't report anything nor checks the
+    * working directory periodically.
+    */
+   void setActive(bool active);
+
+   /**
+    * @brief setModifiedFiles Watches the files of the working directory that are modified.
+    * @param files The paths of the files relative to the working directory.
+    */
+   void setModifiedFiles(const QStringList &files);
+
+private:
+   struct WorkTreeScan
+   {
+      QStringList directories;
+      QSet<QString> ignoredDirectories;
+   };
+
+   struct FileState
+   {
+      qint64 modified = 0;
+      qint64 size = -1;
+
+      bool operator!=(const FileState &other) const { return modified != other.modified || size != other.size; }
+   };
+
+   QString mWorkingDir;
+   QString mGitDir;
+   QString mCommonDir;
+   QString mRefsDir;
+   QFileSystemWatcher mWatcher;
+   QFutureWatcher<WorkTreeScan> mScan;
+   QTimer mDebounce;
+   QTimer mPoll;
+   QElapsedTimer mPendingSince;
+   QHash<QString, FileState> mGitFiles;
+   QSet<QString> mChangedDirectories;
+   QSet<QString> mIgnoredDirectories;
+   QStringList mModifiedFiles;
+   QSet<QString> mChangedModifiedFiles;
+   Changes mPendingChanges;
+   bool mGitDirChanged = false;
+   bool mActive = true;
+   bool mWorkTreeWatched = true;
+
+   static QStringList findDirectories(const QString &root, int limit,
+                                      const QSet<QString> &ignoredDirectories = QSet<QString>());
+   static QSet<QString> findIgnoredDirectories(const QString &workingDir);
+   /**
+    * @brief findNewDirectories Finds the directories created inside @p changedDirectories that are not watched yet,
+    * with their subdirectories, and the ones of them that Git ignores.
+    */
+   static WorkTreeScan findNewDirectories(const QString &workingDir, const QString &refsDir,
+                                          const QStringList &changedDirectories, QSet<QString> watched,
+                                          const QSet<QString> &ignoredDirectories);
+   static FileState fileState(const QString &path);
+   static QSet<QString> ignoredDirectories(const QString &workingDir, const QStringList &directories);
+   static bool isIgnored(const QString &path, const QString &workingDir, const QSet<QString> &ignoredDirectories);
+
+   bool isIgnored(const QString &path) const;
+
+   void onScanFinished();
+   void onDirectoryChanged(const QString &path);
+   void onFileChanged(const QString &path);
+   void scheduleProcessing();
+   void processChanges();
+   void watchNewDirectories();
+   void updatePollInterval();
+};
+
+Q_DECLARE_OPERATORS_FOR_FLAGS(GitRepoWatcher::Changes)
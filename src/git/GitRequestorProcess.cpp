@@ -1,35 +1,66 @@
 #include "GitRequestorProcess.h"
 
 #include <QTemporaryFile>
-GitRequestorProcess::GitRequestorProcess(const QString &workingDir)
+GitRequestorProcess::GitRequestorProcess(const QString &workingDir, Mode mode)
    : AGitProcess(workingDir)
+   , mMode(mode)
 {
+   mKeepOutput = mMode == Mode::Buffered;
 }
 
 GitExecResult GitRequestorProcess::run(const QString &command)
 {
-   auto ret = false;
+   const auto ret = prepareOutput() && execute(command);
+
+   return { ret, "" };
+}
+
+GitExecResult GitRequestorProcess::run(const QStringList &arguments)
+{
+   const auto ret = prepareOutput() && execute(arguments);
+
+   return { ret, "" };
+}
+
+bool GitRequestorProcess::prepareOutput()
+{
+   if (mMode == Mode::Streaming)
+      return true;
 
    // Create temporary file
    mTempFile = new QTemporaryFile(this);
 
-   if (mTempFile->open()) // to read the file name
-   {
-      setStandardOutputFile(mTempFile->fileName());
-      mTempFile->close();
+   if (!mTempFile->open()) // to read the file name
+      return false;
 
-      ret = execute(command);
-   }
+   setStandardOutputFile(mTempFile->fileName());
+   mTempFile->close();
 
-   return { ret, "" };
+   return true;
 }
 
-void GitRequestorProcess::onFinished(int, QProcess::ExitStatus)
+void GitRequestorProcess::onFinished(int exitCode, QProcess::ExitStatus exitStatus)
 {
-   bool ok = mTempFile && (mTempFile->isOpen() || (mTempFile->exists() && mTempFile->open()));
+   if (mMode == Mode::Streaming)
+   {
+      // The last chunk might arrive together with the finished signal
+      const auto pendingOutput = readAllStandardOutput();
+
+      if (!mCanceling)
+      {
+         if (!pendingOutput.isEmpty())
+            emit procDataReady(pendingOutput);
 
-   if (ok && !mCanceling)
-      emit procDataReady(mTempFile->readAll());
+         emit procStreamFinished(exitStatus == QProcess::NormalExit && exitCode == 0);
+      }
+   }
+   else
+   {
+      bool ok = mTempFile && (mTempFile->isOpen() || (mTempFile->exists() && mTempFile->open()));
+
+      if (ok && !mCanceling)
+         emit procDataReady(mTempFile->readAll());
+   }
 
    deleteLater();
 }
@@ -27,15 +27,44 @@
 
 class QTemporaryFile;
 
+/**
+ * @brief The GitRequestorProcess class runs a Git command asynchronously and delivers its output through the
+ * procDataReady signal.
+ *
+ * In Buffered mode the output is redirected to a temporary file and delivered at once when the process finishes. In
+ * Streaming mode every chunk of the standard output is delivered as soon as it's available and the procStreamFinished
+ * signal is emitted when the process ends.
+ */
 class GitRequestorProcess : public AGitProcess
 {
+   Q_OBJECT
+
+signals:
+   /**
+    * @brief procStreamFinished Signal triggered in Streaming mode once the last chunk of data has been delivered.
+    * @param success True if the process finished normally, otherwise false.
+    */
+   void procStreamFinished(bool success);
+
 public:
-   explicit GitRequestorProcess(const QString &workingDir);
+   enum class Mode
+   {
+      Buffered,
+      Streaming
+   };
+
+   explicit GitRequestorProcess(const QString &workingDir, Mode mode = Mode::Buffered);
    GitExecResult run(const QString &command) override;
+   /**
+    * @brief run Runs Git with the given arguments without parsing them from a command line.
+    */
+   GitExecResult run(const QStringList &arguments);
 
 private:
-   void onFinished(int, QProcess::ExitStatus exitStatus) override;
+   void onFinished(int exitCode, QProcess::ExitStatus exitStatus) override;
+   bool prepareOutput();
 
 private:
+   Mode mMode = Mode::Buffered;
    QTemporaryFile *mTempFile = nullptr;
 };
@@ -19,3 +19,20 @@ GitExecResult GitSyncProcess::run(const QString &command)
 
    return { !mRealError, mRunOutput };
 }
+
+std::optional<QByteArray> GitSyncProcess::runRaw(const QStringList &arguments)
+{
+   mKeepRawOutput = true;
+
+   const auto processStarted = execute(arguments);
+
+   if (processStarted)
+      waitForFinished(10000);
+
+   close();
+
+   if (!processStarted || mRealError)
+      return std::nullopt;
+
+   return mRawOutput;
+}
@@ -25,10 +25,18 @@
 
 #include "AGitProcess.h"
 
+#include <optional>
+
 class GitSyncProcess final : public AGitProcess
 {
 public:
    GitSyncProcess(const QString &workingDir);
 
    GitExecResult run(const QString &command) override;
+   /**
+    * @brief runRaw Runs Git with the given arguments and returns its standard output as it is, without converting it
+    * to text.
+    * @return The output or nothing if the command failed.
+    */
+   std::optional<QByteArray> runRaw(const QStringList &arguments);
 };
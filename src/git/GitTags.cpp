@@ -75,6 +75,7 @@ GitExecResult GitTags::removeTag(const QString &tagName, bool remote)
       QLog_Trace("Git", QString("Removing tag: {%1}").arg(cmd));
 
       ret = mGitBase->run(cmd);
+      mGitBase->invalidateRemoteTags();
    }
 
    if (!remote || (remote && ret.success))
@@ -98,6 +99,7 @@ GitExecResult GitTags::pushTag(const QString &tagName)
    QLog_Trace("Git", QString("Pushing a tag: {%1}").arg(cmd));
 
    const auto ret = mGitBase->run(cmd);
+   mGitBase->invalidateRemoteTags();
 
    return ret;
 }
@@ -144,4 +146,6 @@ void GitTags::onRemoteTagsRecieved(GitExecResult result)
    }
 
    mCache->updateTags(std::move(tags));
+
+   emit remoteTagsReceived(result.success);
 }
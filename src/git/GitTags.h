@@ -36,6 +36,13 @@ class GitTags : public QObject
 {
    Q_OBJECT
 
+signals:
+   /**
+    * @brief remoteTagsReceived Signal triggered when the request of the remote tags finishes.
+    * @param success False if the remote couldn't be read.
+    */
+   void remoteTagsReceived(bool success);
+
 public:
    explicit GitTags(const QSharedPointer<GitBase> &gitBase);
    explicit GitTags(const QSharedPointer<GitBase> &gitBase, const QSharedPointer<GitCache> &cache);
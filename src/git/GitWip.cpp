@@ -5,59 +5,107 @@
 
 #include <QLogger.h>
 
-#include <QFile>
+#include <algorithm>
+#include <cstring>
 
 using namespace QLogger;
 
-GitWip::GitWip(const QSharedPointer<GitBase> &git, const QSharedPointer<GitCache> &cache)
-   : mGit(git)
-   , mCache(cache)
+namespace
 {
-}
+const char BRANCH_OID_HEADER[] = "# branch.oid ";
+const int BRANCH_OID_HEADER_SIZE = sizeof(BRANCH_OID_HEADER) - 1;
+
+// Fields of the tracked entries before the path
+const int ORDINARY_FIELDS = 8;
+const int RENAMED_FIELDS = 9;
+const int UNMERGED_FIELDS = 10;
+// Fields of the tracked entries before the blob in HEAD, the one in the index goes next
+const int HEAD_OBJECT_FIELDS = 6;
 
-QVector<QString> GitWip::getUntrackedFiles() const
+const char *skipFields(const char *begin, const char *end, int fields)
 {
-   QLog_Debug("Git", QString("Executing getUntrackedFiles."));
+   for (auto field = 0; field < fields; ++field)
+   {
+      const auto space = static_cast<const char *>(memchr(begin, ' ', static_cast<size_t>(end - begin)));
 
-   auto runCmd = QString("git ls-files --others --exclude-standard");
+      if (!space)
+         return nullptr;
 
-#if QT_VERSION >= QT_VERSION_CHECK(5, 14, 0)
-   const auto ret = mGit->run(runCmd).output.split('\n', Qt::SkipEmptyParts).toVector();
-#else
-   const auto ret = mGit->run(runCmd).output.split('\n', QString::SkipEmptyParts).toVector();
-#endif
+      begin = space + 1;
+   }
 
-   return ret;
+   return begin;
 }
 
-std::optional<QPair<QString, RevisionFiles>> GitWip::getWipInfo() const
+const char *recordEnd(const char *begin, const char *end)
 {
-   QLog_Debug("Git", QString("Executing processWip."));
+   const auto separator = static_cast<const char *>(memchr(begin, '\0', static_cast<size_t>(end - begin)));
 
-   const auto ret = mGit->run("git rev-parse --revs-only HEAD");
+   return separator ? separator : end;
+}
 
-   if (ret.success)
+// The files added or deleted have the all-zeros id in the side where they don't exist
+ObjectId readObject(const char *begin, const char *end)
+{
+   const auto space = static_cast<const char *>(memchr(begin, ' ', static_cast<size_t>(end - begin)));
+   const auto id = space ? ObjectId::fromHex(begin, static_cast<int>(space - begin)) : ObjectId();
+
+   return id == CommitInfo::ZERO_ID ? ObjectId() : id;
+}
+
+WipFileObjects readObjects(const char *begin, const char *end)
+{
+   WipFileObjects objects;
+
+   if (const auto head = skipFields(begin, end, HEAD_OBJECT_FIELDS))
    {
-      QString diffIndex;
-      QString diffIndexCached;
+      objects.head = readObject(head, end);
 
-      auto parentSha = ret.output.trimmed();
+      if (const auto index = skipFields(head, end, 1))
+         objects.index = readObject(index, end);
+   }
 
-      if (parentSha.isEmpty())
-         parentSha = CommitInfo::INIT_SHA;
+   return objects;
+}
 
-      const auto ret3 = mGit->run(QString("git diff-index %1").arg(parentSha));
-      diffIndex = ret3.success ? ret3.output : QString();
+// The flags are the same that the comparison of the working directory and the index with HEAD used to produce
+int trackedStatus(char indexStatus, char workTreeStatus)
+{
+   int status = RevisionFiles::MODIFIED;
 
-      const auto ret4 = mGit->run(QString("git diff-index --cached %1").arg(parentSha));
-      diffIndexCached = ret4.success ? ret4.output : QString();
+   if (indexStatus == 'A' || workTreeStatus == 'A')
+      status = RevisionFiles::NEW;
+   else if (indexStatus == 'D' || workTreeStatus == 'D')
+      status = RevisionFiles::DELETED;
 
-      auto files = fakeWorkDirRevFile(diffIndex, diffIndexCached);
+   if (workTreeStatus == '.')
+      status |= RevisionFiles::IN_INDEX;
+   else if (indexStatus == 'M' || indexStatus == 'T')
+      status |= RevisionFiles::PARTIALLY_CACHED;
+   else if (indexStatus != '.')
+      status |= RevisionFiles::IN_INDEX;
 
-      return qMakePair(parentSha, std::move(files));
-   }
+   return status;
+}
+}
 
-   return std::nullopt;
+GitWip::GitWip(const QSharedPointer<GitBase> &git, const QSharedPointer<GitCache> &cache)
+   : mGit(git)
+   , mCache(cache)
+{
+}
+
+std::optional<GitWip::WipStatus> GitWip::getWipStatus() const
+{
+   QLog_Debug("Git", QString("Executing getWipStatus."));
+
+   // The output is read as bytes: the NUL separators would cut it if it was converted to text
+   const auto output = mGit->runRaw(statusArguments());
+
+   if (!output)
+      return std::nullopt;
+
+   return parseStatus(*output);
 }
 
 std::optional<GitWip::FileStatus> GitWip::getFileStatus(const QString &filePath) const
@@ -92,58 +140,141 @@ std::optional<GitWip::FileStatus> GitWip::getFileStatus(const QString &filePath)
 
 bool GitWip::updateWip() const
 {
-   const auto files = getUntrackedFiles();
-   mCache->setUntrackedFilesList(std::move(files));
-
-   if (const auto info = getWipInfo())
+   if (auto status = getWipStatus())
    {
-      return mCache->updateWipCommit(info->first, info->second);
+      mCache->setUntrackedFilesList(std::move(status->untrackedFiles));
+      mCache->setWipFileObjects(std::move(status->objects));
+
+      return mCache->updateWipCommit(status->parentSha, status->files);
    }
 
    return false;
 }
 
-RevisionFiles GitWip::fakeWorkDirRevFile(const QString &diffIndex, const QString &diffIndexCache) const
+QStringList GitWip::statusArguments()
 {
-   RevisionFiles rf(diffIndex);
-   rf.setOnlyModified(false);
+   // The status doesn't refresh the index: it would compete for the lock with the Git commands run by the user
+   return { "--no-optional-locks", "status", "--porcelain=v2", "-z", "--branch", "--untracked-files=all" };
+}
 
-   for (const auto &it : mCache->getUntrackedFiles())
-   {
-      rf.mFiles.append(it);
-      rf.setStatus(RevisionFiles::UNKNOWN);
-      rf.mergeParent.append(1);
-   }
+std::optional<GitWip::WipStatus> GitWip::parseStatus(const QByteArray &output)
+{
+   WipStatus status;
+   QVector<QPair<QString, int>> trackedFiles;
+   auto hasBranchHeader = false;
 
-   RevisionFiles cachedFiles(diffIndexCache, true);
+   auto current = output.constData();
+   const auto end = current + output.size();
 
-   for (auto i = 0; i < rf.count(); i++)
+   while (current < end)
    {
-      if (const auto cachedIndex = cachedFiles.mFiles.indexOf(rf.getFile(i)); cachedIndex != -1)
+      auto currentEnd = recordEnd(current, end);
+      const auto size = currentEnd - current;
+
+      if (size < 3)
       {
-         if (cachedFiles.statusCmp(cachedIndex, RevisionFiles::CONFLICT))
-         {
-            rf.appendStatus(i, RevisionFiles::CONFLICT);
+         current = currentEnd + 1;
+         continue;
+      }
 
-            const auto status = getFileStatus(rf.getFile(i));
+      switch (*current)
+      {
+         case '#':
+            if (size > BRANCH_OID_HEADER_SIZE && memcmp(current, BRANCH_OID_HEADER, BRANCH_OID_HEADER_SIZE) == 0)
+            {
+               const auto oid = current + BRANCH_OID_HEADER_SIZE;
+               const auto oidSize = static_cast<int>(currentEnd - oid);
 
-            switch (status.value_or(GitWip::FileStatus::BothModified))
+               hasBranchHeader = true;
+               status.parentSha = oid[0] == '(' ? CommitInfo::INIT_SHA : QString::fromLatin1(oid, oidSize);
+            }
+            break;
+         case '1':
+            if (const auto path = skipFields(current, currentEnd, ORDINARY_FIELDS))
             {
-               case GitWip::FileStatus::DeletedByThem:
-               case GitWip::FileStatus::DeletedByUs:
-                  rf.appendStatus(i, RevisionFiles::DELETED);
-                  break;
-               default:
-                  break;
+               const auto file = QString::fromUtf8(path, static_cast<int>(currentEnd - path));
+
+               trackedFiles.append({ file, trackedStatus(current[2], current[3]) });
+               status.objects.insert(file, readObjects(current, currentEnd));
             }
+            break;
+         case '2':
+         {
+            // The original path is the next record
+            const auto path = skipFields(current, currentEnd, RENAMED_FIELDS);
+            const auto originalPath = currentEnd + 1;
+            const auto originalPathEnd = originalPath < end ? recordEnd(originalPath, end) : end;
+
+            if (path)
+            {
+               const auto file = QString::fromUtf8(path, static_cast<int>(currentEnd - path));
+               const auto objects = readObjects(current, currentEnd);
+
+               // Each path is compared on its own, so the new one doesn't exist in HEAD
+               trackedFiles.append({ file, RevisionFiles::NEW | RevisionFiles::IN_INDEX });
+               status.objects.insert(file, { ObjectId(), objects.index });
+
+               if (current[2] == 'R' && originalPath < end)
+               {
+                  const auto originalPathSize = static_cast<int>(originalPathEnd - originalPath);
+                  const auto originalFile = QString::fromUtf8(originalPath, originalPathSize);
+
+                  trackedFiles.append({ originalFile, RevisionFiles::DELETED | RevisionFiles::IN_INDEX });
+                  status.objects.insert(originalFile, { objects.head, ObjectId() });
+               }
+            }
+
+            currentEnd = originalPathEnd;
+            break;
          }
-         else if (cachedFiles.statusCmp(cachedIndex, RevisionFiles::MODIFIED)
-                  && cachedFiles.statusCmp(cachedIndex, RevisionFiles::IN_INDEX))
-            rf.appendStatus(i, RevisionFiles::PARTIALLY_CACHED);
-         else if (cachedFiles.statusCmp(cachedIndex, RevisionFiles::IN_INDEX))
-            rf.appendStatus(i, RevisionFiles::IN_INDEX);
+         case 'u':
+            if (const auto path = skipFields(current, currentEnd, UNMERGED_FIELDS))
+            {
+               auto fileStatus = RevisionFiles::MODIFIED | RevisionFiles::CONFLICT;
+
+               if (current[2] == 'D' || current[3] == 'D')
+                  fileStatus |= RevisionFiles::DELETED;
+
+               trackedFiles.append({ QString::fromUtf8(path, static_cast<int>(currentEnd - path)), fileStatus });
+            }
+            break;
+         case '?':
+            status.untrackedFiles.append(QString::fromUtf8(current + 2, static_cast<int>(size - 2)));
+            break;
+         default:
+            break;
       }
+
+      current = currentEnd + 1;
+   }
+
+   if (!hasBranchHeader)
+      return std::nullopt;
+
+   // The renamed files are split in the new and the original path, that goes in its own position
+   std::sort(trackedFiles.begin(), trackedFiles.end(),
+             [](const QPair<QString, int> &first, const QPair<QString, int> &second) {
+                return first.first < second.first;
+             });
+
+   auto &files = status.files;
+   files.setOnlyModified(false);
+   files.mFiles.reserve(trackedFiles.count() + status.untrackedFiles.count());
+   files.mergeParent.reserve(files.mFiles.capacity());
+
+   for (const auto &file : qAsConst(trackedFiles))
+   {
+      files.mFiles.append(file.first);
+      files.mergeParent.append(1);
+      files.setStatus(static_cast<RevisionFiles::StatusFlag>(file.second));
+   }
+
+   for (const auto &file : qAsConst(status.untrackedFiles))
+   {
+      files.mFiles.append(file);
+      files.mergeParent.append(1);
+      files.setStatus(RevisionFiles::UNKNOWN);
    }
 
-   return rf;
+   return status;
 }
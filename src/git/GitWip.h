@@ -20,16 +20,40 @@ public:
       DeletedByUs
    };
 
+   /**
+    * @brief The WipStatus struct stores the state of the working directory: the commit it's based on and the files
+    * that changed, with the untracked ones at the end, and the blobs of the tracked ones.
+    */
+   struct WipStatus
+   {
+      QString parentSha;
+      RevisionFiles files;
+      QVector<QString> untrackedFiles;
+      QHash<QString, WipFileObjects> objects;
+   };
+
    explicit GitWip(const QSharedPointer<GitBase> &git, const QSharedPointer<GitCache> &cache);
 
-   QVector<QString> getUntrackedFiles() const;
    bool updateWip() const;
-   std::optional<QPair<QString, RevisionFiles>> getWipInfo() const;
+   /**
+    * @brief getWipStatus Reads the state of the working directory with a single Git process.
+    * @return The state of the working directory or nothing if Git failed.
+    */
+   std::optional<WipStatus> getWipStatus() const;
    std::optional<FileStatus> getFileStatus(const QString &filePath) const;
 
+   /**
+    * @brief statusArguments Returns the arguments of the Git command whose output is read by parseStatus.
+    */
+   static QStringList statusArguments();
+   /**
+    * @brief parseStatus Parses the output of git status in porcelain v2 format with NUL separators. The output is read
+    * in place and it can be called from any thread.
+    * @return The state of the working directory or nothing if @p output is not a valid status.
+    */
+   static std::optional<WipStatus> parseStatus(const QByteArray &output);
+
 private:
    QSharedPointer<GitBase> mGit;
    QSharedPointer<GitCache> mCache;
-
-   RevisionFiles fakeWorkDirRevFile(const QString &diffIndex, const QString &diffIndexCache) const;
 };
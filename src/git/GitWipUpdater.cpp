@@ -0,0 +1,129 @@
+#include "GitWipUpdater.h"
+
+#include <GitCache.h>
+#include <GitJobScheduler.h>
+
+#include <QLogger.h>
+
+#include <QtConcurrent>
+
+using namespace QLogger;
+
+GitWipUpdater::GitWipUpdater(GitJobScheduler *scheduler, const QSharedPointer<GitCache> &cache, QObject *parent)
+   : QObject(parent)
+   , mScheduler(scheduler)
+   , mCache(cache)
+{
+   connect(&mWatcher, &QFutureWatcher<Changes>::finished, this, &GitWipUpdater::applyChanges);
+}
+
+void GitWipUpdater::update(const QStringList &modifiedFiles)
+{
+   for (const auto &file : modifiedFiles)
+      mModifiedFiles.insert(file);
+
+   if (mRunning)
+   {
+      mPending = true;
+      return;
+   }
+
+   QLog_Debug("Git", QString("Reading the status of the working directory."));
+
+   const auto job = mScheduler->schedule(GitJobPriority::Refresh, GitWip::statusArguments());
+   connect(job, &GitJob::finished, this, &GitWipUpdater::processStatus);
+
+   mRunning = true;
+}
+
+GitWipUpdater::Changes GitWipUpdater::computeChanges(const QByteArray &output, const QHash<QString, int> &filesStatus,
+                                                     const QSet<QString> &modifiedFiles)
+{
+   Changes changes;
+   changes.status = GitWip::parseStatus(output);
+
+   if (!changes.status)
+      return changes;
+
+   const auto &files = changes.status->files;
+   changes.filesStatus.reserve(files.count());
+
+   for (auto i = 0; i < files.count(); ++i)
+   {
+      const auto &file = files.mFiles.at(i);
+      const auto status = files.getStatus(i);
+
+      changes.filesStatus.insert(file, status);
+
+      if (const auto previous = filesStatus.constFind(file);
+          previous == filesStatus.cend() || *previous != status || modifiedFiles.contains(file))
+      {
+         changes.changedFiles.append(file);
+      }
+   }
+
+   for (auto iter = filesStatus.cbegin(); iter != filesStatus.cend(); ++iter)
+   {
+      if (!changes.filesStatus.contains(iter.key()))
+         changes.changedFiles.append(iter.key());
+   }
+
+   return changes;
+}
+
+void GitWipUpdater::processStatus(bool success, const QByteArray &output)
+{
+   if (!success)
+   {
+      QLog_Warning("Git", QString("The status of the working directory couldn't be read."));
+
+      mRunning = false;
+      updatePending();
+      return;
+   }
+
+   const auto filesStatus = mFilesStatus;
+   const auto modifiedFiles = std::exchange(mModifiedFiles, QSet<QString>());
+
+   mWatcher.setFuture(QtConcurrent::run(
+       [output, filesStatus, modifiedFiles]() { return computeChanges(output, filesStatus, modifiedFiles); }));
+}
+
+void GitWipUpdater::applyChanges()
+{
+   auto changes = mWatcher.result();
+
+   mRunning = false;
+
+   if (!changes.status)
+      QLog_Warning("Git", QString("The status of the working directory couldn't be read."));
+   else
+   {
+      // A file staged again keeps its status but not its blob in the index
+      mCache->setWipFileObjects(std::move(changes.status->objects));
+
+      if (!changes.changedFiles.isEmpty() || changes.status->parentSha != mParentSha)
+      {
+         QLog_Debug("Git", QString("{%1} files changed in the working directory.").arg(changes.changedFiles.count()));
+
+         mFilesStatus = std::move(changes.filesStatus);
+         mParentSha = changes.status->parentSha;
+
+         mCache->setUntrackedFilesList(std::move(changes.status->untrackedFiles));
+
+         if (mCache->updateWipCommit(mParentSha, changes.status->files))
+            emit wipChanged(changes.changedFiles);
+      }
+   }
+
+   updatePending();
+}
+
+void GitWipUpdater::updatePending()
+{
+   if (mPending)
+   {
+      mPending = false;
+      update();
+   }
+}
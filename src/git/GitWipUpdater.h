@@ -0,0 +1,101 @@
+#pragma once
+
+/****************************************************************************************
+ ** GitQlient is an application to manage and operate one or several Git repositories. With
+ ** GitQlient you will be able to add commits, branches and manage all the options Git provides.
+ ** Copyright (C) 2021  Francesc Martinez
+ **
+ ** LinkedIn: www.linkedin.com/in/cescmm/
+ ** Web: www.francescmm.com
+ **
+ ** This program is free software; you can redistribute it and/or
+ ** modify it under the terms of the GNU Lesser General Public
+ ** License as published by the Free Software Foundation; either
+ ** version 2 of the License, or (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ ** Lesser General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Lesser General Public
+ ** License along with this library; if not, write to the Free Software
+ ** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ ***************************************************************************************/
+
+
+#include <GitWip.h>
+
+#include <QFutureWatcher>
+#include <QHash>
+#include <QObject>
+#include <QSet>
+#include <QSharedPointer>
+
+class GitCache;
+class GitJobScheduler;
+
+/**
+ * @brief The GitWipUpdater class refreshes the WIP commit of the cache without blocking the UI. The status of the
+ * working directory is read with a single Git process, scheduled as a refresh, and parsed in the global thread pool.
+ *
+ * The status of every file is kept in a hash so the new status is compared with the previous one: the cache and the
+ * views are only updated when a file changed.
+ */
+class GitWipUpdater : public QObject
+{
+   Q_OBJECT
+
+signals:
+   /**
+    * @brief wipChanged Signal triggered when the WIP commit of the cache has been updated.
+    * @param files The files whose status changed. It's empty if only the parent commit changed.
+    */
+   void wipChanged(const QStringList &files);
+
+public:
+   explicit GitWipUpdater(GitJobScheduler *scheduler, const QSharedPointer<GitCache> &cache,
+                          QObject *parent = nullptr);
+
+   /**
+    * @brief update Starts reading the status of the working directory. If there is an update in progress, another
+    * one is started when it finishes.
+    * @param modifiedFiles The files whose content is known to have changed. They're reported as changed even if their
+    * status is the same, so their diff is reloaded.
+    */
+   void update(const QStringList &modifiedFiles = QStringList());
+
+   /**
+    * @brief isRunning Tells if there is an update in progress.
+    */
+   bool isRunning() const { return mRunning; }
+
+   /**
+    * @brief files Returns the files of the working directory that are not clean after the last update.
+    */
+   QStringList files() const { return mFilesStatus.keys(); }
+
+private:
+   struct Changes
+   {
+      std::optional<GitWip::WipStatus> status;
+      QHash<QString, int> filesStatus;
+      QStringList changedFiles;
+   };
+
+   GitJobScheduler *mScheduler = nullptr;
+   QSharedPointer<GitCache> mCache;
+   QFutureWatcher<Changes> mWatcher;
+   QHash<QString, int> mFilesStatus;
+   QSet<QString> mModifiedFiles;
+   QString mParentSha;
+   bool mRunning = false;
+   bool mPending = false;
+
+   static Changes computeChanges(const QByteArray &output, const QHash<QString, int> &filesStatus,
+                                 const QSet<QString> &modifiedFiles);
+
+   void processStatus(bool success, const QByteArray &output);
+   void applyChanges();
+   void updatePending();
+};
@@ -18,7 +18,7 @@ PrChangeListItem::PrChangeListItem(DiffChange change, QWidget *parent)
 {
    setObjectName("PrChangeListItem");
 
-   DiffHelper::processDiff(change.content, change.newData, change.oldData);
+   DiffHelper::processDiff(change.diff, change.hunk, change.newData, change.oldData);
 
    const auto fileName = change.oldFileName == change.newFileName
        ? change.newFileName
@@ -26,7 +26,6 @@ PrChangesList::PrChangesList(const QSharedPointer<GitBase> &git, QWidget *parent
 
 void PrChangesList::loadData(const GitServer::PullRequest &prInfo)
 {
-   GitExecResult ret;
    bool showDiff = true;
    QString head;
    GitConfig gitConfig(mGit);
@@ -72,12 +71,10 @@ void PrChangesList::loadData(const GitServer::PullRequest &prInfo)
    const auto base = QString("%1/%2").arg(retBase.success ? retBase.output : "origin", prInfo.base);
 
    GitHistory git(mGit);
-   ret = git.getBranchesDiff(base, head);
 
-   if (ret.success)
+   if (const auto diff = git.getBranchesDiff(base, head))
    {
-      auto diff = ret.output;
-      auto changes = DiffHelper::splitDiff(diff);
+      auto changes = DiffHelper::splitDiff(*diff);
 
       if (!changes.isEmpty())
       {
@@ -382,16 +382,16 @@ void CommitHistoryContextMenu::cherryPickCommit()
       if (ret.success && shas.isEmpty())
       {
          auto commit = mCache->commitInfo(sha);
-         commit.sha = mGit->getLastCommit().output.trimmed();
+         commit.setSha(mGit->getLastCommit().output.trimmed());
 
          mCache->insertCommit(commit);
          mCache->deleteReference(lastShaBeforeCommit, References::Type::LocalBranch, mGit->getCurrentBranch());
-         mCache->insertReference(commit.sha, References::Type::LocalBranch, mGit->getCurrentBranch());
+         mCache->insertReference(commit.sha(), References::Type::LocalBranch, mGit->getCurrentBranch());
 
          GitHistory gitHistory(mGit);
-         const auto ret = gitHistory.getDiffFiles(commit.sha, lastShaBeforeCommit);
+         const auto ret = gitHistory.getDiffFiles(commit.sha(), lastShaBeforeCommit);
 
-         mCache->insertRevisionFiles(commit.sha, lastShaBeforeCommit, RevisionFiles(ret.output));
+         mCache->insertRevisionFiles(commit.sha(), lastShaBeforeCommit, RevisionFiles(ret.output));
 
          emit mCache->signalCacheUpdated();
          emit logReload();
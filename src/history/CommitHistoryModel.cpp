@@ -22,11 +22,13 @@ CommitHistoryModel::CommitHistoryModel(const QSharedPointer<GitCache> &cache, co
    mColumns.insert(CommitHistoryColumns::Log, "History");
    mColumns.insert(CommitHistoryColumns::Author, "Author");
    mColumns.insert(CommitHistoryColumns::Date, "Date");
+
+   connect(mCache.get(), &GitCache::signalWipUpdated, this, &CommitHistoryModel::onWipUpdated);
 }
 
 int CommitHistoryModel::rowCount(const QModelIndex &parent) const
 {
-   return !parent.isValid() ? mCache->commitCount() : 0;
+   return !parent.isValid() ? mRowCount : 0;
 }
 
 bool CommitHistoryModel::hasChildren(const QModelIndex &parent) const
@@ -42,6 +44,8 @@ QString CommitHistoryModel::sha(int row) const
 void CommitHistoryModel::clear()
 {
    beginResetModel();
+   setSnapshot(GitCache::CommitsSnapshot());
+   mRowCount = 0;
    endResetModel();
    emit headerDataChanged(Qt::Horizontal, 0, 5);
 }
@@ -49,10 +53,64 @@ void CommitHistoryModel::clear()
 void CommitHistoryModel::onNewRevisions(int totalCommits)
 {
    beginResetModel();
+   setSnapshot(mCache->snapshot());
+   mRowCount = qMin(totalCommits, mSnapshot.count());
    endResetModel();
+}
+
+void CommitHistoryModel::onRevisionsAppended(int totalCommits)
+{
+   auto snapshot = mCache->snapshot();
+   const auto rowCount = qMin(totalCommits, snapshot.count());
+
+   if (rowCount > mRowCount)
+   {
+      beginInsertRows(QModelIndex(), mRowCount, rowCount - 1);
+      setSnapshot(std::move(snapshot));
+      mRowCount = rowCount;
+      endInsertRows();
+   }
+   else if (rowCount < mRowCount)
+      onNewRevisions(totalCommits);
+}
+
+void CommitHistoryModel::onRevisionsPrepended(int newCommits, int lastUpdatedRow)
+{
+   auto snapshot = mCache->snapshot();
+
+   if (mRowCount == 0 || snapshot.count() != mRowCount + newCommits)
+   {
+      onNewRevisions(snapshot.count());
+      return;
+   }
+
+   if (newCommits > 0)
+   {
+      beginInsertRows(QModelIndex(), 1, newCommits);
+      setSnapshot(std::move(snapshot));
+      mRowCount += newCommits;
+      endInsertRows();
+   }
+   else
+      setSnapshot(std::move(snapshot));
+
+   // The WIP and the rows whose lanes were calculated again
+   emit dataChanged(index(0, 0), index(qMin(lastUpdatedRow, mRowCount - 1), columnCount() - 1));
+}
 
-   beginInsertRows(QModelIndex(), 0, totalCommits - 2);
-   endInsertRows();
+void CommitHistoryModel::setSnapshot(GitCache::CommitsSnapshot snapshot)
+{
+   mSnapshot = std::move(snapshot);
+   mLanesLayout.setSource(mSnapshot.commits, mSnapshot.lanesCheckpoints);
+}
+
+void CommitHistoryModel::onWipUpdated()
+{
+   if (mRowCount > 0)
+   {
+      mSnapshot.wip = mCache->commitInfo(0);
+      emit dataChanged(index(0, 0), index(0, columnCount() - 1));
+   }
 }
 
 QVariant CommitHistoryModel::headerData(int section, Qt::Orientation orientation, int role) const
@@ -65,7 +123,7 @@ QVariant CommitHistoryModel::headerData(int section, Qt::Orientation orientation
 
 QModelIndex CommitHistoryModel::index(int row, int column, const QModelIndex &) const
 {
-   return row >= 0 && row < mCache->commitCount() ? createIndex(row, column, nullptr) : QModelIndex();
+   return row >= 0 && row < mRowCount ? createIndex(row, column, nullptr) : QModelIndex();
 }
 
 QModelIndex CommitHistoryModel::parent(const QModelIndex &) const
@@ -76,7 +134,7 @@ QModelIndex CommitHistoryModel::parent(const QModelIndex &) const
 QVariant CommitHistoryModel::getToolTipData(const CommitInfo &r) const
 {
    QString auxMessage;
-   const auto sha = r.sha;
+   const auto sha = r.sha();
 
    if (mGit->getCurrentBranch().isEmpty())
       auxMessage.append(tr("<p>Status: <b>detached</b></p>"));
@@ -125,7 +183,7 @@ QVariant CommitHistoryModel::getDisplayData(const CommitInfo &rev, int column) c
    switch (static_cast<CommitHistoryColumns>(column))
    {
       case CommitHistoryColumns::Sha: {
-         const auto sha = rev.sha;
+         const auto sha = rev.sha();
          return sha;
       }
       case CommitHistoryColumns::Log:
@@ -147,7 +205,7 @@ QVariant CommitHistoryModel::data(const QModelIndex &index, int role) const
    if (!index.isValid() || (role != Qt::DisplayRole && role != Qt::ToolTipRole))
       return QVariant();
 
-   const auto r = mCache->commitInfo(index.row());
+   const auto &r = mSnapshot.at(index.row());
 
    if (role == Qt::ToolTipRole)
       return getToolTipData(r);
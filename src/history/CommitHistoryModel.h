@@ -23,12 +23,13 @@
  ** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
  ***************************************************************************************/
 
+#include <GitCache.h>
+#include <LanesLayout.h>
+
 #include <QAbstractItemModel>
 #include <QSharedPointer>
 
-class GitCache;
 class GitBase;
-class CommitInfo;
 class GitServerCache;
 enum class CommitHistoryColumns;
 
@@ -64,6 +65,23 @@ public:
     * @return QString The SHA.
     */
    QString sha(int row) const;
+   /**
+    * @brief Returns the commit shown in the given row of the model. The commit belongs to the snapshot of the cache
+    * taken in the last update of the model, so it's read without locking the cache nor copying the commit.
+    *
+    * @param row The row of the commit. It must be a valid row of the model.
+    * @return The commit.
+    */
+   const CommitInfo &commitAt(int row) const { return mSnapshot.at(row); }
+
+   /**
+    * @brief Returns the lanes of the graph in the given row. They are calculated when the row is painted from the
+    * checkpoints of the snapshot, only the lanes of the rows close to it are kept.
+    *
+    * @param row The row of the commit. It must be a valid row of the model.
+    * @return The lanes of the row.
+    */
+   QVector<Lane> lanesAt(int row) const { return row == 0 ? mSnapshot.wip.lanes() : mLanesLayout.lanesAt(row); }
 
    /**
     * @brief Returns the data stored under the given \p role for the item referred to by the \p index
@@ -125,6 +143,23 @@ public:
     * @param totalCommits The total of new revisions.
     */
    void onNewRevisions(int totalCommits);
+   /**
+    * @brief Inserts the rows of the revisions appended to the cache since the last update without resetting the model.
+    *
+    * @param totalCommits The new total of revisions.
+    */
+   void onRevisionsAppended(int totalCommits);
+   /**
+    * @brief Inserts the rows of the revisions added on top of the history, after the WIP, without resetting the model.
+    *
+    * @param newCommits The number of revisions added.
+    * @param lastUpdatedRow The last row whose graph changed.
+    */
+   void onRevisionsPrepended(int newCommits, int lastUpdatedRow);
+   /**
+    * @brief Updates the WIP commit shown in the first row.
+    */
+   void onWipUpdated();
    /*!
     * \brief Gets the number of columns in the model.
     * \return The number of columns.
@@ -136,6 +171,11 @@ private:
    QSharedPointer<GitBase> mGit;
    QSharedPointer<GitServerCache> mGitServerCache;
    QMap<CommitHistoryColumns, QString> mColumns;
+   GitCache::CommitsSnapshot mSnapshot;
+   LanesLayout mLanesLayout;
+   int mRowCount = 0;
+
+   void setSnapshot(GitCache::CommitsSnapshot snapshot);
 
    /**
     * @brief Returns the tool tip data.
@@ -78,7 +78,7 @@ void CommitHistoryView::filterBySha(const QStringList &shaList)
    }
    else
    {
-      mProxyModel = new ShaFilterProxyModel(this);
+      mProxyModel = new ShaFilterProxyModel(mCache, this);
       mProxyModel->setSourceModel(mCommitHistoryModel);
       mProxyModel->setAcceptedSha(shaList);
       setModel(mProxyModel);
@@ -87,6 +87,29 @@ void CommitHistoryView::filterBySha(const QStringList &shaList)
    setupGeometry();
 }
 
+void CommitHistoryView::addToFilter(const QStringList &shaList)
+{
+   if (mIsFiltering && mProxyModel)
+      mProxyModel->addAcceptedSha(shaList);
+   else
+      filterBySha(shaList);
+}
+
+void CommitHistoryView::removeFilter()
+{
+   mIsFiltering = false;
+
+   if (mProxyModel)
+   {
+      const auto sourceModel = mProxyModel->sourceModel();
+
+      setModel(sourceModel);
+
+      delete mProxyModel;
+      mProxyModel = nullptr;
+   }
+}
+
 CommitHistoryView::~CommitHistoryView()
 {
    mSettings->setLocalValue(QString("%1").arg(objectName()), header()->saveState());
@@ -132,6 +132,16 @@ public:
     * @param shaList List of SHA to pass to the filter.
     */
    void filterBySha(const QStringList &shaList);
+   /**
+    * @brief Adds SHAs to the ones shown by the active filter. It's used when the SHAs are found progressively.
+    *
+    * @param shaList List of SHA to add to the filter.
+    */
+   void addToFilter(const QStringList &shaList);
+   /**
+    * @brief Removes the filter and shows all the commits again.
+    */
+   void removeFilter();
    /**
     * @brief Activates/deactivates filtering in the view.
     *
@@ -50,13 +50,16 @@ void RepositoryViewDelegate::paint(QPainter *p, const QStyleOptionViewItem &opt,
    else if (newOpt.state & QStyle::State_MouseOver)
       p->fillRect(newOpt.rect, GitQlientStyles::getGraphHoverColor());
 
-   const auto row = mView->hasActiveFilter()
-       ? dynamic_cast<QSortFilterProxyModel *>(mView->model())->mapToSource(index).row()
-       : index.row();
+   const auto proxyModel = mView->hasActiveFilter() ? dynamic_cast<QSortFilterProxyModel *>(mView->model()) : nullptr;
+   const auto sourceIndex = proxyModel ? proxyModel->mapToSource(index) : index;
+   const auto model = qobject_cast<const CommitHistoryModel *>(sourceIndex.model());
 
-   const auto commit = mCache->commitInfo(row);
+   if (!model || !sourceIndex.isValid())
+      return;
+
+   const auto &commit = model->commitAt(sourceIndex.row());
 
-   if (commit.sha.isEmpty())
+   if (!commit.isValid())
       return;
 
    QPalette palette;
@@ -66,7 +69,7 @@ void RepositoryViewDelegate::paint(QPainter *p, const QStyleOptionViewItem &opt,
    if (index.column() == static_cast<int>(CommitHistoryColumns::Graph))
    {
       newOpt.rect.setX(newOpt.rect.x() + 10);
-      paintGraph(p, newOpt, commit);
+      paintGraph(p, newOpt, commit, model->lanesAt(sourceIndex.row()));
    }
    else if (index.column() == static_cast<int>(CommitHistoryColumns::Log))
       paintLog(p, newOpt, commit, index.data().toString(), textColor);
@@ -96,7 +99,7 @@ void RepositoryViewDelegate::paint(QPainter *p, const QStyleOptionViewItem &opt,
          newOpt.font.setPointSize(8);
          newOpt.font.setFamily("DejaVu Sans Mono");
 
-         text = commit.sha != CommitInfo::ZERO_SHA ? text.left(8) : "";
+         text = commit.id() != CommitInfo::ZERO_ID ? text.left(8) : "";
       }
       else if (index.column() == static_cast<int>(CommitHistoryColumns::Author) && commit.isSigned())
       {
@@ -319,7 +322,7 @@ void RepositoryViewDelegate::paintGraphLane(QPainter *p, const Lane &lane, bool
    }
 }
 
-QColor RepositoryViewDelegate::getMergeColor(const Lane &currentLane, const CommitInfo &commit, int currentLaneIndex,
+QColor RepositoryViewDelegate::getMergeColor(const Lane &currentLane, const QVector<Lane> &lanes, int currentLaneIndex,
                                              const QColor &defaultColor, bool &isSet) const
 {
    auto mergeColor = defaultColor;
@@ -340,7 +343,7 @@ QColor RepositoryViewDelegate::getMergeColor(const Lane &currentLane, const Comm
       case LaneType::JOIN_L:
          for (auto laneCount = 0; laneCount < currentLaneIndex; ++laneCount)
          {
-            if (commit.laneAt(laneCount).equals(LaneType::JOIN_L))
+            if (lanes.at(laneCount).equals(LaneType::JOIN_L))
             {
                mergeColor = GitQlientStyles::getBranchColorAt(laneCount % GitQlientStyles::getTotalBranchColors());
                isSet = true;
@@ -355,7 +358,8 @@ QColor RepositoryViewDelegate::getMergeColor(const Lane &currentLane, const Comm
    return mergeColor;
 }
 
-void RepositoryViewDelegate::paintGraph(QPainter *p, const QStyleOptionViewItem &opt, const CommitInfo &commit) const
+void RepositoryViewDelegate::paintGraph(QPainter *p, const QStyleOptionViewItem &opt, const CommitInfo &commit,
+                                        const QVector<Lane> &lanes) const
 {
    p->save();
    p->setClipRect(opt.rect, Qt::IntersectClip);
@@ -369,7 +373,7 @@ void RepositoryViewDelegate::paintGraph(QPainter *p, const QStyleOptionViewItem
    }
    else
    {
-      if (commit.sha == CommitInfo::ZERO_SHA)
+      if (commit.id() == CommitInfo::ZERO_ID)
       {
          const auto activeColor = GitQlientStyles::getBranchColorAt(0);
          QColor color = activeColor;
@@ -382,8 +386,10 @@ void RepositoryViewDelegate::paintGraph(QPainter *p, const QStyleOptionViewItem
       }
       else
       {
-         const auto laneNum = commit.lanesCount();
-         const auto activeLane = commit.getActiveLane();
+         const auto laneNum = lanes.count();
+         const auto activeLane = static_cast<int>(
+             std::find_if(lanes.cbegin(), lanes.cend(), [](const Lane &lane) { return lane.isActive(); })
+             - lanes.cbegin());
          const auto activeColor
              = GitQlientStyles::getBranchColorAt(activeLane % GitQlientStyles::getTotalBranchColors());
          auto x1 = 0;
@@ -395,11 +401,11 @@ void RepositoryViewDelegate::paintGraph(QPainter *p, const QStyleOptionViewItem
          {
             x1 = x2 - LANE_WIDTH;
 
-            auto currentLane = commit.laneAt(i);
+            auto currentLane = lanes.at(i);
 
             if (!laneHeadPresent && i < laneNum - 1)
             {
-               auto prevLane = commit.laneAt(i + 1);
+               auto prevLane = lanes.at(i + 1);
                laneHeadPresent
                    = prevLane.isHead() || prevLane.equals(LaneType::JOIN_R) || prevLane.equals(LaneType::JOIN_L);
             }
@@ -412,7 +418,7 @@ void RepositoryViewDelegate::paintGraph(QPainter *p, const QStyleOptionViewItem
                   color = GitQlientStyles::getBranchColorAt(i % GitQlientStyles::getTotalBranchColors());
 
                if (!isSet)
-                  mergeColor = getMergeColor(currentLane, commit, i, color, isSet);
+                  mergeColor = getMergeColor(currentLane, lanes, i, color, isSet);
 
                paintGraphLane(p, currentLane, laneHeadPresent, x1, x2, color, activeColor, mergeColor, false,
                               commit.hasChilds());
@@ -429,7 +435,7 @@ void RepositoryViewDelegate::paintGraph(QPainter *p, const QStyleOptionViewItem
 void RepositoryViewDelegate::paintLog(QPainter *p, const QStyleOptionViewItem &opt, const CommitInfo &commit,
                                       const QString &text, QColor textColor) const
 {
-   const auto sha = commit.sha;
+   const auto sha = commit.sha();
 
    if (sha.isEmpty())
       return;
@@ -438,7 +444,7 @@ void RepositoryViewDelegate::paintLog(QPainter *p, const QStyleOptionViewItem &o
 
    if (mGitServerCache)
    {
-      if (const auto pr = mGitServerCache->getPullRequest(commit.sha); pr.isValid())
+      if (const auto pr = mGitServerCache->getPullRequest(sha); pr.isValid())
       {
          offset = 5;
          paintPrStatus(p, opt, offset, pr);
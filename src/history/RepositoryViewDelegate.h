@@ -105,8 +105,10 @@ private:
     * @param p The painter device.
     * @param o The style options of the item.
     * @param index The index with the item data.
+    * @param lanes The lanes of the row.
     */
-   void paintGraph(QPainter *p, const QStyleOptionViewItem &o, const CommitInfo &commit) const;
+   void paintGraph(QPainter *p, const QStyleOptionViewItem &o, const CommitInfo &commit,
+                   const QVector<Lane> &lanes) const;
 
    /**
     * @brief Specialization method called by @ref paintGrapth that does the actual lane painting.
@@ -150,13 +152,13 @@ private:
     * @brief getMergeColor Returns the color to be used for painting the external circle of the node. This methods
     * searches the origin of the merge and uses the same lane color.
     * @param currentLane The current lane type.
-    * @param commit The current commit.
+    * @param lanes The lanes of the current row.
     * @param currentLaneIndex The current index of the lane.
     * @param defaultColor The default color in case it's not a merge.
     * @param isSet Boolean used as a shortcut. If the current iteration is a merge it will change the value for the
     * following lanes.
     * @return Returns the color of the lane that merges into the current node, otherwise it returns @p defaultColor.
     */
-   QColor getMergeColor(const Lane &currentLane, const CommitInfo &commit, int currentLaneIndex,
+   QColor getMergeColor(const Lane &currentLane, const QVector<Lane> &lanes, int currentLaneIndex,
                         const QColor &defaultColor, bool &isSet) const;
 };
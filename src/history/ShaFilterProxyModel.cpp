@@ -1,15 +1,63 @@
 #include "ShaFilterProxyModel.h"
 
-#include <CommitHistoryColumns.h>
+#include <GitCache.h>
 
-ShaFilterProxyModel::ShaFilterProxyModel(QObject *parent)
+ShaFilterProxyModel::ShaFilterProxyModel(const QSharedPointer<GitCache> &cache, QObject *parent)
    : QSortFilterProxyModel(parent)
+   , mCache(cache)
 {
 }
 
-bool ShaFilterProxyModel::filterAcceptsRow(int sourceRow, const QModelIndex &sourceParent) const
+void ShaFilterProxyModel::setSourceModel(QAbstractItemModel *sourceModel)
 {
-   const auto shaIndex = sourceModel()->index(sourceRow, static_cast<int>(CommitHistoryColumns::Sha), sourceParent);
-   const auto sha = sourceModel()->data(shaIndex).toString();
-   return mAcceptedShas.contains(sha);
+   if (const auto previousModel = this->sourceModel())
+      disconnect(previousModel, nullptr, this, nullptr);
+
+   // The rows are resolved again before the base class filters the changes
+   if (sourceModel)
+   {
+      connect(sourceModel, &QAbstractItemModel::modelAboutToBeReset, this, &ShaFilterProxyModel::invalidateRows);
+      connect(sourceModel, &QAbstractItemModel::rowsAboutToBeInserted, this, &ShaFilterProxyModel::invalidateRows);
+      connect(sourceModel, &QAbstractItemModel::rowsAboutToBeRemoved, this, &ShaFilterProxyModel::invalidateRows);
+      connect(sourceModel, &QAbstractItemModel::layoutAboutToBeChanged, this, &ShaFilterProxyModel::invalidateRows);
+   }
+
+   invalidateRows();
+
+   QSortFilterProxyModel::setSourceModel(sourceModel);
+}
+
+void ShaFilterProxyModel::setAcceptedSha(const QStringList &acceptedShaList)
+{
+   mAcceptedShas = acceptedShaList;
+
+   invalidateRows();
+}
+
+void ShaFilterProxyModel::addAcceptedSha(const QStringList &shaList)
+{
+   mAcceptedShas.append(shaList);
+
+   if (!mRowsOutdated)
+      mAcceptedRows |= mCache->rowsOfShas(shaList);
+
+   invalidateFilter();
+}
+
+void ShaFilterProxyModel::beginResetModel()
+{
+   invalidateRows();
+
+   QSortFilterProxyModel::beginResetModel();
+}
+
+bool ShaFilterProxyModel::filterAcceptsRow(int sourceRow, const QModelIndex &) const
+{
+   if (mRowsOutdated)
+   {
+      mAcceptedRows = mCache->rowsOfShas(mAcceptedShas);
+      mRowsOutdated = false;
+   }
+
+   return sourceRow < mAcceptedRows.size() && mAcceptedRows.testBit(sourceRow);
 }
@@ -23,12 +23,18 @@
  ** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
  ***************************************************************************************/
 
+#include <QBitArray>
+#include <QSharedPointer>
 #include <QSortFilterProxyModel>
 
+class GitCache;
+
 /**
  * @brief The ShaFilterProxyModel class is an overload of the QSortFilterProxyModel that takes a list of shas to act as
  * a filter between a view and a QAbstractiItemModel.
  *
+ * The SHAs are resolved into the rows of the graph by the cache at once, so filtering a row is a lookup in a bitmap.
+ * The rows are resolved again when the rows of the source model change.
  */
 class ShaFilterProxyModel : public QSortFilterProxyModel
 {
@@ -38,21 +44,35 @@ public:
    /**
     * @brief Default constructor.
     *
+    * @param cache The cache that resolves the SHAs into rows.
     * @param parent The parent widget if needed.
     */
-   explicit ShaFilterProxyModel(QObject *parent = nullptr);
+   explicit ShaFilterProxyModel(const QSharedPointer<GitCache> &cache, QObject *parent = nullptr);
+
+   /**
+    * @brief Sets the source model and tracks its changes to know when the rows have to be resolved again.
+    *
+    * @param sourceModel The model to filter.
+    */
+   void setSourceModel(QAbstractItemModel *sourceModel) override;
 
    /**
     * @brief Sets the list of accepted SHAs that will be shown in the source model.
     *
     * @param acceptedShaList The SHAs list.
     */
-   void setAcceptedSha(const QStringList &acceptedShaList) { mAcceptedShas = acceptedShaList; }
+   void setAcceptedSha(const QStringList &acceptedShaList);
+   /**
+    * @brief Adds SHAs to the list of accepted SHAs and shows their rows.
+    *
+    * @param shaList The SHAs to add.
+    */
+   void addAcceptedSha(const QStringList &shaList);
    /**
     * @brief Starts the reset of the model
     *
     */
-   void beginResetModel() { QSortFilterProxyModel::beginResetModel(); }
+   void beginResetModel();
    /**
     * @brief Ends the reset of the model.
     *
@@ -61,8 +81,8 @@ public:
 
 protected:
    /**
-    * @brief This method is the actual filter functionality. Given the source row and the source index it retrieves the
-    * sha and checks if it's among the accepted SHAs in the list.
+    * @brief This method is the actual filter functionality. Given the source row it checks if the row belongs to one
+    * of the accepted SHAs.
     *
     * @param sourceRow The source row number.
     * @param sourceParent The source index.
@@ -71,8 +91,16 @@ protected:
    bool filterAcceptsRow(int sourceRow, const QModelIndex &sourceParent) const override;
 
 private:
+   QSharedPointer<GitCache> mCache;
    /**
     * @brief mAcceptedShas List of accepted shas.
     */
    QStringList mAcceptedShas;
+   /**
+    * @brief mAcceptedRows The rows of the accepted SHAs in the source model.
+    */
+   mutable QBitArray mAcceptedRows;
+   mutable bool mRowsOutdated = true;
+
+   void invalidateRows() { mRowsOutdated = true; }
 };